@@ -212,6 +212,17 @@ namespace FMITerminalBlock
 			 */
 			double getRealPositiveDoubleProperty(const std::string &path) const;
 
+			/**
+			 * @brief Queries the property and checks its value
+			 * @details If the property contains an invalid value,
+			 * Base::SystemConfigurationException will be thrown.
+			 * @param path The key to query
+			 * @param def The property's default value
+			 * @return A real positive integer value r, r > 0
+			 */
+			int getRealPositiveIntegerProperty(const std::string &path, int def)
+				const;
+
 			/**
 			 * @brief Returns the subtree given by the path string.
 			 * @details If the path is not present in the global configuration
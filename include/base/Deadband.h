@@ -0,0 +1,95 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file Deadband.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_BASE_DEADBAND
+#define _FMITERMINALBLOCK_BASE_DEADBAND
+
+#include <boost/property_tree/ptree.hpp>
+#include <common/fmi_v1.0/fmiModelTypes.h>
+
+#include <string>
+
+namespace FMITerminalBlock
+{
+	namespace Base
+	{
+
+		/**
+		 * @brief Decides whether a real value changed significantly
+		 * @details <p> A deadband is configured per port and consists of an
+		 * absolute and a relative part. A new value is significant if its
+		 * distance to the reference value exceeds the absolute deadband as well
+		 * as the relative deadband times the magnitude of the reference value.
+		 * The reference value is usually the last value which was considered to
+		 * be significant. Hence, slowly drifting signals will still be reported
+		 * as soon as they left the deadband.</p>
+		 * <p> By default, both parts are zero and every difference is
+		 * significant. NaN values always differ from any other value.</p>
+		 */
+		class Deadband
+		{
+		public:
+			/** @brief The port property key of the absolute deadband */
+			static const std::string PROP_ABSOLUTE;
+			/** @brief The port property key of the relative deadband */
+			static const std::string PROP_RELATIVE;
+
+			/** @brief Creates an empty deadband which passes any change */
+			Deadband(): absolute_(0.0), relative_(0.0) {}
+
+			/**
+			 * @brief Reads the deadband from the given port configuration
+			 * @details Unset properties default to zero. If a property is not a
+			 * non-negative number, a Base::SystemConfigurationException will be
+			 * thrown.
+			 * @param portConfig The configuration root of a single port
+			 */
+			Deadband(const boost::property_tree::ptree &portConfig);
+
+			/**
+			 * @brief Returns whether the value differs significantly from the
+			 * reference value
+			 * @param reference The last significant value
+			 * @param value The value to test
+			 */
+			bool isSignificant(fmiReal reference, fmiReal value) const;
+
+			/**
+			 * @brief Returns whether any non-zero deadband is configured
+			 */
+			bool isEnabled() const;
+
+			/**
+			 * @brief Returns a deadband which is not wider than any of the given
+			 * ones
+			 * @details Any change which is significant for one of the given
+			 * deadbands will also be significant for the returned one.
+			 */
+			static Deadband getNarrowest(const Deadband &a, const Deadband &b);
+
+		private:
+			/** @brief The absolute width of the deadband */
+			fmiReal absolute_;
+			/** @brief The width of the deadband relative to the reference value */
+			fmiReal relative_;
+
+			/**
+			 * @brief Reads a single non-negative deadband property
+			 * @details Throws a Base::SystemConfigurationException if the property
+			 * is invalid.
+			 */
+			static fmiReal getWidth(const boost::property_tree::ptree &portConfig,
+				const std::string &key);
+		};
+
+	}
+}
+
+#endif
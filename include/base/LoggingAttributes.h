@@ -17,6 +17,7 @@
 #include <boost/log/attributes/mutable_constant.hpp>
 #include <boost/log/expressions/keyword.hpp>
 #include <boost/log/expressions/keyword_fwd.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 #include <common/fmi_v1.0/fmiModelTypes.h>
 
@@ -41,6 +42,18 @@ namespace FMITerminalBlock
 		 * format.
 		 */
 		BOOST_LOG_ATTRIBUTE_KEYWORD(timingRecordTime, ATTR_TIMING_RECORD_TIME, fmiTime)
+
+		/** @brief The name of the absolute time logging record timestamp */
+		extern const char* ATTR_TIMING_RECORD_TIMESTAMP;
+
+		/**
+		 * @brief Defines the timingRecordTimeStamp attribute
+		 * @details The absolute timestamp is derived from the timingRecordTime and
+		 * a single offset to the system clock. Hence, both timestamps correspond
+		 * to the same instant of time.
+		 */
+		BOOST_LOG_ATTRIBUTE_KEYWORD(timingRecordTimeStamp, 
+			ATTR_TIMING_RECORD_TIMESTAMP, boost::posix_time::ptime)
 		
 	}
 }
@@ -13,6 +13,7 @@
 
 #include "base/PortID.h"
 
+#include <string>
 #include <vector>
 
 #include <boost/property_tree/ptree.hpp>
@@ -27,7 +28,9 @@ namespace FMITerminalBlock
 		 * configuration. Configuration is stored as a reference to the global 
 		 * configuration tree. One reference directly points to the configuration
 		 * root of the channel. For each port, another reference to the port 
-		 * configuration is managed.
+		 * configuration is managed. Since PortIDs of each type are drawn
+		 * consecutively, the channel additionally maintains a dense lookup table
+		 * which resolves the port index of a PortID in constant time.
 		 */
 		class TransmissionChannel
 		{
@@ -48,6 +51,17 @@ namespace FMITerminalBlock
 			 */
 			const boost::property_tree::ptree & getChannelConfig() const;
 
+			/**
+			 * @brief Queries the channel property and checks its value
+			 * @details If the property contains an invalid value,
+			 * Base::SystemConfigurationException will be thrown.
+			 * @param path The key to query relative to the channel configuration
+			 * @param def The property's default value
+			 * @return A real positive integer value r, r > 0
+			 */
+			int getRealPositiveIntegerProperty(const std::string &path, int def)
+				const;
+
 			/**
 			 * @brief Returns a vector of port related configuration references.
 			 * @details The returned references remain valid until the object is 
@@ -64,6 +78,27 @@ namespace FMITerminalBlock
 			 */
 			const std::vector<PortID> &getPortIDs() const;
 
+			/**
+			 * @brief Returns the index of the first port which has the given PortID
+			 * @details The lookup takes constant time. The returned index 
+			 * corresponds to the index in the PortID vector.
+			 * @param id The PortID to look up
+			 * @return The index of the port or -1 if the PortID is not part of the
+			 * channel
+			 */
+			int getPortIndex(const PortID &id) const;
+
+			/**
+			 * @brief Returns the index of the next port which has the same PortID
+			 * @details A variable may be assigned to several ports of a channel.
+			 * The function may be used to iterate over all of them starting at the 
+			 * index returned by getPortIndex().
+			 * @param index A valid port index
+			 * @return The index of the next port or -1 if no further port has the
+			 * same PortID
+			 */
+			int getNextPortIndex(int index) const;
+
 			/**
 			 * @brief Appends a port entry at the end of the channel.
 			 * @details The given ptree reference must remain valid until the object is deleted.
@@ -94,6 +129,19 @@ namespace FMITerminalBlock
 			 * each port.
 			 */
 			std::vector<const boost::property_tree::ptree *> portConfig_;
+
+			/**
+			 * @brief The index of the first port of each PortID
+			 * @details The outer vector is indexed by the FMI type, the inner one by
+			 * the PortID number. Unused entries are set to -1.
+			 */
+			std::vector<std::vector<int>> firstPortIndex_;
+			/**
+			 * @brief The index of the next port which shares the PortID
+			 * @details The index corresponds to the index in the portIDs vector. An 
+			 * entry is set to -1 if no further port has the same PortID.
+			 */
+			std::vector<int> nextPortIndex_;
 		};
 	}
 }
@@ -43,14 +43,16 @@ namespace FMITerminalBlock
 			virtual ~LazyEvent(){};
 
 			/**
-			 * @brief Returns a copy of the event's variables
+			 * @brief Returns a view of the event's variables
 			 * @details The function may only be called if the variable's values are 
 			 * really needed and if the event is processed. It queries the predictor 
 			 * and returns the model's output variables. After retrieving the
-			 * variables, the model might not be able to reset the event.
+			 * variables, the model might not be able to reset the event. The 
+			 * returned reference points to the predictor's output buffer and is 
+			 * only valid until the predictor proceeds to the next event.
 			 * @return The vector of changed or relevant variables
 			 */
-			virtual std::vector<Timing::Variable> getVariables(void);
+			virtual const std::vector<Timing::Variable> & getVariables(void);
 
 			/**
 			 * @brief Returns the object's readable string representation
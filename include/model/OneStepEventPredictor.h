@@ -18,6 +18,7 @@
 
 #include <import/base/include/FMUModelExchangeBase.h>
 
+#include "base/Deadband.h"
 #include "model/AbstractEventPredictor.h"
 #include "model/ManagedLowLevelFMU.h"
 #include "timing/StaticEvent.h"
@@ -46,8 +47,10 @@ namespace FMITerminalBlock
 		 * cache is implemented which stores the event at the next synchronization
 		 * point.</p>
 		 * <p>In order to reduce the network load, the event predictor checks which
-		 * output variables were actually changed. Only if the output variable was 
-		 * changed in the last period, it will be set in the event object.</p>
+		 * output variables were actually changed. Only if an output variable was 
+		 * changed in the last period, an event which contains all output 
+		 * variables is issued. Optionally, the event will only contain the output 
+		 * variables which changed since the last issued output event.</p>
 		 */
 		class OneStepEventPredictor: public AbstractEventPredictor
 		{
@@ -59,6 +62,8 @@ namespace FMITerminalBlock
 			static const std::string PROP_DEFAULT_INPUT;
 			/** @brief The key of the variable step size flag */
 			static const std::string PROP_VARIABLE_STEP_SIZE;
+			/** @brief The key of the flag which only emits changed outputs */
+			static const std::string PROP_EMIT_CHANGED_ONLY;
 
 			/**
 			 * @brief Constructs an uninitialized event predictor.
@@ -98,7 +103,8 @@ namespace FMITerminalBlock
 			 * synchronization point. Any input variable update will be delayed until
 			 * the next synchronization point. Hence, the prediction does not change 
 			 * by any input variable update. Nevertheless, the prediction may be 
-			 * queried multiple times.
+			 * queried multiple times. The variables of the prediction are only 
+			 * generated if an output changed and each returned event shares them.
 			 * @return A reference to the newly created prediction. Ownership of the
 			 * object is transferred to the calling instance. Hence, that instance 
 			 * must delete the event object.
@@ -140,6 +146,23 @@ namespace FMITerminalBlock
 			 */
 			std::vector<std::vector<fmiValueReference>> outputValueReference_;
 
+			/**
+			 * @brief Flags each output image variable which changed since the last
+			 * output event
+			 * @details Similar to outputValueReference_, the outer vector is indexed
+			 * by the fmi type. Each inner vector has the size of the appropriate 
+			 * image vector. Initially, each variable is flagged. Hence, the first 
+			 * output event always contains every output variable.
+			 */
+			std::vector<std::vector<bool>> outputChanged_;
+
+			/**
+			 * @brief Holds the deadband of each real output image variable
+			 * @details The deadband of a variable is the narrowest deadband of all
+			 * its output ports. The vector has the size of the real output image.
+			 */
+			std::vector<Base::Deadband> outputRealDeadband_;
+
 			/** @brief Holds the output mapping to query every output PortID */
 			const Base::ChannelMapping * outputMapping_;
 
@@ -182,6 +205,8 @@ namespace FMITerminalBlock
 				bool variableStepSizeOnModelEvent;
 				/// The absolute precision to compare simulation time
 				fmiTime timingPrecision;
+				/// Only emit output variables which changed since the last event
+				bool emitChangedOnly;
 			} simulationProperties_;
 
 			/**
@@ -198,6 +223,14 @@ namespace FMITerminalBlock
 			void initOutputValueReferences(Base::ApplicationContext &appContext, 
 				FMIVariableType type);
 
+			/**
+			 * @brief Initializes the deadbands of all real output variables
+			 * @details The function assumes that the outputMapping_ variable is 
+			 * properly initialized. In case an invalid deadband is configured, a 
+			 * Base::SystemConfigurationException will be thrown.
+			 */
+			void initOutputDeadbands();
+
 			/**
 			 * @brief Initializes the inputValueReference_ variable
 			 */
@@ -281,10 +314,34 @@ namespace FMITerminalBlock
 			 * @param referenceVector The vector of FMI value references which is 
 			 * used to fetch the variables of a particular type. The parameter should
 			 * be constant but FMI++ prevents it from being constant.
+			 * @param changed A valid pointer to the change flags of the image. The 
+			 * flag of each changed variable will be set. No flag will be cleared.
+			 * Insignificant changes neither update the image nor set a flag.
 			 */
 			template<typename valType>
 			bool updateOutputImage(std::vector<valType> *destinationImage, 
-				std::vector<fmiValueReference> &referenceVector);
+				std::vector<fmiValueReference> &referenceVector, 
+				std::vector<bool> *changed);
+
+			/**
+			 * @brief Returns whether the output variable changed significantly
+			 * @details Any difference is significant unless a deadband applies.
+			 * @param index The index of the variable in its output image
+			 * @param reference The value which is currently stored in the image
+			 * @param value The newly fetched value
+			 */
+			template<typename valType>
+			bool isSignificantChange(unsigned index, const valType &reference, 
+				const valType &value) const;
+
+			/**
+			 * @brief Returns whether the real output variable left its deadband
+			 * @param index The index of the variable in the real output image
+			 * @param reference The value which is currently stored in the image
+			 * @param value The newly fetched value
+			 */
+			bool isSignificantChange(unsigned index, fmiReal reference, 
+				fmiReal value) const;
 
 			/**
 			 * @brief Queries all outputs and updates the image vectors accordingly.
@@ -295,6 +352,9 @@ namespace FMITerminalBlock
 			/**
 			 * @brief Constructs an event from the output images and the current time
 			 * of the FMU
+			 * @details If the emitChangedOnly simulation property is set, the event 
+			 * only contains the variables which changed since the last output 
+			 * event. The change flags of all variables are cleared.
 			 * @return The newly constructed event
 			 */
 			std::unique_ptr<Timing::StaticEvent> getOutputEvent();
@@ -308,13 +368,17 @@ namespace FMITerminalBlock
 			 * @param values The vector with all variable values. It must have the 
 			 * same size as the ids vector. Each element must match the appropriate 
 			 * element in the ids vector.
+			 * @param changed The change flags of each variable. It must have the 
+			 * same size as the ids vector. In case the emitChangedOnly simulation 
+			 * property is set, only flagged variables are appended.
 			 * @param valType The template parameter specifies the data type of the 
 			 * variable and the data to append
 			 */
 			template<typename valType>
 			void appendOutputVariables(std::vector<Timing::Variable> *destination, 
 				const std::vector<Base::PortID> &ids, 
-				const std::vector<valType> &values) const;
+				const std::vector<valType> &values, 
+				const std::vector<bool> &changed) const;
 
 			/**
 			 * @brief Sets the input variables of the event at the managed FMU
@@ -0,0 +1,193 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file AsyncPublisher.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_NETWORK_ASYNC_PUBLISHER
+#define _FMITERMINALBLOCK_NETWORK_ASYNC_PUBLISHER
+
+#include "base/environment-helper.h"
+
+#include "network/Publisher.h"
+#include "timing/EventLogger.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace FMITerminalBlock
+{
+	namespace Network
+	{
+		using namespace FMITerminalBlock;
+
+		/**
+		 * @brief Decouples a publisher from the dispatcher thread
+		 * @details <p> The AsyncPublisher wraps another publisher instance. Each
+		 * triggered event is copied into a bounded queue and the dispatcher
+		 * thread returns immediately. A separate sender thread passes the queued
+		 * events to the wrapped publisher. Hence, a slow peer only delays its own
+		 * channel.</p>
+		 * <p> In case the queue is full, the configured overflow policy decides
+		 * how to proceed. The oldest queued event may be dropped, the newest
+		 * queued event may be merged with the incoming one, or the dispatcher
+		 * thread may block until the sender thread frees some space. Exceptions
+		 * which are thrown by the wrapped publisher are passed to the error
+		 * callback.</p>
+		 * <p> Queued, published, and dropped events are recorded in the timing
+		 * file by the corresponding processing stages.</p>
+		 */
+		class AsyncPublisher: public Publisher
+		{
+		public:
+
+			/** @brief The name of the channel property which enables the mode */
+			static const std::string PROP_ASYNC;
+			/** @brief The name of the channel property of the queue size */
+			static const std::string PROP_QUEUE_SIZE;
+			/** @brief The name of the channel property of the overflow policy */
+			static const std::string PROP_OVERFLOW;
+
+			/** @brief The default maximum number of queued events */
+			static const size_t DEFAULT_QUEUE_SIZE = 16;
+
+			/** @brief Enumerates the supported overflow policies */
+			enum OverflowPolicy
+			{
+				DROP_OLDEST = 0, ///< Drops the oldest queued event
+				COALESCE_LATEST, ///< Merges the event into the newest queued one
+				BLOCK ///< Blocks until the queue has some free space
+			};
+
+			/** @brief The configuration names of each OverflowPolicy */
+			static const char * OVERFLOW_POLICY_NAMES[3];
+
+			/**
+			 * @brief Creates an uninitialized instance
+			 * @param publisher The publisher which will be wrapped. It must not be
+			 * initialized yet.
+			 * @param errorCallback The function which is called with every
+			 * exception of the sender thread. It may be called from any thread.
+			 */
+			AsyncPublisher(std::shared_ptr<Publisher> publisher,
+				std::function<void(std::exception_ptr)> errorCallback);
+
+			/**
+			 * @brief Stops the sender thread and frees allocated resources
+			 * @details The event which is currently published will be finished.
+			 * All other queued events are dropped.
+			 */
+			virtual ~AsyncPublisher();
+
+			/**
+			 * @copydoc Publisher::init()
+			 * @details Initializes the wrapped publisher and starts the sender
+			 * thread.
+			 */
+			virtual void init(const Base::TransmissionChannel &channel);
+
+			/**
+			 * @brief Queues a copy of the event
+			 * @details Depending on the overflow policy, the function may block if
+			 * the queue is full.
+			 */
+			virtual void eventTriggered(Timing::Event * ev);
+
+			/**
+			 * @brief Returns whether the asynchronous mode is enabled at the given
+			 * channel
+			 */
+			static bool isEnabled(const Base::TransmissionChannel &channel);
+
+		private:
+
+			/** @brief The wrapped publisher */
+			std::shared_ptr<Publisher> publisher_;
+			/** @brief The function which is called on errors */
+			std::function<void(std::exception_ptr)> errorCallback_;
+
+			/** @brief The configuration of the channel or NULL */
+			const Base::TransmissionChannel * channel_;
+
+			/** @brief The configured maximum number of queued events */
+			size_t queueSize_;
+			/** @brief The configured overflow policy */
+			OverflowPolicy overflowPolicy_;
+
+			/** @brief The queued events, the oldest one first */
+			std::deque<Timing::Event *> queue_;
+			/** @brief Protects the queue and the termination flag */
+			std::mutex queueMutex_;
+			/** @brief Notifies the sender thread about new events */
+			std::condition_variable queueNotEmpty_;
+			/** @brief Notifies a blocked dispatcher thread about free space */
+			std::condition_variable queueNotFull_;
+			/** @brief Flags that the sender thread should terminate */
+			bool terminate_;
+
+			/** @brief The thread which passes the events to the publisher */
+			std::thread senderThread_;
+
+			/** @brief Logs the processing stages of each event */
+			Timing::EventLogger eventLogger_;
+
+			/**
+			 * @brief Temporarily maps a port index to the index of the merged
+			 * variable
+			 * @details The vector is reused by every merge operation. All entries
+			 * are set to -1 in between.
+			 */
+			std::vector<int> mergeIndex_;
+
+			/**
+			 * @brief Reads the configuration of the asynchronous mode
+			 * @details A Base::SystemConfigurationException is thrown in case of an
+			 * invalid configuration.
+			 */
+			void initConfiguration(const Base::TransmissionChannel &channel);
+
+			/** @brief Executes the sender thread's main loop */
+			void run();
+
+			/**
+			 * @brief Returns a copy of the given event
+			 * @details The variables of a StaticEvent are shared instead of copied.
+			 */
+			static Timing::Event * copyEvent(Timing::Event * ev);
+
+			/**
+			 * @brief Returns a new event which contains the variables of both events
+			 * @details The variables of the newer event supersede the ones of the
+			 * older event. The time of the newer event is taken. Variables which are
+			 * not published by the channel are omitted.
+			 * @param older A valid pointer to the older event
+			 * @param newer A valid pointer to the newer event
+			 */
+			Timing::Event * mergeEvents(Timing::Event * older, Timing::Event * newer);
+
+			/**
+			 * @brief Appends the given variable to the merged variables
+			 * @details A variable which was already appended will be replaced.
+			 */
+			void mergeVariable(std::vector<Timing::Variable> * merged,
+				const Timing::Variable &var);
+
+			/** @brief Records the given event as being dropped and deletes it */
+			void dropEvent(Timing::Event * ev);
+		};
+
+	}
+}
+
+#endif
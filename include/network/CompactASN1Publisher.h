@@ -14,6 +14,7 @@
 #include "base/environment-helper.h"
 #include "network/Publisher.h"
 #include "network/ASN1Commons.h"
+#include "base/Deadband.h"
 #include "timing/Event.h"
 
 #include <boost/asio.hpp>
@@ -66,6 +67,14 @@ namespace FMITerminalBlock
 			 */
 			virtual void eventTriggered(Timing::Event * ev);
 
+			/**
+			 * @brief Returns a nicely formatted string of the buffer's content
+			 * @param buffer The data buffer to format
+			 * @return A more or less human readable string representing the buffer's 
+			 * content. The function may be used for debugging purpose only.
+			 */
+			static std::string toString(const std::vector<uint8_t> & buffer);
+
 		protected:
 
 			/** 
@@ -88,15 +97,6 @@ namespace FMITerminalBlock
 			 */
 			virtual void sendData(const std::vector<uint8_t> &buffer) = 0;
 
-
-			/**
-			 * @brief Returns a nicely formatted string of the buffer's content
-			 * @param buffer The data buffer to format
-			 * @return A more or less human readable string representing the buffer's 
-			 * content. The function may be used for debugging purpose only.
-			 */
-			static std::string toString(const std::vector<uint8_t> & buffer);
-
 		private:
 
 			/**
@@ -113,6 +113,52 @@ namespace FMITerminalBlock
 			 */
 			std::vector<ASN1Commons::DataType> outputTypes_;
 
+			/**
+			 * @brief Vector of the deadband of each output variable
+			 * @details The index corresponds to the index of outputVariables_. Only
+			 * real-valued variables may have an enabled deadband. It won't be 
+			 * modified after the initialization completes.
+			 */
+			std::vector<Base::Deadband> outputDeadbands_;
+
+			/**
+			 * @brief Flags each output variable which was published at least once
+			 * @details The index corresponds to the index of outputVariables_. The
+			 * initial placeholder value of a variable was never sent. Hence, the
+			 * deadband is not applied until the variable was published.
+			 */
+			std::vector<bool> outputPublished_;
+
+			/**
+			 * @brief The configuration of the channel
+			 * @details The configuration is used to look up the index of an output
+			 * variable. It will be NULL, if the publisher was not initialized 
+			 * before.
+			 */
+			const Base::TransmissionChannel * channel_;
+
+			/**
+			 * @brief The encoded message which is reused for every event
+			 * @details The frame always reflects the values of outputVariables_ 
+			 * before it is sent.
+			 */
+			std::vector<uint8_t> frame_;
+
+			/**
+			 * @brief The offset of each encoded output variable in the frame
+			 * @details The index corresponds to the index of outputVariables_. The 
+			 * offsets are only valid if the frame has a fixed layout.
+			 */
+			std::vector<size_t> frameOffsets_;
+
+			/**
+			 * @brief Flags whether the size of each encoded variable is constant
+			 * @details If the flag is set, updated values are patched in place.
+			 * Otherwise, e.g. if the channel contains a string, the whole frame is
+			 * encoded again.
+			 */
+			bool fixedFrameLayout_;
+
 			/**
 			 * @brief Initializes the output variable vector based on the given 
 			 * channel configuration.
@@ -133,6 +179,37 @@ namespace FMITerminalBlock
 			 */
 			void initOutputTypes(const Base::TransmissionChannel &channel);
 
+			/**
+			 * @brief Initializes the outputDeadbands_ vector based on the given 
+			 * configuration.
+			 * @details If a deadband is invalid or configured at a port which is not
+			 * real-valued, a Base::SystemConfigurationException will be thrown.
+			 * @param channel The transmission channel configuration of the channel.
+			 */
+			void initOutputDeadbands(const Base::TransmissionChannel &channel);
+
+			/**
+			 * @brief Encodes the initial frame and determines its layout
+			 * @details The function assumes that outputVariables_ and outputTypes_
+			 * are properly initialized.
+			 */
+			void initFrame();
+
+			/**
+			 * @brief Overwrites the encoded value of the given output variable
+			 * @details The function requires a fixed frame layout. It won't change
+			 * the size of the frame.
+			 * @param index The index of the variable in outputVariables_
+			 */
+			void patchFrame(unsigned index);
+
+			/**
+			 * @brief Returns the number of bytes of an encoded value
+			 * @return The size of the encoded value or zero, if the size depends on
+			 * the value.
+			 */
+			static size_t getEncodedSize(ASN1Commons::DataType type);
+
 			/**
 			 * @brief Returns the default ASN.1 type based on the fmiType
 			 * @param type The FMI source type
@@ -144,7 +221,13 @@ namespace FMITerminalBlock
 			 * @brief Updates the outputVariables_ based on the given Event
 			 * @details The event pointer must be valid. The function will traverse 
 			 * the event's variables and set the internal state vector accordingly.
-			 * The function of this class won't send any message.
+			 * Each variable is routed to its output slots by the constant time 
+			 * lookup of the channel. A real variable whose value remains within the
+			 * configured deadband of the last published value is neither updated 
+			 * nor considered to be relevant. The first value of each variable is
+			 * always relevant. In case the frame has a fixed layout, each
+			 * updated value is directly patched into the frame. The function of this
+			 * class won't send any message.
 			 * @param ev A valid pointer locating the event to process
 			 * @brief <code>true</code> If the event contains at least one relevant 
 			 * variable
@@ -161,39 +244,78 @@ namespace FMITerminalBlock
 			void encodeASN1OutputVariables(std::vector<uint8_t> &buffer);
 
 			/**
-			 * @brief Encodes the given value and appends it to the buffer
-			 * @details Compact encoding rules are applied.
+			 * @brief Encodes the given value of a particular output variable and 
+			 * appends it to the buffer
 			 * @param buffer A reference to the buffer used to append the encoded data
+			 * @param index The index of the variable in outputVariables_
+			 */
+			void encodeOutputVariable(std::vector<uint8_t> &buffer, unsigned index);
+
+			/**
+			 * @brief Encodes the given value of a fixed size output variable into
+			 * the given memory location
+			 * @param dest A pointer to at least getEncodedSize() bytes
+			 * @param index The index of the variable in outputVariables_
+			 */
+			void encodeOutputVariable(uint8_t * dest, unsigned index);
+
+			/**
+			 * @brief Encodes the given value into the given memory location
+			 * @details Compact encoding rules are applied.
+			 * @param dest A pointer to at least nine bytes which will hold the encoded
+			 * data
 			 * @param value The value to encode
 			 */
-			static void encodeLREALValue(std::vector<uint8_t> &buffer, fmiReal value);
+			static void encodeLREALValue(uint8_t * dest, fmiReal value);
 
 			/**
-			 * @brief Encodes the given value and appends it to the buffer
+			 * @brief Encodes the given value into the given memory location
 			 * @details Compact encoding rules are applied. The fmiReal type will be 
 			 * casted using a best effort approach. During this operation some
 			 * precision might get lost.
-			 * @param buffer A reference to the buffer used to append the encoded data
+			 * @param dest A pointer to at least five bytes which will hold the 
+			 * encoded data
 			 * @param value The value to encode
 			 */
-			static void encodeREALValue(std::vector<uint8_t> &buffer, fmiReal value);
-
+			static void encodeREALValue(uint8_t * dest, fmiReal value);
 
 			/**
-			 * @brief Encodes the given value and appends it to the buffer
+			 * @brief Encodes the given value into the given memory location
 			 * @details Compact encoding rules are applied.
-			 * @param buffer A reference to the buffer used to append the encoded data
+			 * @param dest A pointer to at least five bytes which will hold the 
+			 * encoded data
 			 * @param value The value to encode
 			 */
-			static void encodeValue(std::vector<uint8_t> &buffer, fmiInteger value);
+			static void encodeValue(uint8_t * dest, fmiInteger value);
 
 			/**
-			 * @brief Encodes the given value and appends it to the buffer
+			 * @brief Encodes the given value into the given memory location
 			 * @details Compact encoding rules are applied.
-			 * @param buffer A reference to the buffer used to append the encoded data
+			 * @param dest A pointer to at least one byte which will hold the encoded
+			 * data
 			 * @param value The value to encode
 			 */
-			static void encodeValue(std::vector<uint8_t> &buffer, fmiBoolean value);
+			static void encodeValue(uint8_t * dest, fmiBoolean value);
+
+			/**
+			 * @brief Stores the given unsigned integer in network byte order
+			 * @details On little endian hosts, the whole value is swapped at once.
+			 * The result is written by a single copy instead of byte-wise stores.
+			 * @param dest A pointer to at least sizeof(IntType) bytes
+			 * @param value The value to store
+			 */
+			template<typename IntType>
+			static void storeBigEndian(uint8_t * dest, IntType value);
+
+			/**
+			 * @brief Reverses the byte order of the given value
+			 * @details The shift expression is recognized by common compilers which
+			 * emit a single byte swap instruction.
+			 */
+			static uint32_t swapBytes(uint32_t value);
+
+			/** @brief Reverses the byte order of the given value */
+			static uint64_t swapBytes(uint64_t value);
 
 			/**
 			 * @brief Encodes the given value and appends it to the buffer
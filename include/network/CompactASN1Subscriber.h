@@ -17,12 +17,16 @@
 #include <boost/asio/streambuf.hpp>
 #include <boost/asio/deadline_timer.hpp>
 
+#include <boost/optional.hpp>
+
+#include <chrono>
 #include <vector>
 #include <stdint.h>
 #include <functional>
 #include <memory>
 
 #include "timing/Event.h"
+#include "network/IOServicePool.h"
 #include "network/PartialEvent.h"
 
 namespace FMITerminalBlock
@@ -55,8 +59,27 @@ namespace FMITerminalBlock
 			 */
 			static const std::string PROP_PACKET_TIMEOUT;
 
-			/** @brief Creates an uninitialized object */
-			CompactASN1Subscriber();
+			/**
+			 * @brief Property name specifying the number of frames which are 
+			 * requested by a single receive operation
+			 */
+			static const std::string PROP_RECEIVE_BATCH;
+
+			/** 
+			 * @brief Creates an uninitialized object
+			 * @param defaultReceiveBatch The number of frames which are received at
+			 * once, if the channel doesn't specify it
+			 */
+			CompactASN1Subscriber(size_t defaultReceiveBatch = 1);
+
+			/**
+			 * @brief Serves the subscriber by the given thread pool
+			 * @details The function must be called before the subscriber is 
+			 * initialized. Instead of running a private io_service object in a 
+			 * dedicated thread, all handlers are executed by the threads of the 
+			 * pool. The handlers of the subscriber are serialized by a strand.
+			 */
+			void setIOServicePool(std::shared_ptr<IOServicePool> pool);
 
 		protected:
 			/**
@@ -88,6 +111,9 @@ namespace FMITerminalBlock
 			 */
 			virtual void terminationRequest();
 
+			/** @brief Returns false if the subscriber is served by a pool */
+			virtual bool requiresThread() const;
+
 			/**
 			 * @brief Shuts down the network connection
 			 * @details The function is called in the context of the executing 
@@ -105,6 +131,14 @@ namespace FMITerminalBlock
 			 */
 			boost::asio::io_service* getIOService();
 
+			/**
+			 * @brief Returns the strand which must wrap every handler
+			 * @details The pointer is valid after init() was called. Each handler
+			 * must be wrapped by the strand in order to serialize the handlers and
+			 * to wait for pending handlers on termination.
+			 */
+			ChannelStrand* getStrand();
+
 			/**
 			 * @brief Returns a valid reference to the channel configuration
 			 * @details The pointer remains valid until the subscriber is terminated.
@@ -117,7 +151,10 @@ namespace FMITerminalBlock
 			 * function is called, commitData(size_t) must be called. The 
 			 * prepareData() function must not be called again before the data is 
 			 * committed. The returned buffer remains valid until the 
-			 * commitData(size_t) function is called.
+			 * commitData(size_t) function is called. The size of the buffer is 
+			 * derived from the port template of the channel. It covers the 
+			 * remaining bytes of the current frame and the configured number of 
+			 * additional frames.
 			 * @return The data buffer which has the expected data size.
 			 */
 			boost::asio::streambuf::mutable_buffers_type prepareData();
@@ -134,6 +171,82 @@ namespace FMITerminalBlock
 			 */
 			void commitData(size_t actualSize);
 
+			/**
+			 * @brief Processes a whole datagram which was received at once
+			 * @details The datagram is expected to hold at least one whole frame.
+			 * Any remaining data which doesn't form a complete frame is registered
+			 * as partial event and discarded. Each event of the datagram is dated
+			 * back to the given reception time. Since no data is kept, the packet
+			 * timer is not restarted. The function must not be mixed with the 
+			 * prepareData() and commitData(size_t) interface.
+			 * @param data The valid buffer which holds the datagram
+			 * @param size The number of bytes of the datagram
+			 * @param received The system time at which the datagram was received,
+			 * if known
+			 */
+			void commitDatagram(const uint8_t *data, size_t size,
+				boost::optional<std::chrono::system_clock::time_point> received);
+
+			/** @brief Returns the configured number of frames per receive call */
+			size_t getReceiveBatch() const;
+
+			/**
+			 * @brief Returns the estimated size of a whole frame
+			 * @details The estimation assumes the default encoding of each port and
+			 * empty strings.
+			 */
+			size_t getEstimatedFrameSize() const;
+
+			/**
+			 * @brief Holds the decoding state of a single stream of frames
+			 * @details Per default, the subscriber decodes a single stream. 
+			 * Subclasses which receive several streams at once, e.g. one per 
+			 * connection, maintain one state per stream. The state of a stream must
+			 * be selected before any data of the stream is prepared or committed.
+			 */
+			class FrameState
+			{
+			public:
+				/** @brief Creates an empty state which uses the given service */
+				FrameState(boost::asio::io_service &service);
+				/** @brief Deletes any partially received event */
+				~FrameState();
+
+				/**
+				 * @brief All received but not registered event variables.
+				 * @details The reference may be NULL in case all variables were 
+				 * registered at the event sink.
+				 */
+				PartialEvent *partialData;
+				/** @brief All unprocessed data elements */
+				boost::asio::streambuf rawData;
+				/**
+				 * @brief The number of bytes which are missing to complete the next
+				 * variable or zero
+				 */
+				size_t missingData;
+				/** @brief the timer which handles packet timeouts */
+				boost::asio::deadline_timer packetTimer;
+			};
+
+			/**
+			 * @brief Creates the state of another stream of frames
+			 * @details The function must not be called before init() is executed. 
+			 * The state must be released before the subscriber is deleted.
+			 */
+			std::shared_ptr<FrameState> createFrameState();
+
+			/** @brief Selects the state which is used to decode the next data */
+			void selectFrameState(const std::shared_ptr<FrameState> &state);
+
+			/**
+			 * @brief Finishes the selected stream of frames
+			 * @details A partially received event is registered right away and
+			 * any unprocessed data is discarded. The state may be reused 
+			 * afterwards.
+			 */
+			void flushFrameState();
+
 		private:
 
 			/** @brief Encodes the decoding operation status code */
@@ -168,16 +281,43 @@ namespace FMITerminalBlock
 			std::shared_ptr<Timing::EventSink> eventSink_;
 
 			/**
-			 * @brief All received but not registered event variables.
-			 * @details The reference may be NULL in case all variables were 
-			 * registered at the event sink.
+			 * @brief The estimated number of bytes from the given port index until
+			 * the end of a frame
+			 * @details The vector holds one additional trailing zero entry. Hence, 
+			 * the first element contains the estimated size of a whole frame. The
+			 * estimation assumes the default encoding of each port and empty 
+			 * strings.
 			 */
-			PartialEvent *partialData_ = NULL;
+			std::vector<size_t> remainingFrameSize_;
+
+			/** @brief The number of frames which are requested at once */
+			size_t receiveBatch_;
 
-			/** @brief All unprocessed data elements */
-			boost::asio::streambuf remainingRawData_;
+			/** @brief The reception time of the currently processed datagram */
+			boost::optional<std::chrono::system_clock::time_point> 
+				datagramReceived_;
 
-			/** @brief The IO service which handles all tasks */
+			/** @brief Describes the decoding of a single value of a frame */
+			typedef struct
+			{
+				FMIVariableType type; ///< The type of the port
+				uint8_t tag; ///< The expected tag or BOOL0 for boolean ports
+				size_t offset; ///< The position of the tag within the frame
+			} DecodingStep;
+
+			/**
+			 * @brief The decoding plan of frames which exactly match the default 
+			 * encoding of each port
+			 * @details Each frame which follows the plan has the size of the first
+			 * remainingFrameSize_ element. The plan is empty, if the channel 
+			 * contains variably sized string ports.
+			 */
+			std::vector<DecodingStep> fixedLayout_;
+
+			/** @brief The shared thread pool or NULL */
+			std::shared_ptr<IOServicePool> ioPool_;
+
+			/** @brief The private IO service which is used without a pool */
 			boost::asio::io_service service_;
 			/** 
 			 * @brief Prevents the service_ object from exiting while no work is to 
@@ -189,8 +329,59 @@ namespace FMITerminalBlock
 			 */
 			std::unique_ptr<boost::asio::io_service::work> busyKeeper_;
 
-			/** @brief the timer which handles packet timeouts */
-			std::shared_ptr<boost::asio::deadline_timer> packetTimeoutTimer_;
+			/** @brief Serializes all handlers of the subscriber */
+			std::unique_ptr<ChannelStrand> strand_;
+
+			/** @brief The time until a whole frame must be received */
+			boost::posix_time::time_duration packetTimeout_;
+
+			/** @brief The state of the subscriber's default stream of frames */
+			std::shared_ptr<FrameState> defaultState_;
+			/** @brief The currently selected state, never NULL after init() */
+			std::shared_ptr<FrameState> state_;
+
+			/** @brief Initializes the estimated frame sizes */
+			void initFrameSizes();
+
+			/**
+			 * @brief Returns the estimated number of bytes which are needed to 
+			 * complete the current frame
+			 */
+			size_t getRemainingFrameSize() const;
+
+			/**
+			 * @brief Returns the estimated size of an encoded value of the given 
+			 * type
+			 * @details The size of the default encoding is returned. Strings are 
+			 * assumed to be empty.
+			 */
+			static size_t getEstimatedSize(FMIVariableType type);
+
+			/**
+			 * @brief Generates the decoding plan of fixed-layout frames, if the 
+			 * port types permit it
+			 */
+			void initFixedLayout();
+
+			/**
+			 * @brief Decodes a whole frame by the fixed-layout plan
+			 * @details The function may only be called at the beginning of a frame.
+			 * If the buffer holds a whole frame whose tags exactly match the plan, 
+			 * the frame is consumed and the event is registered. Otherwise, no data
+			 * is consumed and the generic decoder has to be used.
+			 * @return Whether the frame was decoded
+			 */
+			bool processFixedLayoutFrame();
+
+			/**
+			 * @brief Returns the time stamp of a frame which starts now
+			 * @details If a datagram is processed, its age is taken into account.
+			 * The age is measured when the time stamp is taken.
+			 */
+			fmiTime getFrameTimeStamp();
+
+			/** @brief Decodes the committed data until it is consumed */
+			void decodeData();
 
 			/** @brief Clears the timer and starts the interval anew */
 			void restartPacketTimer();
@@ -201,7 +392,8 @@ namespace FMITerminalBlock
 			 * registered and all new data items are considered to be part of another
 			 * event.
 			 */
-			void handlePacketTimeout(const boost::system::error_code& error);
+			void handlePacketTimeout(std::weak_ptr<FrameState> state,
+				const boost::system::error_code& error);
 
 			/** @brief Empties the buffer of unprocessed raw data */
 			void clearUnprocessedData();
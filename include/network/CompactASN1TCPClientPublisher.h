@@ -12,8 +12,19 @@
 #define _FMITERMINALBLOCK_NETWORK_COMPACT_ASN1_TCP_CLIENT_PUBLISHER
 
 #include "network/CompactASN1Publisher.h"
+#include "network/IOServicePool.h"
 
-namespace FMITerminalBlock 
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace FMITerminalBlock
 {
 	namespace Network
 	{
@@ -22,10 +33,30 @@ namespace FMITerminalBlock
 
 		/**
 		 * @brief Provides the functionality of publishing ASN.1 messages via TCP
-		 * @details The class uses its base class to encode the compactly encoded
-		 * ASN.1 messages. It will send these messages to a given TCP socket and 
+		 * @details <p> The class uses its base class to encode the compactly encoded
+		 * ASN.1 messages. It will send these messages to a given TCP socket and
 		 * will ignore any reply. The publisher thereby acts as a client which
-		 * establishes the connection during initialization.
+		 * establishes the connection during initialization.</p>
+		 * <p> Messages are written asynchronously by a background thread. The
+		 * dispatcher thread only appends each message to a bounded write queue.
+		 * Whenever the previous write completes, all queued messages are written
+		 * by a single gathering write operation. If the queue is full, the
+		 * dispatcher thread waits until the pending messages are handed over to
+		 * the next write operation. Hence, no message is lost and the order is
+		 * kept. Optionally, the oldest queued message is dropped instead.</p>
+		 * <p> In case the connection is lost, the publisher reconnects in the
+		 * background. The interval between two attempts is doubled after each
+		 * failed attempt until the configured maximum is reached. Messages which
+		 * were not completely written are sent again after reconnecting. If the
+		 * configured number of consecutive attempts fail, an exception is thrown
+		 * on the next message.</p>
+		 * <p> Instead of running a private background thread, the publisher may
+		 * be served by a shared IOServicePool.</p>
+		 * <p> In the coalescing mode, the write queue holds a single message only.
+		 * Each new message replaces the queued one. Since every message contains
+		 * the whole output image, the latest values are sent as soon as the
+		 * connection accepts more data. Hence, a lagging connection skips
+		 * intermediate messages instead of accumulating a backlog.</p>
 		 */
 		class CompactASN1TCPClientPublisher: public CompactASN1Publisher
 		{
@@ -35,33 +66,168 @@ namespace FMITerminalBlock
 
 			/** @brief The address property's name*/
 			static const std::string PROP_ADDR;
+			/** @brief The name of the property which enables coalescing */
+			static const std::string PROP_COALESCE;
+			/** @brief The name of the property which enables TCP_NODELAY */
+			static const std::string PROP_NO_DELAY;
+			/** @brief The name of the write queue size property */
+			static const std::string PROP_WRITE_QUEUE_SIZE;
+			/** @brief The name of the property which drops messages on overflow */
+			static const std::string PROP_DROP_OLDEST;
+			/** @brief The initial reconnection interval configuration key */
+			static const std::string PROP_RECON_INTERVAL;
+			/** @brief The maximum reconnection interval configuration key */
+			static const std::string PROP_RECON_MAX_INTERVAL;
+			/** @brief The retry count configuration key */
+			static const std::string PROP_RETRY_COUNT;
+
+			/** @brief The default maximum number of queued messages */
+			static const size_t DEFAULT_WRITE_QUEUE_SIZE = 64;
 
 			/**
 			 * @brief Creates a disconnected Publisher instance
 			 */
 			CompactASN1TCPClientPublisher(void);
 
-			/** @brief Disconnects and deletes the publisher */
+			/**
+			 * @brief Disconnects and deletes the publisher
+			 * @details Messages which are not written yet are dropped.
+			 */
 			virtual ~CompactASN1TCPClientPublisher(void);
 
 			/**
 			 * @copydoc Publisher::init()
+			 * @details The first connection is established synchronously. A
+			 * std::runtime_error is thrown if it fails.
 			 */
 			virtual void init(const Base::TransmissionChannel &channel);
 
+			/**
+			 * @brief Serves the publisher by the given thread pool
+			 * @details The function must be called before the publisher is 
+			 * initialized. No private background thread is started in that case.
+			 */
+			void setIOServicePool(std::shared_ptr<IOServicePool> pool);
+
 		protected:
-			/** @brief Sends the given data */
+			/**
+			 * @brief Queues the given data
+			 * @details The function returns immediately unless the write queue is
+			 * full and dropping messages is disabled. In that case, the function
+			 * waits until the queue accepts the message. A previous error, e.g. a
+			 * failed reconnection, is thrown as std::runtime_error.
+			 */
 			virtual void sendData(const std::vector<uint8_t> &buffer);
 
 		private:
-			/** @brief The service object used to manage the transmission */
+			/** @brief The shared thread pool or NULL */
+			std::shared_ptr<IOServicePool> ioPool_;
+			/** @brief The private service object which is used without a pool */
 			boost::asio::io_service service_;
-			/** 
-			 * @brief Pointer to a connected socket
-			 * @details The pointer will be populated on initialization. It is used to
-			 * transport messages to the remote end point.
+			/** @brief Keeps the background thread running */
+			std::unique_ptr<boost::asio::io_service::work> work_;
+			/** @brief Runs the service object's handlers */
+			std::thread ioThread_;
+			/** @brief Keeps track of pending handlers */
+			std::unique_ptr<ChannelStrand> strand_;
+
+			/** @brief The socket which is connected to the remote end point */
+			std::unique_ptr<tcp::socket> socket_;
+			/** @brief Delays the next reconnection attempt */
+			std::unique_ptr<boost::asio::steady_timer> reconnectTimer_;
+			/** @brief The resolved candidates of the remote end point */
+			std::vector<tcp::endpoint> endpoints_;
+			/** @brief The configured address used for logging */
+			std::string addr_;
+
+			/** @brief Flags whether the coalescing mode is enabled */
+			bool coalesce_;
+			/** @brief Flags whether TCP_NODELAY is set on each connection */
+			bool noDelay_;
+			/** @brief The maximum number of queued messages */
+			size_t writeQueueSize_;
+			/** @brief Flags whether a full queue drops its oldest message */
+			bool dropOldest_;
+			/** @brief The interval before the first reconnection attempt */
+			std::chrono::milliseconds reconnectInterval_;
+			/** @brief The upper limit of the reconnection interval */
+			std::chrono::milliseconds reconnectMaxInterval_;
+			/** @brief The number of attempts until an exception is thrown */
+			uint32_t reconnectRetries_;
+
+			/** @brief Protects the connection state and all write buffers */
+			std::mutex mutex_;
+			/** @brief Signals that the write queue was drained or an error occurred */
+			std::condition_variable queueDrained_;
+			/** @brief The messages which wait for the next write operation */
+			std::deque<std::vector<uint8_t>> writeQueue_;
+			/** @brief The messages of the current write operation */
+			std::vector<std::vector<uint8_t>> writeBatch_;
+			/** @brief Recycled message buffers which keep their capacity */
+			std::vector<std::vector<uint8_t>> spareBuffers_;
+			/** @brief The buffer sequence of the current gathering write */
+			std::vector<boost::asio::const_buffer> gatherBuffers_;
+
+			/** @brief Flags whether the socket is connected */
+			bool connected_;
+			/** @brief Flags whether a write operation is in progress */
+			bool writing_;
+			/** @brief Flags whether the pooled publisher is being deleted */
+			bool closing_;
+			/** @brief The number of consecutive failed connection attempts */
+			uint32_t failedAttempts_;
+			/** @brief The interval before the next reconnection attempt */
+			std::chrono::milliseconds nextInterval_;
+			/** @brief A pending error which is thrown on the next message or NULL */
+			std::exception_ptr error_;
+
+			/**
+			 * @brief Reads the channel's configuration directives
+			 * @details A Base::SystemConfigurationException is thrown in case of an
+			 * invalid configuration.
 			 */
-			tcp::socket * socket_;
+			void initConfiguration(const Base::TransmissionChannel &channel);
+
+			/** @brief Returns the service object which runs the handlers */
+			boost::asio::io_service & getIOService();
+
+			/**
+			 * @brief Appends the given message to the write queue
+			 * @details The mutex must be held by the caller. The oldest message is
+			 * dropped if the queue is full.
+			 */
+			void queueMessage(const std::vector<uint8_t> &buffer);
+
+			/**
+			 * @brief Initiates writing all queued messages
+			 * @details The mutex must be held by the caller. The socket must be
+			 * connected and no other write operation may be in progress.
+			 */
+			void startWrite();
+
+			/** @brief Handles a completed write operation */
+			void handleWrite(const boost::system::error_code &error);
+
+			/**
+			 * @brief Initiates an asynchronous connection attempt
+			 * @details The mutex must be held by the caller.
+			 */
+			void startConnect();
+
+			/** @brief Handles a completed connection attempt */
+			void handleConnect(const boost::system::error_code &error);
+
+			/** @brief Handles an expired reconnection timer */
+			void handleReconnectTimer(const boost::system::error_code &error);
+
+			/**
+			 * @brief Sets the options of a freshly connected socket
+			 * @details A boost::system::system_error is thrown on failure.
+			 */
+			void configureSocket();
+
+			/** @brief Returns the given message buffer for later reuse */
+			void recycle(std::vector<uint8_t> &buffer);
 		};
 
 	}
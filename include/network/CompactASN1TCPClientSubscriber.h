@@ -14,8 +14,10 @@
 #include "CompactASN1Subscriber.h"
 
 #include <memory>
+#include <vector>
 
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
 
 namespace FMITerminalBlock
 {
@@ -34,7 +36,8 @@ namespace FMITerminalBlock
 			static const std::string PROP_RETRY_COUNT;
 
 			/** @brief Creates an uninitialized object */
-			CompactASN1TCPClientSubscriber() {}
+			CompactASN1TCPClientSubscriber(): reconnectionTimeout_(500),
+				reconnectionRetries_(4), failedAttempts_(0) {}
 
 		protected:
 			/** @brief Tries to connect the subscriber */
@@ -46,27 +49,45 @@ namespace FMITerminalBlock
 		private:
 			/** @brief The socket which is used to communicate to the server */
 			std::shared_ptr<boost::asio::ip::tcp::socket> socket_;
+			/** @brief Delays the next reconnection attempt */
+			std::unique_ptr<boost::asio::steady_timer> reconnectTimer_;
+			/** @brief The resolved candidates of the server's end point */
+			std::vector<boost::asio::ip::tcp::endpoint> endpoints_;
 
 			/** @brief The interval between two reconnection attempts */
 			std::chrono::milliseconds reconnectionTimeout_;
 			/** @brief The number of retry operations until an exception is thrown.*/
 			uint32_t reconnectionRetries_;
+			/** @brief The number of consecutive failed reconnection attempts */
+			uint32_t failedAttempts_;
 
 			/**
-			 * @brief Tries to synchronously re-connect to the registered server
+			 * @brief Tries to synchronously connect to the registered server
 			 * @details The function may throw a SystemConfigurationException if it 
 			 * is unable to connect to the server. It expects the socket object 
-			 * pointer to be created properly.
+			 * pointer to be created properly. The resolved end points are kept 
+			 * for reconnecting.
 			 */
 			void syncConnect();
 
 			/**
-			 * @brief Tries to re-connect several times
-			 * @details The re-connection interval and retry count is taken from the
-			 * global variables. An exception will be thrown in case the function 
-			 * fails to re-connect.
+			 * @brief Initiates an asynchronous reconnection attempt
+			 * @details The function returns immediately. Hence, no thread is 
+			 * blocked while the subscriber waits for the server, even if it is 
+			 * served by a shared IOServicePool.
 			 */
-			void syncReconnect();
+			void startReconnect();
+
+			/**
+			 * @brief Handles a completed reconnection attempt
+			 * @details After a failed attempt, the next one is started as soon as 
+			 * the re-connection interval expired. An exception will be thrown in 
+			 * case the configured number of attempts failed.
+			 */
+			void handleReconnect(const boost::system::error_code &error);
+
+			/** @brief Handles an expired reconnection timer */
+			void handleReconnectTimer(const boost::system::error_code &error);
 
 			/**
 			 * @brief Initiates an asynchronous receive operation
@@ -0,0 +1,128 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file CompactASN1TCPServerSubscriber.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_NETWORK_COMPACT_ASN1_TCP_SERVER_SUBSCRIBER
+#define _FMITERMINALBLOCK_NETWORK_COMPACT_ASN1_TCP_SERVER_SUBSCRIBER
+
+#include "CompactASN1Subscriber.h"
+
+#include <list>
+#include <memory>
+#include <string>
+
+#include <boost/asio/ip/tcp.hpp>
+
+namespace FMITerminalBlock
+{
+	namespace Network
+	{
+		/**
+		 * @brief Receives compactly encoded ASN.1 frames from many TCP clients
+		 * @details <p> The subscriber listens on the configured local address and
+		 * accepts any number of connections up to the configured limit. Every
+		 * connection feeds the same channel. Hence, each peer is expected to send
+		 * whole frames of the channel's port template.</p>
+		 * <p> All connections are multiplexed on the subscriber's strand.
+		 * Each connection keeps its own decoding state. Therefore, frames of
+		 * several peers may be interleaved arbitrarily. If a peer disconnects,
+		 * its partially received frame is registered as partial event.</p>
+		 */
+		class CompactASN1TCPServerSubscriber: public CompactASN1Subscriber
+		{
+		public:
+			/** @brief A human readable protocol identifier */
+			static const std::string SUBSCRIBER_ID;
+			/** @brief The local address configuration key */
+			static const std::string PROP_ADDR;
+			/** @brief The maximum number of connections configuration key */
+			static const std::string PROP_MAX_CONNECTIONS;
+
+			/** @brief The default maximum number of concurrent connections */
+			static const size_t DEFAULT_MAX_CONNECTIONS = 64;
+
+			/** @brief Creates an uninitialized object */
+			CompactASN1TCPServerSubscriber();
+
+		protected:
+			/** @brief Starts listening for incoming connections */
+			virtual void initNetwork();
+
+			/** @brief Closes the listening socket and every connection */
+			virtual void terminateNetworkConnection();
+
+		private:
+			/** @brief Holds the resources of a single accepted connection */
+			class Connection
+			{
+			public:
+				/** @brief Creates an unconnected object */
+				Connection(boost::asio::io_service &service,
+					std::shared_ptr<FrameState> state);
+
+				/** @brief The socket which is connected to the peer */
+				boost::asio::ip::tcp::socket socket;
+				/** @brief The decoding state of the connection */
+				std::shared_ptr<FrameState> state;
+				/** @brief The textual representation of the peer used for logging */
+				std::string peer;
+			};
+
+			/** @brief The socket which accepts new connections */
+			std::shared_ptr<boost::asio::ip::tcp::acceptor> acceptor_;
+
+			/** @brief The maximum number of concurrent connections */
+			size_t maxConnections_;
+
+			/** @brief All connections which are currently open */
+			std::list<std::shared_ptr<Connection>> connections_;
+
+			/**
+			 * @brief Reads the channel's configuration directives
+			 * @details A Base::SystemConfigurationException is thrown in case of an
+			 * invalid configuration.
+			 */
+			void initConfigVariables();
+
+			/**
+			 * @brief Resolves the configured local address and starts listening
+			 * @details A Base::SystemConfigurationException is thrown on failure.
+			 */
+			void listen();
+
+			/** @brief Initiates accepting the next connection */
+			void initiateAsyncAccepting();
+
+			/**
+			 * @brief Registers a newly accepted connection
+			 * @param connection The connection object which was accepted
+			 * @param error The status of the operation
+			 */
+			void handleAccept(std::shared_ptr<Connection> connection,
+				const boost::system::error_code& error);
+
+			/**
+			 * @brief Initiates an asynchronous receive operation
+			 * @details The function selects the connection's decoding state,
+			 * requests a new buffer and returns immediately.
+			 */
+			void initiateAsyncReceiving(std::shared_ptr<Connection> connection);
+
+			/**
+			 * @brief Processes a completed receive operation
+			 * @param connection The connection which received the data
+			 * @param error The status of the operation
+			 * @param bytesTransferred The number of read bytes
+			 */
+			void handleReceive(std::shared_ptr<Connection> connection,
+				const boost::system::error_code& error, std::size_t bytesTransferred);
+		};
+	}
+}
+#endif
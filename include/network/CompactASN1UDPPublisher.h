@@ -12,6 +12,9 @@
 #define _FMITERMINALBLOCK_NETWORK_COMPACT_ASN1_UDP_PUBLISHER
 
 #include "network/CompactASN1Publisher.h"
+#include "network/UDPTransmitter.h"
+
+#include <memory>
 
 namespace FMITerminalBlock 
 {
@@ -24,7 +27,9 @@ namespace FMITerminalBlock
 		 * @brief Provides the functionality of publishing ASN.1 messages via UDP
 		 * @details The class uses it's base class to encode the compactly encoded
 		 * ASN.1 messages. It will send these messages to a given UDP socket and 
-		 * will ignore any reply.
+		 * will ignore any reply. In case a UDPTransmitter is set, the messages 
+		 * are queued at the transmitter instead and sent as soon as the 
+		 * transmitter is flushed.
 		 */
 		class CompactASN1UDPPublisher: public CompactASN1Publisher
 		{
@@ -49,6 +54,14 @@ namespace FMITerminalBlock
 			 */
 			virtual void init(const Base::TransmissionChannel &channel);
 
+			/**
+			 * @brief Sets the transmitter which sends the messages of the publisher
+			 * @details The function has to be called before init(). If no 
+			 * transmitter is set, each message is sent immediately.
+			 * @param transmitter The shared transmitter instance
+			 */
+			void setTransmitter(std::shared_ptr<UDPTransmitter> transmitter);
+
 		protected:
 			/** @brief Sends the given data */
 			virtual void sendData(const std::vector<uint8_t> &buffer);
@@ -65,6 +78,11 @@ namespace FMITerminalBlock
 			 */
 			udp::socket * socket_;
 
+			/** @brief The transmitter which sends the messages or NULL */
+			std::shared_ptr<UDPTransmitter> transmitter_;
+			/** @brief The slot of the publisher at the transmitter */
+			size_t transmitterSlot_;
+
 		};
 
 	}
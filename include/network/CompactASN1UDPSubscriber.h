@@ -0,0 +1,141 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file CompactASN1UDPSubscriber.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_NETWORK_COMPACT_ASN1_UDP_SUBSCRIBER
+#define _FMITERMINALBLOCK_NETWORK_COMPACT_ASN1_UDP_SUBSCRIBER
+
+#include "CompactASN1Subscriber.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <boost/asio/ip/udp.hpp>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+namespace FMITerminalBlock
+{
+	namespace Network
+	{
+		/**
+		 * @brief Receives compactly encoded ASN.1 frames via UDP
+		 * @details <p> The subscriber binds to the configured local address and
+		 * processes each received datagram as a separate frame. Hence, a frame
+		 * must not be split across several datagrams.</p>
+		 * <p> On Linux, all pending datagrams are received by a single recvmmsg
+		 * call up to the configured receive batch. Each datagram is dated back
+		 * by the time which passed since the kernel received it
+		 * (SO_TIMESTAMPNS). Hence, the event time doesn't depend on the time the
+		 * datagram waited in the socket's queue. On other platforms, one
+		 * datagram is received at a time and the processing time is used.</p>
+		 * <p> Unless a maximum datagram size is configured, the size of each
+		 * receive slot is derived from the ports of the channel. It doubles the
+		 * estimated frame size to cover wider encodings and adds a fixed amount
+		 * per string port.</p>
+		 */
+		class CompactASN1UDPSubscriber: public CompactASN1Subscriber
+		{
+		public:
+			/** @brief A human readable protocol identifier */
+			static const std::string SUBSCRIBER_ID;
+			/** @brief The local address configuration key */
+			static const std::string PROP_ADDR;
+			/** @brief The maximum datagram size configuration key */
+			static const std::string PROP_MAX_DATAGRAM_SIZE;
+
+			/** @brief The default number of datagrams per receive call */
+			static const size_t DEFAULT_RECEIVE_BATCH = 16;
+			/** @brief The upper limit of the maximum datagram size in bytes */
+			static const size_t MAX_DATAGRAM_SIZE = 65507;
+			/** @brief The default number of bytes reserved per string port */
+			static const size_t DEFAULT_STRING_SIZE = 1024;
+
+			/** @brief Creates an uninitialized object */
+			CompactASN1UDPSubscriber();
+
+		protected:
+			/** @brief Binds the socket and starts receiving */
+			virtual void initNetwork();
+
+			/** @brief Closes the socket */
+			virtual void terminateNetworkConnection();
+
+		private:
+			/** @brief The socket which receives the datagrams */
+			std::shared_ptr<boost::asio::ip::udp::socket> socket_;
+
+			/** @brief The maximum size of a single datagram */
+			size_t maxDatagramSize_;
+
+			/**
+			 * @brief The receive buffer
+			 * @details The buffer holds one slot of maxDatagramSize_ bytes per
+			 * datagram which may be received at once.
+			 */
+			std::vector<uint8_t> buffer_;
+
+#ifdef __linux__
+			/** @brief The message headers of a single recvmmsg call */
+			std::vector<struct mmsghdr> messages_;
+			/** @brief The data vectors which point to the buffer slots */
+			std::vector<struct iovec> dataVectors_;
+			/** @brief The ancillary data buffer of each message */
+			std::vector<char> control_;
+			/** @brief The size of the ancillary data buffer of a message */
+			size_t controlSize_;
+#endif
+
+			/**
+			 * @brief Reads the channel's configuration directives
+			 * @details A Base::SystemConfigurationException is thrown in case of an
+			 * invalid configuration.
+			 */
+			void initConfigVariables();
+
+			/** @brief Returns the maximum datagram size of the channel's ports */
+			size_t getDefaultDatagramSize() const;
+
+			/**
+			 * @brief Resolves the configured local address and binds the socket
+			 * @details A Base::SystemConfigurationException is thrown on failure.
+			 */
+			void bindSocket();
+
+			/** @brief Initiates an asynchronous receive operation */
+			void initiateAsyncReceiving();
+
+			/**
+			 * @brief Processes a completed receive operation
+			 * @details On Linux, the operation just signals that datagrams are
+			 * available.
+			 * @param error The status of the operation
+			 * @param bytesTransferred The number of read bytes
+			 */
+			void handleReceive(const boost::system::error_code& error,
+				std::size_t bytesTransferred);
+
+#ifdef __linux__
+			/** @brief Drains all pending datagrams of the socket */
+			void receiveDatagrams();
+
+			/**
+			 * @brief Returns the system time at which the message was received
+			 * @details Nothing is returned if the kernel didn't attach a time stamp.
+			 */
+			static boost::optional<std::chrono::system_clock::time_point>
+				getReceptionTime(const struct msghdr &message);
+#endif
+		};
+	}
+}
+#endif
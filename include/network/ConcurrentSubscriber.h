@@ -50,7 +50,8 @@ namespace FMITerminalBlock
 			 * @copydoc Subscriber::initAndStart(const Base::TransmissionChannel, \
 						std::shared_ptr<Timing::EventSink>, \
 						std::function<void(std::exception_ptr)>)
-			 * @details Initializes the object and starts a new thread of execution.
+			 * @details Initializes the object and starts a new thread of execution,
+			 * if the subscriber requires one.
 			 * The function shall not be overloaded by child instances in order to
 			 * ensure proper initialization. Use the provided init() function
 			 * instead.
@@ -62,10 +63,12 @@ namespace FMITerminalBlock
 
 			/**
 			 * @brief Processes an external termination request
-			 * @details The function will block until the run() function returns. It 
-			 * should not be overloaded by child classes in order to ensure that the 
-			 * isTerminationRequestPending() returns the correct result. Use 
-			 * terminationRequest() to be notified of pending termination requests.
+			 * @details The function will block until the run() function returns or,
+			 * in case no dedicated thread is used, until terminationRequest() 
+			 * returns. It should not be overloaded by child classes in order to 
+			 * ensure that the isTerminationRequestPending() returns the correct 
+			 * result. Use terminationRequest() to be notified of pending 
+			 * termination requests.
 			 */
 			virtual void terminate();
 
@@ -100,6 +103,17 @@ namespace FMITerminalBlock
 			 */
 			virtual void terminationRequest() {}
 
+			/**
+			 * @brief Returns whether the subscriber needs a dedicated thread
+			 * @details Per default, a new thread of execution is started which 
+			 * calls run(). A subscriber which is served by a shared thread pool 
+			 * may return false. In this case, run() is never called and 
+			 * terminationRequest() must not return before all pending tasks are 
+			 * completed. The result must not change while the subscriber is 
+			 * running.
+			 */
+			virtual bool requiresThread() const { return true; }
+
 			/**
 			 * @brief checks whether a termination request is pending
 			 * @details The function is thread save and may be called concurrently.
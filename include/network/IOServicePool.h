@@ -0,0 +1,171 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file IOServicePool.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_NETWORK_IO_SERVICE_POOL
+#define _FMITERMINALBLOCK_NETWORK_IO_SERVICE_POOL
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace FMITerminalBlock
+{
+	namespace Network
+	{
+		/**
+		 * @brief Runs a single io_service object by a fixed number of threads
+		 * @details <p> Network channels which support the pool register their
+		 * asynchronous operations at the shared io_service object instead of
+		 * running a private one in a dedicated thread. Hence, the number of
+		 * threads doesn't grow with the number of channels.</p>
+		 * <p> Each channel serializes its handlers by a ChannelStrand. An
+		 * exception which escapes a handler is passed to the error callback and
+		 * the thread continues serving the remaining handlers.</p>
+		 */
+		class IOServicePool
+		{
+		public:
+			/**
+			 * @brief Starts the given number of threads
+			 * @param threads The positive number of threads
+			 * @param errorCallback The function which is called on every exception
+			 * which escapes a handler. It may be called concurrently.
+			 */
+			IOServicePool(size_t threads,
+				std::function<void(std::exception_ptr)> errorCallback);
+
+			/**
+			 * @brief Stops the service and joins all threads
+			 * @details Pending handlers are not executed anymore. Hence, all
+			 * channels must be shut down before.
+			 */
+			~IOServicePool();
+
+			/** @brief Returns the shared service object */
+			boost::asio::io_service & getIOService();
+
+			/** @brief Returns the number of threads */
+			size_t getNumberOfThreads() const;
+
+		private:
+			/** @brief The shared service object */
+			boost::asio::io_service service_;
+			/** @brief Keeps the threads running while no work is to be done */
+			std::unique_ptr<boost::asio::io_service::work> work_;
+			/** @brief The threads which run the service */
+			std::vector<std::thread> threads_;
+			/** @brief Handles exceptions which escape a handler */
+			std::function<void(std::exception_ptr)> errorCallback_;
+
+			/** @brief Runs the service until it is stopped */
+			void run();
+		};
+
+		/**
+		 * @brief Serializes the handlers of a single channel and keeps track of
+		 * the handlers which were not executed yet
+		 * @details Every handler which is wrapped by the strand is executed
+		 * exclusively. Additionally, the strand counts the wrapped handlers which
+		 * are still pending. The channel may wait until all of them are executed
+		 * before it is deleted. It is assumed that each wrapped handler is
+		 * executed exactly once, i.e. the service is not stopped prematurely.
+		 */
+		class ChannelStrand
+		{
+			/** @brief Calls the wrapped handler and releases it afterwards */
+			template<typename Handler>
+			class TrackedHandler;
+
+		public:
+			/** @brief Creates a strand of the given service object */
+			ChannelStrand(boost::asio::io_service &service);
+
+			/**
+			 * @brief Returns a handler which executes the given one on the strand
+			 * @details The returned handler must be executed exactly once.
+			 */
+			template<typename Handler>
+			auto wrap(Handler handler) -> decltype(
+				std::declval<boost::asio::io_service::strand &>().wrap(
+					std::declval<TrackedHandler<Handler>>()))
+			{
+				acquire();
+				return strand_.wrap(TrackedHandler<Handler>(this, handler));
+			}
+
+			/** @brief Executes the given function on the strand */
+			template<typename Handler>
+			void post(Handler handler)
+			{
+				strand_.post(wrap(handler));
+			}
+
+			/**
+			 * @brief Blocks until every wrapped handler is executed
+			 * @details The function must not be called by a handler of the strand.
+			 */
+			void waitUntilIdle();
+
+		private:
+			template<typename Handler>
+			class TrackedHandler
+			{
+			public:
+				TrackedHandler(ChannelStrand *owner, Handler handler):
+					owner_(owner), handler_(handler) {}
+
+				template<typename... Args>
+				void operator()(Args&&... args)
+				{
+					Releaser releaser(owner_);
+					handler_(std::forward<Args>(args)...);
+				}
+
+			private:
+				/** @brief Releases the handler even if it throws an exception */
+				class Releaser
+				{
+				public:
+					Releaser(ChannelStrand *owner): owner_(owner) {}
+					~Releaser() { owner_->release(); }
+				private:
+					ChannelStrand *owner_;
+				};
+
+				ChannelStrand *owner_;
+				Handler handler_;
+			};
+
+			/** @brief The underlying strand object */
+			boost::asio::io_service::strand strand_;
+			/** @brief Guards the number of pending handlers */
+			std::mutex mutex_;
+			/** @brief Signals that no handler is pending anymore */
+			std::condition_variable idle_;
+			/** @brief The number of handlers which were not executed yet */
+			size_t pending_;
+
+			/** @brief Registers a new pending handler */
+			void acquire();
+			/** @brief Unregisters an executed handler */
+			void release();
+		};
+	}
+}
+
+#endif
@@ -13,8 +13,10 @@
 
 #include "base/ApplicationContext.h"
 #include "timing/EventDispatcher.h"
+#include "network/IOServicePool.h"
 #include "network/Publisher.h"
 #include "network/Subscriber.h"
+#include "network/UDPTransmitter.h"
 
 #include <exception>
 #include <functional>
@@ -44,6 +46,17 @@ namespace FMITerminalBlock
 			 */
 			static const std::string PROP_PROTOCOL;
 
+			/**
+			 * @brief The property name of the flag which enables batched UDP 
+			 * transmission
+			 */
+			static const std::string PROP_BATCH_UDP;
+
+			/**
+			 * @brief The property name of the number of shared network threads
+			 */
+			static const std::string PROP_THREADS;
+
 			/**
 			 * @brief Instantiates the network stack and the object's members
 			 * @details The application context object is evaluated to retrieve the
@@ -103,6 +116,13 @@ namespace FMITerminalBlock
 				NetworkManager &parent_;
 			};
 
+			/**
+			 * @brief Runs the handlers of all channels which support a shared pool
+			 * @details The pointer is NULL if the shared thread pool is disabled. 
+			 * The pool must outlive every managed channel.
+			 */
+			std::shared_ptr<IOServicePool> ioPool_;
+
 			/** @brief List which stores a pointer to every managed publisher */
 			std::list<std::shared_ptr<Publisher>> publisher_;
 
@@ -121,6 +141,13 @@ namespace FMITerminalBlock
 			/** @brief Checks the exception status as soon as an event is received */
 			std::shared_ptr<ExceptionBomb> exceptionTester_;
 
+			/**
+			 * @brief Sends the datagrams of all UDP publishers at the end of the 
+			 * distribution
+			 * @details The pointer is NULL if batched UDP transmission is disabled.
+			 */
+			std::shared_ptr<UDPTransmitter> udpTransmitter_;
+
 			/**
 			 * @brief Instantiates and initializes the given network entity
 			 * @details The network entity type, i.e. a Publisher or Subscriber, is 
@@ -133,14 +160,15 @@ namespace FMITerminalBlock
 			 * @param instFct The instantiation function which creates new network 
 			 * entities.
 			 * @param initFct The initialization function which is called on every 
-			 * network entity.
+			 * network entity. The function may replace the entity before it is 
+			 * appended to the list.
 			 */
 			template<typename BaseType>
 			static void addChannels(
 				std::list<std::shared_ptr<BaseType>> *destinationList, 
 				const Base::ChannelMapping * channels,
 				std::function<std::shared_ptr<BaseType>(const std::string&)> instFct,
-				std::function<void(std::shared_ptr<BaseType>, 
+				std::function<void(std::shared_ptr<BaseType>&, 
 						const Base::TransmissionChannel&)> initFct);
 
 			/**
@@ -161,9 +189,19 @@ namespace FMITerminalBlock
 			static std::shared_ptr<Subscriber> instantiateSubscriber(
 				const std::string &id);
 
+			/**
+			 * @brief Returns the configured number of shared network threads
+			 * @details Zero disables the shared thread pool. A 
+			 * Base::SystemConfigurationException is thrown in case of an invalid 
+			 * value.
+			 */
+			static size_t getNumberOfThreads(Base::ApplicationContext &context);
+
 			/**
 			 * @brief Adds all publisher as EventListener instances to the given 
 			 * EventDispatcher.
+			 * @details The UDP transmitter is added after all publishers. Hence, it
+			 * flushes the datagrams after each publisher processed the event.
 			 */
 			void addListeningPublisher(Timing::EventDispatcher &dispatcher);
 
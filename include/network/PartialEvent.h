@@ -13,6 +13,7 @@
 
 #include "timing/Event.h"
 
+#include <assert.h>
 #include <vector>
 
 namespace FMITerminalBlock 
@@ -50,7 +51,7 @@ namespace FMITerminalBlock
 			/**
 			 * @copydoc FMITerminalBlock::Timing::Event::getVariables()
 			 */
-			virtual std::vector<Timing::Variable> getVariables(void);
+			virtual const std::vector<Timing::Variable> & getVariables(void);
 
 			/**
 			 * @copydoc FMITerminalBlock::Timing::Event::toString()
@@ -66,6 +67,12 @@ namespace FMITerminalBlock
 			 */
 			FMIVariableType getNextPortType() const;
 
+			/**
+			 * @brief Returns the index of the next port in the port template
+			 * @details It is assumed that there are sill remaining elements left.
+			 */
+			unsigned int getNextPortIndex() const;
+
 			/**
 			 * @brief Appends the value to the list of variables
 			 * @details It is assumed that there are still remaining elements. 
@@ -74,6 +81,20 @@ namespace FMITerminalBlock
 			 */
 			void pushNextValue(boost::any value);
 
+			/**
+			 * @brief Appends the typed value to the list of variables
+			 * @details Contrary to pushNextValue(boost::any), the value is directly
+			 * stored without any intermediate boost::any object. The same 
+			 * assumptions apply.
+			 */
+			template<typename ValueType>
+			void pushNextTypedValue(ValueType value)
+			{
+				assert(hasRemainingElements());
+				var_.emplace_back(portTemplate_[nextTemplateIndex_], value);
+				nextTemplateIndex_++;
+			}
+
 			/**
 			 * @brief Skips the next port and don't append it.
 			 * @brief It is assumed that there are still remaining elements.
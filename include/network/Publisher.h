@@ -45,6 +45,7 @@ namespace FMITerminalBlock
 			 * If something went wrong a std::runtime_error or
 			 * Base::SystemConfigurationException may be thrown.
 			 * @param channel The channel configuration which includes any property subtrees.
+			 * The reference must remain valid until the publisher is destroyed.
 			 */
 			virtual void init(const Base::TransmissionChannel &channel) = 0;
 
@@ -0,0 +1,147 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file UDPTransmitter.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_NETWORK_UDP_TRANSMITTER
+#define _FMITERMINALBLOCK_NETWORK_UDP_TRANSMITTER
+
+#include "base/environment-helper.h"
+#include "timing/EventListener.h"
+
+#include <boost/asio.hpp>
+
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
+namespace FMITerminalBlock
+{
+	namespace Network
+	{
+		using namespace FMITerminalBlock;
+		using namespace boost::asio::ip;
+
+		/**
+		 * @brief Collects UDP datagrams of several publishers and sends them at
+		 * once
+		 * @details <p> Each publisher registers its destination and obtains a
+		 * slot. Instead of sending a datagram on its own, the publisher queues
+		 * the datagram in its slot. All queued datagrams are sent as soon as the
+		 * transmitter is flushed.</p>
+		 * <p> The transmitter is an EventListener which flushes the queued
+		 * datagrams whenever it is notified. If it is registered at the
+		 * EventDispatcher after all UDP publishers, all datagrams of a single
+		 * event are sent at the end of the distribution. On Linux, the datagrams
+		 * of a socket are sent by a single sendmmsg call. On other platforms,
+		 * each datagram is still sent separately.</p>
+		 * <p> The transmitter uses one socket per protocol version. It is not
+		 * thread-safe and must be used by the dispatcher thread only.</p>
+		 */
+		class UDPTransmitter: public Timing::EventListener
+		{
+		public:
+
+			/** @brief Creates a transmitter without any slot */
+			UDPTransmitter();
+
+			/** @brief Closes the opened sockets */
+			virtual ~UDPTransmitter() {}
+
+			/**
+			 * @brief Registers a new destination
+			 * @details The function opens the socket of the destination's protocol
+			 * if necessary. A std::runtime_error is thrown if the socket can't be
+			 * opened.
+			 * @param destination The remote end point of the queued datagrams
+			 * @return The slot number which is used to queue datagrams
+			 */
+			size_t addDestination(const udp::endpoint &destination);
+
+			/**
+			 * @brief Queues the datagram of the given slot
+			 * @details The content of the buffer is copied. If a datagram is
+			 * already queued in the slot, it will be replaced.
+			 * @param slot A slot number which was returned by addDestination()
+			 * @param buffer The datagram to send on the next flush
+			 */
+			void enqueue(size_t slot, const std::vector<uint8_t> &buffer);
+
+			/**
+			 * @brief Sends all queued datagrams
+			 * @details A datagram which cannot be transferred is logged and
+			 * skipped. The remaining datagrams are still sent. Afterwards, the
+			 * first error is thrown as boost::system::system_error, similar to a
+			 * publisher which sends its datagram on its own. The queue is empty in
+			 * any case.
+			 */
+			void flush();
+
+			/** @brief Flushes all queued datagrams */
+			virtual void eventTriggered(Timing::Event * ev);
+
+		private:
+
+			/** @brief The queue entry of a single destination */
+			struct Slot
+			{
+				/** @brief The remote end point of the datagram */
+				udp::endpoint destination;
+				/** @brief The socket which matches the destination's protocol */
+				udp::socket * socket;
+				/** @brief The datagram which is sent on the next flush */
+				std::vector<uint8_t> datagram;
+				/** @brief Flags whether the datagram was queued */
+				bool pending;
+			};
+
+			/** @brief The service object used to manage the sockets */
+			boost::asio::io_service service_;
+			/** @brief The socket of all IPv4 destinations or NULL */
+			std::unique_ptr<udp::socket> socketV4_;
+			/** @brief The socket of all IPv6 destinations or NULL */
+			std::unique_ptr<udp::socket> socketV6_;
+
+			/** @brief The registered destinations */
+			std::vector<Slot> slots_;
+			/** @brief The slot numbers of all queued datagrams */
+			std::vector<size_t> pendingSlots_;
+
+#ifdef __linux__
+			/** @brief Reused message headers of a single sendmmsg call */
+			std::vector<struct mmsghdr> messages_;
+			/** @brief Reused data vectors of a single sendmmsg call */
+			std::vector<struct iovec> dataVectors_;
+			/** @brief The slot number of each message of a sendmmsg call */
+			std::vector<size_t> messageSlots_;
+#endif
+
+			/**
+			 * @brief Sends all queued datagrams of the given socket
+			 * @details Failing datagrams are logged and skipped.
+			 * @param socket A valid socket pointer
+			 * @return The error of the first failing datagram or an empty code
+			 */
+			boost::system::error_code flush(udp::socket * socket);
+
+			/**
+			 * @brief Logs the transmission result of a single datagram
+			 * @param slot The slot of the datagram
+			 * @param transferred The number of bytes transferred
+			 */
+			void logTransmission(const Slot &slot, size_t transferred) const;
+		};
+
+	}
+}
+
+#endif
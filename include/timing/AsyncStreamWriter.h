@@ -0,0 +1,216 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file AsyncStreamWriter.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_TIMING_ASYNC_STREAM_WRITER
+#define _FMITERMINALBLOCK_TIMING_ASYNC_STREAM_WRITER
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/ApplicationContext.h"
+
+namespace FMITerminalBlock
+{
+	namespace Timing
+	{
+		/**
+		 * @brief Buffers formatted records and writes them by a background thread
+		 * @details <p> The writer acts as stream buffer. Records are formatted
+		 * into a large in-memory buffer by an std::ostream which uses the writer.
+		 * After each record, endRecord() has to be called. Depending on the
+		 * configured flush policy, the buffer is handed over to the background
+		 * thread after each record, as soon as the configured interval elapsed,
+		 * or as soon as the configured buffer size is reached. The background
+		 * thread writes and flushes the handed over buffers. Hence, the formatting
+		 * thread never waits for the destination.</p>
+		 * <p> The current buffer is exclusively owned by the formatting thread.
+		 * Each flush policy is therefore only evaluated by endRecord(). In
+		 * particular, the flush interval is not a latency bound. Records which
+		 * are not followed by another one stay in the buffer until flush() is
+		 * called or the writer is deleted.</p>
+		 * <p> At most the configured number of buffers wait for the background
+		 * thread. In case the backlog is full, the overflow policy either blocks
+		 * the formatting thread until a buffer is written or it drops the handed
+		 * over buffer. Write errors are reported by the next hand over.</p>
+		 * <p> The configuration is read from the application context. Each
+		 * property name is prefixed by the given prefix and a dot.</p>
+		 */
+		class AsyncStreamWriter: public std::streambuf
+		{
+		public:
+
+			/** @brief The name of the flush policy property */
+			static const std::string PROP_FLUSH;
+			/** @brief The name of the flush interval property in milliseconds */
+			static const std::string PROP_FLUSH_INTERVAL;
+			/** @brief The name of the buffer size property in bytes */
+			static const std::string PROP_BUFFER_SIZE;
+			/** @brief The name of the property of the maximum backlog */
+			static const std::string PROP_BACKLOG;
+			/** @brief The name of the overflow policy property */
+			static const std::string PROP_OVERFLOW;
+
+			/** @brief The default size of a single buffer in bytes */
+			static const size_t DEFAULT_BUFFER_SIZE = 65536;
+			/** @brief The default maximum number of buffers which wait */
+			static const size_t DEFAULT_BACKLOG = 16;
+			/** @brief The default flush interval in milliseconds */
+			static const int DEFAULT_FLUSH_INTERVAL = 1000;
+
+			/** @brief Enumerates the conditions which hand over the buffer */
+			enum FlushPolicy
+			{
+				FLUSH_ROW = 0, ///< Hands over the buffer after each record
+				FLUSH_INTERVAL, ///< Hands over the buffer after an elapsed interval
+				FLUSH_SIZE ///< Hands over the buffer as soon as it is full
+			};
+
+			/** @brief The configuration names of each FlushPolicy */
+			static const char * FLUSH_POLICY_NAMES[3];
+
+			/** @brief Enumerates the supported overflow policies */
+			enum OverflowPolicy
+			{
+				BLOCK = 0, ///< Waits until the background thread writes a buffer
+				DROP ///< Drops the handed over buffer
+			};
+
+			/** @brief The configuration names of each OverflowPolicy */
+			static const char * OVERFLOW_POLICY_NAMES[2];
+
+			/**
+			 * @brief Reads the configuration and starts the background thread
+			 * @details A Base::SystemConfigurationException is thrown in case of an
+			 * invalid configuration.
+			 * @param destination The stream which receives the data. It must
+			 * outlive the writer and it must not be used by anyone else.
+			 * @param context The application context which holds the configuration
+			 * @param prefix The prefix of each configuration property
+			 */
+			AsyncStreamWriter(std::ostream &destination,
+				const Base::ApplicationContext &context, const std::string &prefix);
+
+			/**
+			 * @brief Writes all buffered data and stops the background thread
+			 * @details Errors are logged but not thrown.
+			 */
+			virtual ~AsyncStreamWriter();
+
+			/**
+			 * @brief Marks the end of a record and applies the flush policy
+			 * @details A previous write error is thrown as std::runtime_error
+			 * as soon as the buffer is handed over.
+			 */
+			void endRecord();
+
+			/**
+			 * @brief Hands over the buffer and waits until everything is written
+			 * @details A std::runtime_error is thrown if the data could not be
+			 * written.
+			 */
+			void flush();
+
+			/** @brief Returns the number of records which were dropped */
+			size_t getDroppedRecords();
+
+		protected:
+			/** @brief Enlarges the current buffer and appends the character */
+			virtual int_type overflow(int_type c);
+
+		private:
+
+			/** @brief A buffer which was handed over to the background thread */
+			struct Chunk
+			{
+				/** @brief The storage which holds the formatted data */
+				std::string data;
+				/** @brief The number of bytes of formatted data */
+				size_t size;
+			};
+
+			/** @brief The stream which receives the data */
+			std::ostream &destination_;
+
+			/** @brief The configured flush policy */
+			FlushPolicy flushPolicy_;
+			/** @brief The configured flush interval */
+			std::chrono::milliseconds flushInterval_;
+			/** @brief The configured size of a single buffer */
+			size_t bufferSize_;
+			/** @brief The configured maximum number of waiting buffers */
+			size_t backlog_;
+			/** @brief The configured overflow policy */
+			OverflowPolicy overflowPolicy_;
+
+			/** @brief The buffer which is currently filled */
+			std::string buffer_;
+			/** @brief The number of complete records in the current buffer */
+			size_t records_;
+			/** @brief The time of the last hand over */
+			std::chrono::steady_clock::time_point lastHandOver_;
+
+			/** @brief The buffers which wait for the background thread */
+			std::deque<Chunk> queue_;
+			/** @brief Recycled buffers which keep their capacity */
+			std::vector<std::string> spareBuffers_;
+			/** @brief Protects every variable which is shared with the thread */
+			std::mutex mutex_;
+			/** @brief Notifies the background thread about new buffers */
+			std::condition_variable queueNotEmpty_;
+			/** @brief Notifies about written buffers */
+			std::condition_variable written_;
+			/** @brief Flags whether the background thread is writing */
+			bool writing_;
+			/** @brief Flags that the background thread should terminate */
+			bool terminate_;
+			/** @brief A pending write error or NULL */
+			std::exception_ptr error_;
+			/** @brief The number of dropped records */
+			size_t droppedRecords_;
+
+			/** @brief The thread which writes the buffers */
+			std::thread writerThread_;
+
+			/**
+			 * @brief Reads the configuration properties
+			 * @details A Base::SystemConfigurationException is thrown in case of an
+			 * invalid configuration.
+			 */
+			void initConfiguration(const Base::ApplicationContext &context,
+				const std::string &prefix);
+
+			/** @brief Returns the number of bytes in the current buffer */
+			size_t getBufferedSize() const;
+
+			/** @brief Uses the given storage as the current, empty buffer */
+			void setBuffer(std::string &&buffer);
+
+			/**
+			 * @brief Passes the current buffer to the background thread
+			 * @details Depending on the overflow policy, the function may block.
+			 * A pending error is thrown as std::runtime_error.
+			 */
+			void handOver();
+
+			/** @brief Executes the background thread's main loop */
+			void run();
+		};
+	}
+}
+
+#endif
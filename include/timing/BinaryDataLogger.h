@@ -0,0 +1,135 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file BinaryDataLogger.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_TIMING_BINARY_DATA_LOGGER
+#define _FMITERMINALBLOCK_TIMING_BINARY_DATA_LOGGER
+
+#include <stdint.h>
+
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "base/ApplicationContext.h"
+#include "timing/AsyncStreamWriter.h"
+#include "timing/BinaryRecord.h"
+#include "timing/Event.h"
+#include "timing/EventListener.h"
+
+namespace FMITerminalBlock
+{
+	namespace Timing
+	{
+		/**
+		 * @brief Listens for incoming events and writes them in a binary format
+		 * @details <p> The logger records the same data as the CSVDataLogger but
+		 * it stores each event as a record of fixed size. Each value is copied to
+		 * its fixed offset in the record without any formatting. Hence, the file
+		 * may be memory-mapped for analysis.</p>
+		 * <p> The file starts with a schema header which lists the name, the
+		 * PortID and the offset of each column. Each record starts with the time
+		 * of the event followed by a bit set which flags the present values.
+		 * Absent values are set to zero. The length of a string value is stored
+		 * in the record and the characters are appended after the record. Hence,
+		 * records are only of fixed size if no string column is logged. All
+		 * numbers are stored in the byte order of the host which is indicated by
+		 * the byte order mark of the header. The file format is documented in
+		 * the user documentation.</p>
+		 * <p> Similar to the CSVDataLogger, the records are handed over to an
+		 * AsyncStreamWriter which writes them in the background.</p>
+		 */
+		class BinaryDataLogger: public EventListener
+		{
+		public:
+
+			/** @brief Property name of the file directive */
+			static const std::string PROP_FILE_NAME;
+
+			/** @brief The first eight bytes of each file */
+			static const char MAGIC[8];
+
+			/** @brief The version of the file format */
+			static const uint32_t FORMAT_VERSION = BinaryRecord::FORMAT_VERSION;
+
+			/** @brief The value which indicates the byte order of the file */
+			static const uint32_t BYTE_ORDER_MARK = BinaryRecord::BYTE_ORDER_MARK;
+
+			/**
+			 * @brief Logs all output to the given destination.
+			 * @details The C'tor is mainly in place to test the operation of the
+			 * logger. It is assumed that the given configuration does not contain
+			 * an output file directive. In case an invalid configuration is found,
+			 * a SystemConfigurationException may be thrown.
+			 * @param destination The binary sink of the records
+			 * @param context The configuration of the logger
+			 */
+			BinaryDataLogger(std::ostream &destination,
+				Base::ApplicationContext &context);
+
+			/**
+			 * @brief Parses the given configuration and initializes the logger
+			 * @details In case an invalid configuration is found, a
+			 * Base::SystemConfigurationException will be thrown.
+			 * @param context The application context which describes the
+			 * configuration of the logger
+			 */
+			BinaryDataLogger(Base::ApplicationContext &context);
+
+			/** @brief Writes all buffered records and closes the file */
+			virtual ~BinaryDataLogger();
+
+			/**
+			 * @brief Writes the event to the output stream
+			 * @details A std::runtime_error is thrown if previously buffered records
+			 * could not be written.
+			 */
+			virtual void eventTriggered(Event * ev);
+
+		private:
+
+			/** @brief A pointer to the managed output file, if any. */
+			std::unique_ptr<std::ofstream> outputFileStream_;
+
+			/** @brief Writes the records in the background or NULL */
+			std::unique_ptr<AsyncStreamWriter> writer_;
+
+			/** @brief The layout of each record */
+			BinaryRecord layout_;
+
+			/** @brief The buffer of the current record */
+			std::vector<char> record_;
+
+			/**
+			 * @brief Opens the given file for writing
+			 * @details a Base::SystemConfigurationException will be thrown in case
+			 * the given filename is invalid.
+			 */
+			void openFileStream(const std::string &filename);
+
+			/**
+			 * @brief Starts the background writer and writes the file header
+			 * @details The function waits until the header is written. A
+			 * Base::SystemConfigurationException will be thrown in case of an
+			 * invalid configuration or if the header could not be written.
+			 * @param destination The stream which receives the records
+			 * @param context The configuration of the logger
+			 */
+			void init(std::ostream &destination,
+				Base::ApplicationContext &context);
+
+			/** @brief Appends the given bytes */
+			void append(const char *data, size_t length);
+		};
+	}
+}
+
+#endif
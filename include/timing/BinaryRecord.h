@@ -0,0 +1,146 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file BinaryRecord.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_TIMING_BINARY_RECORD
+#define _FMITERMINALBLOCK_TIMING_BINARY_RECORD
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/ChannelMapping.h"
+#include "timing/ColumnIndex.h"
+#include "timing/Event.h"
+
+namespace FMITerminalBlock
+{
+	namespace Timing
+	{
+		/**
+		 * @brief Encodes events into records of the binary data file format
+		 * @details <p> The record layout consists of the time of the event, a
+		 * bit set which flags the present values and the value of each column at
+		 * its aligned offset. The columns are the variables of the input channel
+		 * mapping followed by the variables of the output channel mapping.</p>
+		 * <p> String values only store their length in the record. The variables
+		 * of the string values are remembered until the next record is encoded.
+		 * Hence, the user of the record may decide where to place the characters.
+		 * </p>
+		 */
+		class BinaryRecord
+		{
+		public:
+
+			/** @brief The value which indicates the byte order of the file */
+			static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+			/** @brief The version of the file format */
+			static const uint32_t FORMAT_VERSION = 1;
+
+			/** @brief The size of the fixed part of the file header */
+			static const uint32_t HEADER_SIZE = 32;
+
+			/** @brief The offset of the present bits in a record */
+			static const uint32_t PRESENT_OFFSET = 8;
+
+			/** @brief Creates a record without any column */
+			BinaryRecord();
+
+			/**
+			 * @brief Initializes the columns and the layout of the record
+			 * @details Any previous layout is discarded.
+			 */
+			void init(const Base::ChannelMapping *inChannelMapping,
+				const Base::ChannelMapping *outChannelMapping);
+
+			/** @brief Returns the size of a record in bytes */
+			uint32_t getSize() const { return size_; }
+
+			/** @brief Returns the number of columns */
+			uint32_t getColumnCount() const { return (uint32_t) header_.size(); }
+
+			/** @brief Returns the offset of the given column's value */
+			uint32_t getOffset(int column) const { return offsets_[column]; }
+
+			/** @brief Returns the columns of string values in ascending order */
+			const std::vector<int> &getStringColumns() const
+			{
+				return stringColumns_;
+			}
+
+			/**
+			 * @brief Returns the variable of the i-th string column or NULL
+			 * @details The variable is set by the last encoded event. NULL is
+			 * returned if the event didn't contain the variable.
+			 */
+			const Variable *getString(unsigned i) const { return strings_[i]; }
+
+			/**
+			 * @brief Encodes the given event into the record buffer
+			 * @details The buffer must hold at least getSize() bytes. The first
+			 * occurrence of a variable wins.
+			 */
+			void encode(Event * ev, char *record);
+
+			/**
+			 * @brief Returns the file header including the column list
+			 * @details The returned header is padded to a multiple of eight bytes.
+			 * Additional zero-initialized space is reserved in between the fixed
+			 * part of the header and the column list. The offset of the first
+			 * record is set to the size of the returned header.
+			 * @param magic The first eight bytes of the file
+			 * @param reserved The number of extra bytes which is reserved
+			 */
+			std::vector<char> makeHeader(const char magic[8],
+				uint32_t reserved = 0) const;
+
+		private:
+
+			/** @brief The size of the time value which starts each record */
+			static const uint32_t TIME_SIZE = 8;
+
+			/** @brief the PortIDs in the order of their occurrence */
+			std::vector<Base::PortID> header_;
+
+			/** @brief The names of the columns in the order of their occurrence */
+			std::vector<std::string> names_;
+
+			/** @brief Maps each port to its columns in header_ */
+			ColumnIndex columns_;
+
+			/** @brief The offset of each column's value in a record */
+			std::vector<uint32_t> offsets_;
+
+			/** @brief The columns of string values in ascending order */
+			std::vector<int> stringColumns_;
+
+			/** @brief The variable of each string column or NULL */
+			std::vector<const Variable *> strings_;
+
+			/** @brief The size of a record */
+			uint32_t size_;
+
+			/** @brief Calculates the offset of each column and the record size */
+			void initLayout();
+
+			/** @brief Copies the given variable to the column of the record */
+			void setValue(char *record, int column, const Variable &var);
+
+			/** @brief Appends the native representation of the value */
+			static void append(std::vector<char> &dest, uint32_t value);
+
+			/** @brief Returns the size of a value of the given type in a record */
+			static uint32_t getValueSize(FMIVariableType type);
+		};
+	}
+}
+
+#endif
@@ -14,9 +14,11 @@
 #include <ostream>
 #include <fstream>
 #include <memory>
+#include <vector>
 
-#include <boost/optional.hpp>
-
+#include "timing/AsyncStreamWriter.h"
+#include "timing/ColumnIndex.h"
+#include "timing/RealFormatter.h"
 #include "timing/Event.h"
 #include "base/ApplicationContext.h"
 #include "timing/EventListener.h"
@@ -38,6 +40,12 @@ namespace FMITerminalBlock
 		 * will be left empty. The header will contain the name of the variables in
 		 * the first row and a string describing each variable type in the second 
 		 * row.</p>
+		 * <p> The dispatcher thread only formats each row into a buffer of an
+		 * AsyncStreamWriter. The buffer is written to the destination by a
+		 * background thread according to the configured flush policy. Hence, the
+		 * dispatcher thread doesn't wait for the destination.</p>
+		 * <p> The time and all real values are formatted without any locale by
+		 * a RealFormatter. Per default, each value is written exactly.</p>
 		 */
 		class CSVDataLogger: public EventListener
 		{
@@ -46,6 +54,9 @@ namespace FMITerminalBlock
 			/** @brief Property name of the file directive */
 			static const std::string PROP_CSV_FILE_NAME;
 
+			/** @brief Property name of the number of significant digits */
+			static const std::string PROP_CSV_PRECISION;
+
 			/** @details The character which is used to separate two fields */
 			static const char SEPARATOR = ';';
 
@@ -76,6 +87,8 @@ namespace FMITerminalBlock
 			/** 
 			 * @brief Writes the event to the output stream
 			 * @details It is assumed that the given event instant is always valid.
+			 * A std::runtime_error is thrown if previously buffered rows could not
+			 * be written.
 			 */
 			virtual void eventTriggered(Event * ev);
 
@@ -84,15 +97,37 @@ namespace FMITerminalBlock
 			/** @brief The name of the FMI type per code value */
 			static const char* FMI_TYPE_NAMES[5];
 
-			/** @brief The logging destination or NULL, if no logger is registered */
+			/** 
+			 * @brief The stream which formats into the writer's buffer or NULL, if
+			 * no logger is registered
+			 */
 			std::ostream *outputStream_ = NULL;
 
 			/** @brief A pointer to the managed output file, if any. */
 			std::unique_ptr<std::ofstream> outputFileStream_;
 
+			/** @brief Writes the formatted rows in the background */
+			std::unique_ptr<AsyncStreamWriter> writer_;
+
+			/** @brief Formats the rows into the writer's buffer */
+			std::unique_ptr<std::ostream> bufferStream_;
+
+			/** @brief Formats the time and the real values */
+			RealFormatter formatter_;
+
 			/** @brief the PortIDs in the order of their occurrence */
 			std::vector<Base::PortID> header_;
 
+			/** @brief Maps each port to its columns in header_ */
+			ColumnIndex columns_;
+
+			/**
+			 * @brief The variable of each column in the current row or NULL
+			 * @details The buffer is reused by each row. All entries are NULL in 
+			 * between two rows.
+			 */
+			std::vector<const Variable *> row_;
+
 			/** 
 			 * @brief Opens the given file for writing and sets the corresponding 
 			 * streams
@@ -101,10 +136,27 @@ namespace FMITerminalBlock
 			 */
 			void openFileStream(const std::string &filename);
 
+			/**
+			 * @brief Reads the configured precision of real values
+			 * @details a Base::SystemConfigurationException will be thrown in case 
+			 * of an invalid precision.
+			 */
+			void initFormatter(const Base::ApplicationContext &context);
+
+			/**
+			 * @brief Starts the background writer and sets the formatting stream
+			 * @details a Base::SystemConfigurationException will be thrown in case 
+			 * of an invalid writer configuration.
+			 * @param destination The stream which receives the formatted data
+			 * @param context The configuration of the CSV logger
+			 */
+			void initWriter(std::ostream &destination, 
+				Base::ApplicationContext &context);
+
 			/**
 			 * @brief Writes the file header and initializes the header variables
 			 * @details The function assumes that outputStream_ is properly 
-			 * initialized.
+			 * initialized. It waits until the header is written.
 			 * @param inChannelMapping The input channel configuration
 			 * @param outChannelMapping The output channel configuration
 			 */
@@ -140,20 +192,17 @@ namespace FMITerminalBlock
 			void append(const std::string &value);
 
 			/**
-			 * @brief Appends the given variable, if it holds a value
-			 * @details If var is not populated, the stream is left unmodified
+			 * @brief Appends the given variable, if it is not NULL
+			 * @details If var is NULL, the stream is left unmodified
 			 */
-			void append(boost::optional<Variable> var);
+			void append(const Variable *var);
 
 			/**
-			 * @brief Finds the variable with the given id in the list of variables
-			 * @details If the variable is not present in the list, an empty object 
-			 * will be returned. 
-			 * @param id The id to search
-			 * @param values The list of variables to examine.
+			 * @brief Formats the real value into the writer's buffer
+			 * @details Per default, a round-trip exact representation which reads
+			 * back to the same value is written.
 			 */
-			static boost::optional<Variable> findVariable(Base::PortID id, 
-				const std::vector<Variable> &variables);
+			void append(double value);
 		};
 	}
 }
@@ -0,0 +1,65 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file ColumnIndex.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_TIMING_COLUMN_INDEX
+#define _FMITERMINALBLOCK_TIMING_COLUMN_INDEX
+
+#include <vector>
+
+#include "base/PortID.h"
+
+namespace FMITerminalBlock
+{
+	namespace Timing
+	{
+		/**
+		 * @brief Maps the PortID of a variable to the columns of a data log
+		 * @details A port may be listed several times, e.g. as input and output
+		 * variable. Hence, each column is chained to the next column of the same
+		 * port. The lookup only needs constant time.
+		 */
+		class ColumnIndex
+		{
+		public:
+			/** @brief Creates an empty index */
+			ColumnIndex();
+
+			/**
+			 * @brief Builds the index of the given columns
+			 * @details Any previous index is discarded. The numeric ID of each 
+			 * port must not be negative.
+			 */
+			void init(const std::vector<Base::PortID> &columns);
+
+			/** @brief Returns the first column of the given port or -1 */
+			int getFirstColumn(const Base::PortID &id) const;
+
+			/** @brief Returns the next column of the same port or -1 */
+			int getNextColumn(int column) const
+			{
+				return nextColumn_[column];
+			}
+
+		private:
+			/**
+			 * @brief Maps the type and the numeric ID of a port to its first column
+			 * @details The first dimension is the FMI type of the port and the 
+			 * second one is the numeric ID. Ports which aren't logged are mapped to
+			 * -1.
+			 */
+			std::vector<std::vector<int>> firstColumn_;
+
+			/** @brief Stores the next column of the same port or -1 */
+			std::vector<int> nextColumn_;
+		};
+	}
+}
+
+#endif
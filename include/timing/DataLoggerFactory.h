@@ -0,0 +1,47 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file DataLoggerFactory.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_TIMING_DATA_LOGGER_FACTORY
+#define _FMITERMINALBLOCK_TIMING_DATA_LOGGER_FACTORY
+
+#include <string>
+#include <memory>
+
+#include "timing/EventListener.h"
+#include "base/ApplicationContext.h"
+
+namespace FMITerminalBlock
+{
+	namespace Timing
+	{
+		/**
+		 * @brief Creates the data logger of the configured file format
+		 * @details Currently, available data loggers are manually coded into the
+		 * factory function.
+		 */
+		class DataLoggerFactory
+		{
+		public:
+			/** @brief Property name which specifies the data file format */
+			static const std::string PROP_DATA_FILE_FORMAT;
+
+			/**
+			 * @brief Generates a new data logger
+			 * @details Reads the configuration and constructs the appropriate data
+			 * logger. If no data file is configured, the logger will not record 
+			 * anything. The function may throw a SystemConfigurationException, in 
+			 * case an invalid configuration is found.
+			 */
+			static std::shared_ptr<EventListener> makeDataLogger(
+				Base::ApplicationContext &appContext);
+		};
+	}
+}
+#endif
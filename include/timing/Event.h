@@ -15,6 +15,7 @@
 #include <boost/any.hpp>
 #include <vector>
 #include <utility>
+#include <cstddef>
 
 #include "base/PortID.h"
 #include "timing/Variable.h"
@@ -29,7 +30,9 @@ namespace FMITerminalBlock
 		 * @brief Represents a point in time where one or more values change
 		 * @details The event class provides timed events and encapsulates 
 		 * changed variables. The values may be encapsulated into the event or may
-		 * be retrieved on access.
+		 * be retrieved on access. Events are allocated in the EventPool. Hence,
+		 * creating and deleting events does not stress the global allocator once
+		 * the pool is warmed up.
 		 */
 		class Event
 		{
@@ -45,13 +48,30 @@ namespace FMITerminalBlock
 			virtual ~Event(){};
 
 			/**
-			 * @brief Returns a copy of the event's variables
+			 * @brief Allocates the memory of any event object in the EventPool
+			 * @param size The size of the allocated object
+			 */
+			static void * operator new(std::size_t size);
+
+			/**
+			 * @brief Returns the memory of a deleted event to the EventPool
+			 * @details Since the destructor is virtual, the size corresponds to the
+			 * size of the deleted object and not to the size of the base class.
+			 * @param ptr The memory of the deleted object
+			 * @param size The size of the deleted object
+			 */
+			static void operator delete(void * ptr, std::size_t size);
+
+			/**
+			 * @brief Returns a view of the event's variables
 			 * @details The function shall only be called if the variable's values are
 			 * really needed and if the event is processed. After retrieving the
-			 * variables it might not be able to reset the event.
+			 * variables it might not be able to reset the event. The returned 
+			 * reference is valid as long as the event exists. Listeners should 
+			 * bind it to a const reference instead of copying the variables.
 			 * @return The vector of changed or relevant variables
 			 */
-			virtual std::vector<Variable> getVariables(void) = 0;
+			virtual const std::vector<Variable> & getVariables(void) = 0;
 
 			/**
 			 * @brief Returns the previously set time
@@ -20,7 +20,9 @@
 #include <boost/log/expressions/keyword_fwd.hpp>
 
 #include <boost/thread/mutex.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <string>
+#include <chrono>
 
 namespace FMITerminalBlock 
 {
@@ -40,6 +42,10 @@ namespace FMITerminalBlock
 			endOfDistribution = 2, ///< After distributing the event to its sinks
 			beginOfDistribution = 3, ///< Before notifying the event listeners
 			outdated = 4, ///< The predicted event was outdated due to another event
+			released = 5, ///< After the event queue released the event
+			queuedForPublishing = 6, ///< After queuing the event for asynchronous publishing
+			published = 7, ///< After an asynchronous publisher published the event
+			droppedByPublisher = 8, ///< The queued event was dropped or merged on overflow
 			locationUndefined = -1 ///< Undefined location, should be used with care
 		};
 
@@ -113,16 +119,22 @@ namespace FMITerminalBlock
 			 * software currently only deploys a single time base. Consequently, the
 			 * distribution of logger objects may be kept simple.
 			 *
+			 * The epoch is given in terms of the monotonic steady clock. The 
+			 * corresponding system time is determined once, when the epoch is set.
+			 * It is only used to report the absolute time of a timing record.
+			 *
 			 * The function is not thread save and must only be called in case no 
 			 * other instance uses the time logging facility. Usually, the function 
 			 * is called on startup and hence, the guarantee holds.
 			 */
-			static void setGlobalSimulationEpoch(boost::system_time simulationEpoch);
+			static void setGlobalSimulationEpoch(
+				std::chrono::steady_clock::time_point simulationEpoch);
 
 			/**
 			 * @brief Logs the given event
 			 * @details It is assumed that the given event reference is valid until
-			 * the function returns
+			 * the function returns. In case no timing file sink was added, the 
+			 * function returns immediately.
 			 * @param ev The reference to the recorded event
 			 * @param stage The current stage of the given event
 			 */
@@ -134,7 +146,22 @@ namespace FMITerminalBlock
 			 * @brief The timestamp of the logging facility which corresponds to a 
 			 * simulation time which equals zero.
 			 */
-			static boost::system_time simulationEpoch_;
+			static std::chrono::steady_clock::time_point simulationEpoch_;
+
+			/**
+			 * @brief The local system time which corresponds to the 
+			 * simulationEpoch_
+			 * @details The offset is used to report the absolute time of a timing
+			 * record. It is not affected by subsequent system clock adjustments.
+			 */
+			static boost::posix_time::ptime systemSimulationEpoch_;
+
+			/**
+			 * @brief Flag which indicates that the timing file sink was added
+			 * @details If no sink is present, the event is not logged at all. 
+			 * Similar to the simulation epoch, the flag is only set on startup.
+			 */
+			static bool eventFileSinkAdded_;
 
 			/** @brief Mutex used to synchronize concurrent object access */
 			boost::mutex objectMutex_;
@@ -143,6 +170,9 @@ namespace FMITerminalBlock
 			boost::log::attributes::mutable_constant<fmiTime> eventTimeAttribute_;
 			/** @brief Attribute used to log the external time stamp of a record. */
 			boost::log::attributes::mutable_constant<fmiTime> recordTimeAttribute_;
+			/** @brief Attribute used to log the absolute time stamp of a record. */
+			boost::log::attributes::mutable_constant<boost::posix_time::ptime> 
+				recordTimeStampAttribute_;
 
 			/**
 			 * @brief Returns the absolute time stamp now
@@ -151,7 +181,14 @@ namespace FMITerminalBlock
 			 * eliminates the possibility of different clock systems. Please avoid 
 			 * querying the current time manually. (Although it is quite easy)
 			 */
-			static boost::system_time getAbsoluteRecordTimeNow();
+			static std::chrono::steady_clock::time_point getAbsoluteRecordTimeNow();
+
+			/**
+			 * @brief Returns the local system time which corresponds to the given 
+			 * simulation epoch
+			 */
+			static boost::posix_time::ptime getSystemEpoch(
+				std::chrono::steady_clock::time_point simulationEpoch);
 
 			/** 
 			 * @brief Returns the number of seconds since simulation epoch in a 
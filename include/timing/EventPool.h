@@ -0,0 +1,89 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file EventPool.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_TIMING_EVENT_POOL
+#define _FMITERMINALBLOCK_TIMING_EVENT_POOL
+
+#include <boost/lockfree/stack.hpp>
+
+#include <cstddef>
+
+namespace FMITerminalBlock
+{
+	namespace Timing
+	{
+
+		/**
+		 * @brief Recycles the memory of event objects
+		 * @details <p> The pool maintains a free list of memory blocks for a few
+		 * size classes. Released blocks are kept in the free list and handed out
+		 * again on the next allocation of the same size class. Hence, the global
+		 * allocator is only used until the pool is warmed up. Objects which are
+		 * too large for any size class and blocks which do not fit into a full
+		 * free list are passed to the global allocator.</p>
+		 * <p> The free lists are lock-free and have a fixed capacity. Blocks may
+		 * therefore be allocated and released by different threads without any
+		 * locking. For instance, a subscriber thread may create an event which is
+		 * deleted by the dispatcher thread later on.</p>
+		 * <p> The pool is used by the Event class which overloads its allocation
+		 * functions. Any derived event is therefore allocated in the pool without
+		 * changing the code which creates or deletes it.</p>
+		 */
+		class EventPool
+		{
+		public:
+
+			/** @brief The granularity of the size classes in bytes */
+			static const std::size_t BLOCK_SIZE = 64;
+
+			/** @brief The number of size classes */
+			static const std::size_t SIZE_CLASS_COUNT = 4;
+
+			/** @brief The maximum number of free blocks of each size class */
+			static const std::size_t FREE_LIST_CAPACITY = 1024;
+
+			/**
+			 * @brief Returns a memory block of at least the given size
+			 * @details The function throws std::bad_alloc, if no memory block can
+			 * be allocated.
+			 * @param size The number of bytes to allocate
+			 * @return A valid pointer to the allocated memory block
+			 */
+			static void * allocate(std::size_t size);
+
+			/**
+			 * @brief Returns the given memory block to the pool
+			 * @param ptr The memory block which was previously allocated by
+			 * allocate(). The NULL pointer will be ignored.
+			 * @param size The size which was passed to allocate()
+			 */
+			static void release(void * ptr, std::size_t size);
+
+		private:
+
+			/** @brief The type of a single free list */
+			typedef boost::lockfree::stack<void *,
+				boost::lockfree::capacity<FREE_LIST_CAPACITY>> FreeList;
+
+			/** @brief The free list of each size class */
+			static FreeList freeList_[SIZE_CLASS_COUNT];
+
+			/**
+			 * @brief Returns the size class of the given size
+			 * @return The index of the size class or SIZE_CLASS_COUNT if the size
+			 * does not fit into any size class.
+			 */
+			static std::size_t getSizeClass(std::size_t size);
+		};
+
+	}
+}
+
+#endif
@@ -0,0 +1,101 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file RealFormatter.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_TIMING_REAL_FORMATTER
+#define _FMITERMINALBLOCK_TIMING_REAL_FORMATTER
+
+#include <stddef.h>
+
+namespace FMITerminalBlock
+{
+	namespace Timing
+	{
+		/**
+		 * @brief Converts floating point values to their decimal representation
+		 * @details <p> By default, the formatter generates a round-trip exact
+		 * sequence of digits, i.e. a short sequence which reads back to exactly
+		 * the same value. The digits are generated by the Grisu2 algorithm of
+		 * Florian Loitsch ("Printing Floating-Point Numbers Quickly and
+		 * Accurately with Integers", PLDI 2010) which only needs 64 bit integer
+		 * arithmetic. In rare cases, Grisu2 doesn't find the shortest sequence
+		 * and emits a longer one which still reads back exactly. Alternatively,
+		 * a fixed number of significant digits may be set. </p>
+		 * <p> The output doesn't depend on any locale. Similar to the printf
+		 * conversion %g, the scientific notation is only used for very large
+		 * and very small exponents and trailing zeros are omitted. </p>
+		 */
+		class RealFormatter
+		{
+		public:
+
+			/** @brief The precision which selects the round-trip exact digits */
+			static const int SHORTEST = 0;
+
+			/** @brief The maximum number of significant digits */
+			static const int MAX_PRECISION = 17;
+
+			/** @brief The minimum size of the buffer which receives a value */
+			static const size_t BUFFER_SIZE = 32;
+
+			/**
+			 * @brief Creates a formatter of the given precision
+			 * @param precision The number of significant digits between one and
+			 * MAX_PRECISION or SHORTEST
+			 */
+			RealFormatter(int precision = SHORTEST);
+
+			/** @brief Returns the configured precision */
+			int getPrecision() const;
+
+			/**
+			 * @brief Writes the given value to the buffer
+			 * @details The buffer is not terminated by a null character.
+			 * @param value The value to format
+			 * @param buffer A buffer of at least BUFFER_SIZE characters
+			 * @return The number of written characters
+			 */
+			size_t format(double value, char *buffer) const;
+
+		private:
+
+			/** @brief The number of significant digits or SHORTEST */
+			int precision_;
+
+			/**
+			 * @brief Generates round-trip exact digits of the given finite,
+			 * positive value
+			 * @details The value is given by digits * 10^exponent.
+			 * @return The number of generated digits
+			 */
+			static int generateShortest(double value, char *digits, int &exponent);
+
+			/**
+			 * @brief Generates the rounded digits of the given finite, positive
+			 * value
+			 * @details Trailing zeros are removed. The value is given by
+			 * digits * 10^exponent.
+			 * @return The number of generated digits
+			 */
+			int generatePrecise(double value, char *digits, int &exponent) const;
+
+			/**
+			 * @brief Places the decimal point or appends the exponent
+			 * @details Similar to %g, the scientific notation is used if the
+			 * decimal exponent of the first digit is less than -4 or not less than
+			 * the given limit.
+			 * @return The number of characters written to the buffer
+			 */
+			static size_t formatDigits(const char *digits, int length,
+				int exponent, int scientificExponent, char *buffer);
+		};
+	}
+}
+
+#endif
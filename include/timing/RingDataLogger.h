@@ -0,0 +1,168 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file RingDataLogger.h
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#ifndef _FMITERMINALBLOCK_TIMING_RING_DATA_LOGGER
+#define _FMITERMINALBLOCK_TIMING_RING_DATA_LOGGER
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <string>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "base/ApplicationContext.h"
+#include "timing/BinaryRecord.h"
+#include "timing/Event.h"
+#include "timing/EventListener.h"
+
+namespace FMITerminalBlock
+{
+	namespace Timing
+	{
+		/**
+		 * @brief Records the most recent events in a memory-mapped ring buffer
+		 * @details <p> The logger maps a data file of fixed size into memory.
+		 * Each event is encoded into the next slot of the ring buffer which
+		 * overwrites the oldest event as soon as the ring is full. Hence, the
+		 * disk usage is bounded and no system call is needed per event.</p>
+		 * <p> The file starts with the schema header of the binary data file
+		 * format. Its magic number differs and a control block is inserted in
+		 * front of the column list. The control block stores the total number
+		 * of recorded events, the size of a slot, the number of slots and the
+		 * maximum length of a string. Each slot holds a record of the binary
+		 * data file format followed by the characters of each string column.
+		 * Longer strings are truncated.</p>
+		 * <p> The content of the ring may be dumped into a regular binary data
+		 * file which lists the recorded events in chronological order. Since
+		 * the mapping is shared, the ring file may also be read after the
+		 * program terminated. Other processes must not read it while the
+		 * program is running. Slots are overwritten without any synchronization
+		 * with a reader. Hence, a consistent copy is only obtained by dump() or
+		 * dumpToFile(). A running recorder may be asked to dump its events via
+		 * requestDump(), e.g. from a signal handler.</p>
+		 */
+		class RingDataLogger: public EventListener
+		{
+		public:
+
+			/** @brief Property name of the file directive */
+			static const std::string PROP_FILE_NAME;
+
+			/** @brief Property name of the file size below the file directive */
+			static const std::string PROP_RING_SIZE;
+
+			/** @brief Property name of the string length below the file directive */
+			static const std::string PROP_STRING_SIZE;
+
+			/** @brief Property name of the dump file below the file directive */
+			static const std::string PROP_DUMP_FILE;
+
+			/** @brief The default size of the ring file in bytes */
+			static const int DEFAULT_RING_SIZE = 64 * 1024 * 1024;
+
+			/** @brief The default maximum length of a string in bytes */
+			static const int DEFAULT_STRING_SIZE = 64;
+
+			/** @brief The first eight bytes of each ring file */
+			static const char MAGIC[8];
+
+			/** @brief The size of the control block in front of the columns */
+			static const uint32_t CONTROL_SIZE = 24;
+
+			/**
+			 * @brief Parses the given configuration and maps the ring file
+			 * @details If no data file is configured, the logger will not record
+			 * anything. In case an invalid configuration is found or the file
+			 * can't be mapped, a Base::SystemConfigurationException will be thrown.
+			 * @param context The application context which describes the
+			 * configuration of the logger
+			 */
+			RingDataLogger(Base::ApplicationContext &context);
+
+			/** @brief Flushes the mapped ring file */
+			virtual ~RingDataLogger();
+
+			/** @brief Encodes the event into the next slot of the ring */
+			virtual void eventTriggered(Event * ev);
+
+			/**
+			 * @brief Writes the recorded events as a binary data file
+			 * @details The events are written in chronological order. The function
+			 * must not be called concurrently to eventTriggered(). A
+			 * std::runtime_error is thrown if the destination fails.
+			 * @param destination The binary sink of the data file
+			 */
+			void dump(std::ostream &destination) const;
+
+			/**
+			 * @brief Dumps the recorded events to the configured dump file
+			 * @details Nothing is done if no dump file is configured. The function
+			 * is intended to be called after an error occurred. Hence, it does not
+			 * throw any exception but logs the outcome.
+			 */
+			void dumpToFile() const;
+
+			/**
+			 * @brief Requests a dump of the recorded events
+			 * @details The dump file is written by the next eventTriggered() call
+			 * of a recorder. The function only sets a flag and may be called from
+			 * a signal handler.
+			 */
+			static void requestDump();
+
+		private:
+
+			/** @brief Flags whether the next event triggers a dump */
+			static std::atomic<bool> dumpRequested_;
+
+			/** @brief The mapped ring file or an empty region */
+			boost::interprocess::mapped_region region_;
+
+			/** @brief The layout of each record */
+			BinaryRecord layout_;
+
+			/** @brief The name of the dump file or an empty string */
+			std::string dumpFile_;
+
+			/** @brief The first slot of the ring or NULL */
+			char *data_;
+
+			/** @brief The total number of recorded events */
+			uint64_t count_;
+
+			/** @brief The size of a single slot in bytes */
+			uint32_t slotSize_;
+
+			/** @brief The number of slots */
+			uint32_t capacity_;
+
+			/** @brief The maximum length of a string in bytes */
+			uint32_t stringSize_;
+
+			/**
+			 * @brief Creates and maps the ring file and writes its header
+			 * @details A Base::SystemConfigurationException will be thrown in case
+			 * the file can't be created or mapped.
+			 */
+			void init(const std::string &filename, uint32_t ringSize);
+
+			/** @brief Returns the slot of the given event number */
+			char *getSlot(uint64_t number) const
+			{
+				return data_ + (size_t) (number % capacity_) * slotSize_;
+			}
+		};
+	}
+}
+
+#endif
@@ -14,6 +14,7 @@
 #include "timing/Event.h"
 
 #include <vector>
+#include <memory>
 
 namespace FMITerminalBlock 
 {
@@ -25,7 +26,9 @@ namespace FMITerminalBlock
 		 * @brief Event which holds predefined variables.
 		 * @details A StaticEvent holds an immutable copy of every modified
 		 * variable. The variables will be set at the C'tor and can't be changed
-		 * afterwards.
+		 * afterwards. Since the variables are immutable, copies of a StaticEvent
+		 * share the same variable vector. Copying an event therefore does not 
+		 * copy any variable, regardless of the number of variables.
 		 */
 		class StaticEvent: public Event
 		{
@@ -37,13 +40,27 @@ namespace FMITerminalBlock
 			 */
 			StaticEvent(fmiTime time, const std::vector<Variable> &var);
 
+			/**
+			 * @brief C'tor taking over the given variables
+			 * @details The variables are moved into the event's shared storage.
+			 * @param time The event's time
+			 * @param var The list of populated variables
+			 */
+			StaticEvent(fmiTime time, std::vector<Variable> &&var);
+
+			/**
+			 * @brief Creates an event which shares the variables of the other one
+			 * @details Neither the variables nor their values are copied.
+			 */
+			StaticEvent(const StaticEvent &other) = default;
+
 			/** @brief Frees allocated resources */
 			virtual ~StaticEvent(void){};
 
 			/**
 			 * @copydoc FMITerminalBlock::Timing::Event::getVariables()
 			 */
-			virtual std::vector<Variable> getVariables(void);
+			virtual const std::vector<Variable> & getVariables(void);
 
 			/**
 			 * @copydoc FMITerminalBlock::Timing::Event::toString()
@@ -51,8 +68,16 @@ namespace FMITerminalBlock
 			virtual std::string toString(void) const;
 
 		private:
-			/** @brief The list of associated variables */
-			const std::vector<Variable> var_;
+			/** @brief The shared and immutable list of associated variables */
+			std::shared_ptr<const std::vector<Variable>> var_;
+
+			/**
+			 * @brief Returns the shared storage of an empty variable list
+			 * @details Events without any variable share a single storage to avoid
+			 * any allocation.
+			 */
+			static const std::shared_ptr<const std::vector<Variable>> & 
+				getEmptyVariables();
 
 		};
 
@@ -13,14 +13,16 @@
 
 #include "timing/EventQueue.h"
 #include "timing/EventLogger.h"
+#include "base/ApplicationContext.h"
 
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition_variable.hpp>
-#include <boost/thread/thread_time.hpp>
-#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/lockfree/queue.hpp>
 
-#include <list>
-#include <utility>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
 
 namespace FMITerminalBlock 
 {
@@ -28,7 +30,7 @@ namespace FMITerminalBlock
 	{
 		/**
 		 * @brief EventQueue implementation issuing predicted events in time.
-		 * @details <p> The event queue maintains the reference clock (system 
+		 * @details <p> The event queue maintains the reference clock (monotonic 
 		 * clock). As soon as the reference clock maintains the next event's time, 
 		 * this event will be scheduled. Since the simulation time does not 
 		 * correspond to an absolute time-stamp, the reference time (t_event = 0.0)
@@ -45,6 +47,26 @@ namespace FMITerminalBlock
 		 * the predicted event is always at the first place in the queue, 
 		 * simultaneous events will be sorted accordingly. </p>
 		 *
+		 * <p>The single prediction is kept apart from the external events which
+		 * are stored in a binary heap. Hence, adding and removing an external 
+		 * event takes logarithmic time. The heap is ordered by time slots of the 
+		 * size eps_. Events which fall into the same slot are considered to be 
+		 * simultaneous and are issued in the order of their registration.</p>
+		 *
+		 * <p>External events are not directly inserted into the heap. Each 
+		 * producer puts its events into a lock-free ingress queue which is 
+		 * drained by the consumer of the event queue. Hence, concurrent 
+		 * subscribers do not contend for the queue's mutex. The mutex is only 
+		 * acquired by a producer if the consumer is currently waiting for new 
+		 * events.</p>
+		 *
+		 * <p>The release of an event is timed by a monotonic clock. Several wait
+		 * strategies may be configured which trade CPU time for timing accuracy.
+		 * Apart from the plain condition variable, the queue may sleep coarsely 
+		 * and either spin or sleep via clock_nanosleep for the last few 
+		 * microseconds. The achieved release time of each event is recorded as
+		 * ProcessingStage::released timing record.</p>
+		 *
 		 * <p>For future implementations it is advised to merge events which occur 
 		 * at the same instant of time. Such an implementation may avoid redundant 
 		 * predictions and may improve realtime performance.</p>
@@ -60,6 +82,23 @@ namespace FMITerminalBlock
 			 */
 			const fmiTime eps_ = 1e-3;
 
+			/** @brief The name of the wait strategy property */
+			static const std::string PROP_WAIT_STRATEGY;
+
+			/** @brief The name of the property which holds the fine wait time */
+			static const std::string PROP_WAIT_SPIN_TIME;
+
+			/** @brief Strategy to wait until an event has to be released */
+			enum WaitStrategy
+			{
+				/** @brief Waits on the condition variable until the release time */
+				condition = 0,
+				/** @brief Waits on the condition variable and spins afterwards */
+				hybridSpin = 1,
+				/** @brief Waits on the condition variable and uses a precise sleep */
+				clockNanosleep = 2
+			};
+
 			/**
 			 * @brief C'tor generating an empty TimedEventQueue
 			 * @details The start of simulation time is taken at the C'tor and 
@@ -67,6 +106,17 @@ namespace FMITerminalBlock
 			 */
 			TimedEventQueue(void);
 
+			/**
+			 * @brief C'tor generating an empty TimedEventQueue which is configured
+			 * by the given context
+			 * @details The wait strategy and its parameters are read from the 
+			 * application context. In case the configuration is invalid, a
+			 * Base::SystemConfigurationException will be thrown. The start of 
+			 * simulation time is taken at the C'tor.
+			 * @param context The application context which holds the configuration
+			 */
+			TimedEventQueue(const Base::ApplicationContext &context);
+
 			/** 
 			 * @brief Frees allocated resources
 			 * @details It is assumed that no other thread is concurrently accessing
@@ -86,11 +136,17 @@ namespace FMITerminalBlock
 			 * @brief Returns the first event
 			 * @details It will wait until the next event's time has expired. If no 
 			 * event has been registered, the function will throw a std::logic_error.
+			 * Pending external events of the ingress queue are merged before the 
+			 * first event is determined.
 			 * @return A previously registered event
 			 */
 			virtual Event * get(void);
 
-			/** @copydoc EventSink::pushExternalEvent(Event) */
+			/** 
+			 * @copydoc EventSink::pushExternalEvent(Event)
+			 * @details The event is put into the lock-free ingress queue. It will 
+			 * be ordered as soon as the consumer calls get().
+			 */
 			virtual void pushExternalEvent(Event *ev);
 
 			/** @copydoc EventSink::getTimeStampNow() */
@@ -101,7 +157,8 @@ namespace FMITerminalBlock
 			/**
 			 * @brief Small helper class which synchronizes the initialization
 			 * @details It provides a function which blocks until another resource 
-			 * signals that something has been initialized.
+			 * signals that something has been initialized. Once initialized, the 
+			 * barrier is passed by checking a single atomic flag.
 			 */
 			class InitializationBarrier
 			{
@@ -120,19 +177,63 @@ namespace FMITerminalBlock
 				/** @brief Guards all concurrent accesses */
 				boost::mutex accessMut_;
 				/** @brief indicates the initialization status */
-				bool initialized_;
+				std::atomic<bool> initialized_;
 				/** @brief Signals the initialization event */
 				boost::condition_variable initializationCondition_;
 			};
 
+			/** @brief Entry of the external event heap */
+			struct QueueEntry
+			{
+				/** @brief The queued event, not NULL */
+				Event * event;
+				/** @brief The time slot of the event which is used for ordering */
+				int64_t timeSlot;
+				/** @brief Registration number which orders simultaneous events */
+				uint64_t sequenceNr;
+			};
+
+			/**
+			 * @brief Heap order of two queue entries
+			 * @details Returns <code>true</code> if a is issued after b. The 
+			 * function is used as the comparison function of the standard heap 
+			 * algorithms which put the greatest element to the front.
+			 */
+			static bool isIssuedAfter(const QueueEntry &a, const QueueEntry &b);
+
 			/**
-			 * @brief Ordered list of upcoming events
-			 * @details The most recent event will be at the first indices. The
-			 * boolean flag indicates that the entry is a prediction which is
-			 * invalidated by new events. The queue may contain at most one 
-			 * predicted entry at the very first position.
+			 * @brief The currently predicted event or NULL
+			 * @details The queue holds at most one prediction which is always 
+			 * issued before any external event.
 			 */
-			std::list<std::pair<Event*,bool>> queue_;
+			Event * prediction_;
+
+			/**
+			 * @brief Heap of upcoming external events
+			 * @details The vector is organized by the standard heap functions using
+			 * isIssuedAfter(). The first entry is the next external event to issue.
+			 */
+			std::vector<QueueEntry> externalEvents_;
+
+			/** @brief The sequence number of the next external event */
+			uint64_t nextSequenceNr_;
+
+			/** @brief The number of pre-allocated ingress queue nodes */
+			static const size_t INGRESS_INITIAL_CAPACITY = 256;
+
+			/**
+			 * @brief Lock-free queue of external events which are not ordered yet
+			 * @details The queue may be filled by any number of producers. It is 
+			 * only drained by the consumer which holds the queueMut_.
+			 */
+			boost::lockfree::queue<Event*> ingress_;
+
+			/**
+			 * @brief Flag which indicates that the consumer waits on the 
+			 * newEventCondition_
+			 * @details A producer has to notify the consumer if the flag is set.
+			 */
+			std::atomic<bool> consumerWaiting_;
 
 			/**
 			 * @brief Mutex which is required to read or write any queue related data
@@ -151,8 +252,24 @@ namespace FMITerminalBlock
 			 */
 			InitializationBarrier timeInitBarrier_;
 
-			/** @brief Time-stamp of the fmiTime == 0 */
-			boost::system_time  localEpoch_;
+			/** 
+			 * @brief Monotonic time-stamp of the fmiTime == 0 
+			 * @details The time-stamp is used to release and to time-stamp events.
+			 * Since the steady clock is used, the epoch is not affected by any
+			 * adjustment of the system clock.
+			 */
+			std::chrono::steady_clock::time_point localEpoch_;
+
+			/** @brief The strategy used to wait for the next event */
+			WaitStrategy waitStrategy_;
+
+			/**
+			 * @brief The time before the release which is not waited on the 
+			 * condition variable
+			 * @details The duration is only used by the hybridSpin and the 
+			 * clockNanosleep strategy.
+			 */
+			std::chrono::steady_clock::duration spinTime_;
 
 			/** @brief Used to record external events and timed queue specifics */
 			EventLogger eventLoggerInstance_;
@@ -175,26 +292,109 @@ namespace FMITerminalBlock
 			 */
 			void removeConcurrentPrediction(fmiTime time);
 
+			/**
+			 * @brief Moves all pending events from the ingress queue to the heap
+			 * @details The queue has to be locked by the caller. Every external 
+			 * event is added as if add() would have been called directly.
+			 */
+			void drainIngress();
+
+			/**
+			 * @brief Orders the given event and cleans the queue
+			 * @details The function implements add() but expects the caller to 
+			 * lock the queue before.
+			 */
+			void addLocked(Event * ev, bool predicted);
+
 			/**
 			 * @brief Puts the event in the event queue
 			 * @details The queue won't be cleaned nor locked. The function expects
 			 * the caller to acquire the lock before actually calling the function.
 			 * A predicted event at the same time instant of an external one will
-			 * always be scheduled first.
+			 * always be scheduled first. It is assumed that no other prediction is
+			 * queued, if the given event is a prediction.
 			 * @param ev The event pointer to push, not NULL
 			 * @param predicted Flag which indicates the event's prediction status.
 			 */
 			void push(Event * ev, bool predicted);
 
 			/**
-			 * @brief Returns the system time of the given event
+			 * @brief Returns the next event to issue without removing it
+			 * @details The queue must be locked by the caller. In case the queue is
+			 * empty, NULL will be returned.
+			 */
+			Event * front() const;
+
+			/**
+			 * @brief Removes the event which is returned by front()
+			 * @details The queue must be locked and must not be empty. The event 
+			 * will not be deleted.
+			 */
+			void popFront();
+
+			/**
+			 * @brief Returns the time slot which is used to order the given time
+			 * @details Each slot spans eps_ seconds of simulation time.
+			 */
+			int64_t getTimeSlot(fmiTime time) const;
+
+			/**
+			 * @brief Returns the monotonic time when the given event is released
 			 * @details Converts the time based on the simulation's starting time. 
 			 * The function does not wait until the time is initialized. Hence, it 
 			 * can be used during the initialization process.
 			 * @param ev A valid event reference used to obtain the relative time
-			 * @return The corresponding system time object
+			 * @return The corresponding time point of the steady clock
+			 */
+			std::chrono::steady_clock::time_point getReleaseTime(
+				const Event* ev) const;
+
+			/**
+			 * @brief Blocks until the given release time or a notification
+			 * @details The function applies the configured wait strategy. It may 
+			 * return early, e.g. in case a new event was added. The queue must be 
+			 * locked by the given lock. The lock may be temporarily released.
+			 * @param lock The acquired lock of queueMut_
+			 * @param releaseTime The time when the next event will be released
+			 */
+			void waitUntil(boost::unique_lock<boost::mutex> &lock, 
+				std::chrono::steady_clock::time_point releaseTime);
+
+			/**
+			 * @brief Waits on the condition variable until the given time point
+			 * @details The function may return early in case a notification is 
+			 * received.
+			 */
+			void waitCondition(boost::unique_lock<boost::mutex> &lock, 
+				std::chrono::steady_clock::time_point time);
+
+			/** @brief Busy waits until the given time point is reached */
+			static void spinUntil(std::chrono::steady_clock::time_point time);
+
+			/**
+			 * @brief Sleeps until the given time point without being notified
+			 * @details On POSIX systems, clock_nanosleep is used on the monotonic 
+			 * clock. It is assumed that the steady clock corresponds to 
+			 * CLOCK_MONOTONIC. On other platforms, the standard sleep function is 
+			 * used.
+			 */
+			static void sleepUntil(std::chrono::steady_clock::time_point time);
+
+			/**
+			 * @brief Reads the wait strategy from the given context
+			 * @details A Base::SystemConfigurationException will be thrown, if the
+			 * configured value is invalid.
 			 */
-			boost::system_time getSystemTime(const Event* ev) const;
+			static WaitStrategy getWaitStrategy(
+				const Base::ApplicationContext &context);
+
+			/**
+			 * @brief Reads the spin time from the given context
+			 * @details A Base::SystemConfigurationException will be thrown, if the
+			 * configured value is negative.
+			 */
+			static std::chrono::steady_clock::duration getSpinTime(
+				const Base::ApplicationContext &context);
 
 			/**
 			 * @brief Returns the duration of the fmiTime instant relative to 
@@ -202,25 +402,19 @@ namespace FMITerminalBlock
 			 * @param time A valid simulation time instant
 			 * @return The corresponding duration object
 			 */
-			static boost::posix_time::time_duration getRelativeTime(fmiTime time);
+			static std::chrono::steady_clock::duration getRelativeTime(
+				fmiTime time);
 
 			/**
-			 * @brief Returns the simulation time of the given system time instant
+			 * @brief Returns the simulation time of the given monotonic time instant
 			 * @details The simulation time will be based on the local notion of time 
 			 * which is stored in localEpoch_. The function does not wait until the 
 			 * time is initialized. Hence, it can be used during the initialization 
 			 * process.
-			 * @param sysTime The system time of the event.
+			 * @param time The monotonic time instant to convert
 			 */
-			fmiTime getSimulationTime(const boost::system_time &sysTime) const;
-
-			/**
-			 * @brief Returns whether the event's time is a future time-stamp
-			 * @details The function does not wait until the time is initialized.
-			 * @param ev A valid pointer to the event object
-			 * @return The temporal status of the event
-			 */
-			bool isFutureEvent(const Event* ev) const;
+			fmiTime getSimulationTime(
+				const std::chrono::steady_clock::time_point &time) const;
 
 			/**
 			 * @brief Checks whether the queue holds events strictly before maxTime
@@ -231,13 +425,6 @@ namespace FMITerminalBlock
 			 */
 			bool hasPriorEvents(fmiTime maxTime) const;
 
-			/**
-			 * @brief Checks whether the queue is in a consistent state according 
-			 * to the predictions
-			 * @details The function will assumes that the queue is already locked.
-			 */
-			bool isQueuePredictionConsistent() const;
-
 			/**
 			 * @brief Returns a string representation of the queue.
 			 * @details The function assumes that the queue mutex is already locked.
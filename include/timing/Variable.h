@@ -13,6 +13,8 @@
 
 #include <utility>
 #include <ostream>
+#include <memory>
+#include <string>
 
 #include <boost/any.hpp>
 
@@ -36,7 +38,12 @@ namespace FMITerminalBlock
 		 * properly set, it must not be queried.</p>
 		 * <p> The class is created as lightweight as possible in order to reduce 
 		 * the overhead. Hence, it is mostly justifiable to pass and return it by 
-		 * value.</p>
+		 * value. Real, integer and boolean values are stored in a compact typed 
+		 * slot and do not require any heap allocation. String values are kept 
+		 * out-of-line in an immutable shared buffer. Copying a string variable 
+		 * therefore does not copy the string content.</p>
+		 * <p> The boost::any based interface is kept for convenience purpose. It
+		 * should not be used in any time-critical path.</p>
 		 */
 		class Variable
 		{
@@ -58,6 +65,30 @@ namespace FMITerminalBlock
 			 */
 			Variable(const Base::PortID &id, const boost::any &value = boost::any());
 
+			/** 
+			 * @brief Initializes the variable by the given id and real value 
+			 * @details The value must only be queried if the id is real-typed.
+			 */
+			Variable(const Base::PortID &id, fmiReal value);
+
+			/** 
+			 * @brief Initializes the variable by the given id and integer value 
+			 * @details The value must only be queried if the id is integer-typed.
+			 */
+			Variable(const Base::PortID &id, fmiInteger value);
+
+			/** 
+			 * @brief Initializes the variable by the given id and boolean value 
+			 * @details The value must only be queried if the id is boolean-typed.
+			 */
+			Variable(const Base::PortID &id, fmiBoolean value);
+
+			/** 
+			 * @brief Initializes the variable by the given id and string value 
+			 * @details The value must only be queried if the id is string-typed.
+			 */
+			Variable(const Base::PortID &id, const std::string &value);
+
 			/**
 			 * @brief Generates a variable from the given pair
 			 * @details The C'tor is presented for legacy and convenience purpose. 
@@ -76,10 +107,21 @@ namespace FMITerminalBlock
 			 * @brief Returns the previously set value.
 			 * @details The function must not be called in case the value was not set
 			 * properly or in case the type of the value doesn't correspond to the
-			 * type in the id.
+			 * type in the id. The returned object is generated on each call. Please
+			 * use the typed access functions whenever possible.
 			 */
 			boost::any getValue() const;
 
+			/**
+			 * @brief Returns the value of the variable in the given type
+			 * @details The function is specialized for fmiReal, fmiInteger, 
+			 * fmiBoolean and std::string. It assumes that the variable is valid and 
+			 * that the given type corresponds to the type of the variable. It may be 
+			 * used in templates which operate on all variable types.
+			 */
+			template<typename ValueType>
+			ValueType getTypedValue() const;
+
 			/**
 			 * @brief Returns the real-typed value of the variable
 			 * @details The function assumes that the variable is valid and holds a
@@ -106,7 +148,7 @@ namespace FMITerminalBlock
 			 * @details The function assumes that the variable is valid and holds a
 			 * string value.
 			 */
-			const std::string getStringValue() const;
+			const std::string & getStringValue() const;
 
 
 			/**
@@ -125,6 +167,31 @@ namespace FMITerminalBlock
 			 */
 			void setValue(const boost::any &value);
 
+			/**
+			 * @brief Sets a real value
+			 * @details The value must only be queried if the id is real-typed.
+			 */
+			void setValue(fmiReal value);
+
+			/**
+			 * @brief Sets an integer value
+			 * @details The value must only be queried if the id is integer-typed.
+			 */
+			void setValue(fmiInteger value);
+
+			/**
+			 * @brief Sets a boolean value
+			 * @details The value must only be queried if the id is boolean-typed.
+			 */
+			void setValue(fmiBoolean value);
+
+			/**
+			 * @brief Sets a string value
+			 * @details The value must only be queried if the id is string-typed. 
+			 * The function allocates a new string buffer.
+			 */
+			void setValue(const std::string &value);
+
 			/**
 			 * @brief Checks whether the type is known and corresponds to the value
 			 * @details In case the variable is not valid, certain functions must not
@@ -162,10 +229,34 @@ namespace FMITerminalBlock
 		private:
 			/** @brief The unique identifier of the variable */
 			Base::PortID id_;
-			/** @brief The value which is typed according to the identifier */
-			boost::any data_;
+			/** 
+			 * @brief The type of the stored value 
+			 * @details The type is fmiTypeUnknown, if no value was set or if the 
+			 * value could not be represented.
+			 */
+			FMIVariableType valueType_;
+
+			/** @brief Holds the value of any non-string typed variable */
+			union
+			{
+				fmiReal real_;
+				fmiInteger integer_;
+				fmiBoolean boolean_;
+			} value_;
+
+			/** @brief Holds the value of a string typed variable, if any */
+			std::shared_ptr<const std::string> string_;
 		};
 
+		/** @brief Returns the real value of the variable */
+		template<> fmiReal Variable::getTypedValue<fmiReal>() const;
+		/** @brief Returns the integer value of the variable */
+		template<> fmiInteger Variable::getTypedValue<fmiInteger>() const;
+		/** @brief Returns the boolean value of the variable */
+		template<> fmiBoolean Variable::getTypedValue<fmiBoolean>() const;
+		/** @brief Returns the string value of the variable */
+		template<> std::string Variable::getTypedValue<std::string>() const;
+
 		/**
 		 * @brief Prints the content of the variable
 		 */
@@ -4,5 +4,5 @@ The package contains classes and functions which process the event data files of
 FMITerminalBlock. Dedicated timing information is not covered here.
 """
 
-__all__ = ["event", "reader", "filtered_reader", "simulation_data_type", \
-           "writer"]
+__all__ = ["event", "reader", "binary_reader", "filtered_reader", \
+           "simulation_data_type", "writer"]
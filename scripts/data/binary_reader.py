@@ -0,0 +1,292 @@
+from data.abc.abstract_reader import AbstractReader
+from data.simulation_data_type import SimulationDataType
+from data.event import Event
+
+import mmap
+import struct
+
+class BinaryReader(AbstractReader):
+    """Parses binary event data files as generated by FMITerminalBlock
+
+    The object implements the reader semantic as defined by abc.abstract_reader.
+    Binary data files are written if app.dataFile.format is set to binary. Ring
+    files which are written if the format is set to ring are also accepted. In
+    that case, the events which are still held by the ring are read in
+    chronological order. A ring file must not be read before FMITerminalBlock
+    terminated since its slots are overwritten without any synchronization.
+    Each event is read as is without any filtering. The column accessor
+    functions allow reading the values of a single variable without
+    constructing event objects.
+    """
+
+    MAGIC = b"FMITBDAT"
+    """The first eight bytes of each file"""
+
+    RING_MAGIC = b"FMITBRNG"
+    """The first eight bytes of each ring file"""
+
+    FORMAT_VERSION = 1
+    """The supported version of the file format"""
+
+    BYTE_ORDER_MARK = 0x01020304
+    """The value which indicates the byte order of the file"""
+
+    _FMI_TYPES = {0: SimulationDataType.REAL, 1: SimulationDataType.INTEGER, \
+                  2: SimulationDataType.BOOLEAN, 3: SimulationDataType.STRING}
+
+    _VALUE_FORMATS = {SimulationDataType.REAL: "d", \
+                      SimulationDataType.INTEGER: "i", \
+                      SimulationDataType.BOOLEAN: "B", \
+                      SimulationDataType.STRING: "I"}
+
+    def __init__(self, binary_source):
+        """Initializes the reader and parses the schema header
+
+        The binary_source may be any object which supports the buffer protocol,
+        e.g. a bytes object or a memory-mapped file. Use open_file() to
+        memory-map a file on disk.
+        """
+
+        self._data = memoryview(binary_source).cast("B")
+        self._header = {}
+        self._name_list = []
+        self._type_list = []
+        self._offsets = []
+        self._byte_order = "<"
+        self._record_size = 0
+        self._data_offset = 0
+        self._fixed_size = True
+        self._ring = False
+        self._slot_size = 0
+        self._capacity = 0
+        self._string_size = 0
+        self._add_header()
+
+    @classmethod
+    def open_file(cls, file_name):
+        """Memory-maps the given file and returns a reader of its content"""
+
+        with open(file_name, "rb") as binary_file:
+            return cls(mmap.mmap(binary_file.fileno(), 0, \
+                access=mmap.ACCESS_READ))
+
+    def _add_header(self):
+        """Reads the schema header and adds the columns to the header map"""
+
+        if len(self._data) < 32 or \
+            bytes(self._data[0:8]) not in (self.MAGIC, self.RING_MAGIC):
+            raise ValueError("The given source is not a binary data file")
+        self._ring = bytes(self._data[0:8]) == self.RING_MAGIC
+
+        if struct.unpack_from("<I", self._data, 8)[0] != self.BYTE_ORDER_MARK:
+            self._byte_order = ">"
+        (bom, version, columns, self._record_size, self._data_offset) = \
+            self._unpack("IIIII", 8)
+        if bom != self.BYTE_ORDER_MARK:
+            raise ValueError("Invalid byte order mark {:#x}".format(bom))
+        if version != self.FORMAT_VERSION:
+            raise ValueError("Unsupported file format version {}" \
+                .format(version))
+        if self._data_offset > len(self._data):
+            raise ValueError("The schema header is truncated")
+
+        pos = 32
+        self._slot_size = self._record_size
+        if self._ring:
+            # The control block precedes the column list
+            (self._slot_size, self._capacity, self._string_size) = \
+                self._unpack("III", 40)
+            if self._capacity <= 0 or self._slot_size < self._record_size:
+                raise ValueError("Invalid ring control block")
+            pos = 56
+
+        for i in range(0, columns):
+            (fmi_type, _, offset, length) = self._unpack("IIII", pos)
+            if fmi_type not in self._FMI_TYPES:
+                raise ValueError("Unknown type {} of column {}" \
+                    .format(fmi_type, i))
+            name = bytes(self._data[pos + 16:pos + 16 + length]).decode()
+            pos += 16 + length
+
+            self._name_list.append(name)
+            self._type_list.append(self._FMI_TYPES[fmi_type])
+            self._offsets.append(offset)
+            self._header[name] = self._FMI_TYPES[fmi_type]
+
+        self._fixed_size = self._ring or \
+            SimulationDataType.STRING not in self._type_list
+
+    def _unpack(self, fields, pos):
+        """Unpacks the given struct fields in the byte order of the file"""
+
+        return struct.unpack_from(self._byte_order + fields, self._data, pos)
+
+    def get_header(self):
+        """Returns the header map as defined by AbstractReader"""
+
+        return self._header
+
+    def __iter__(self):
+        """Returns the iterator which constructs all events"""
+
+        return self._generate_events()
+
+    def __len__(self):
+        """Returns the number of records
+
+        The length is only available if no string variable is logged or if a
+        ring file is read.
+        """
+
+        if not self._fixed_size:
+            raise TypeError("The records of string variables vary in size")
+        if self._ring:
+            return self._get_window()[1]
+        return (len(self._data) - self._data_offset) // self._record_size
+
+    def _get_window(self):
+        """Returns the number of the oldest event in the ring and the length
+
+        Once the ring is full, the slot of the oldest event is the next one to
+        be overwritten. If the program terminated while writing it, the event
+        may be torn. Hence, the oldest event of a full ring is skipped.
+        """
+
+        count = self._unpack("Q", 32)[0]
+        length = min(count, self._capacity - 1)
+        return (count - length, length)
+
+    def get_times(self):
+        """Returns the list of event times
+
+        Similar to __len__, the function requires records of fixed size.
+        """
+
+        return self._get_column_values("d", 0)
+
+    def get_column(self, variable_name):
+        """Returns the list of values of the given variable per event
+
+        Values which are not associated with an event are set to None. Similar
+        to __len__, the function requires records of fixed size.
+        """
+
+        column = self._name_list.index(variable_name)
+        if self._type_list[column] == SimulationDataType.STRING:
+            # The characters are not stored at a fixed offset of the record
+            return [event.get(variable_name) for event in self]
+
+        values = self._get_column_values( \
+            self._VALUE_FORMATS[self._type_list[column]], self._offsets[column])
+        mask = 1 << (column % 8)
+        present = self._get_column_values("B", 8 + column // 8)
+        if self._type_list[column] == SimulationDataType.BOOLEAN:
+            values = [value != 0 for value in values]
+        return [value if bits & mask else None \
+                for (value, bits) in zip(values, present)]
+
+    def _get_column_values(self, value_format, offset):
+        """Unpacks the value at the given offset of each record"""
+
+        record_format = struct.Struct(self._byte_order + "{}x{}{}x".format( \
+            offset, value_format, \
+            self._slot_size - offset - struct.calcsize(value_format)))
+        return [values[0] for (start, end) in self._get_ranges() \
+                for values in record_format.iter_unpack(self._data[start:end])]
+
+    def _get_ranges(self):
+        """Returns the (start, end) tuples of consecutive records in order
+
+        The function requires records of fixed size.
+        """
+
+        if not self._ring:
+            return [(self._data_offset, \
+                     self._data_offset + len(self) * self._record_size)]
+
+        # The oldest record may be located anywhere in the ring
+        (first, length) = self._get_window()
+        first %= self._capacity
+        wrapped = max(0, first + length - self._capacity)
+        ranges = [(self._get_slot(first), self._get_slot(first + length - \
+            wrapped))]
+        if wrapped > 0:
+            ranges.append((self._get_slot(0), self._get_slot(wrapped)))
+        return ranges
+
+    def _get_slot(self, index):
+        """Returns the position of the given slot of the ring"""
+
+        return self._data_offset + index * self._slot_size
+
+    def _generate_events(self):
+        """Generates the sequence of events until all events are consumed"""
+
+        if self._ring:
+            return self._generate_ring_events()
+        return self._generate_file_events()
+
+    def _generate_ring_events(self):
+        """Generates the events which are held by the ring"""
+
+        (first, length) = self._get_window()
+        for number in range(first, first + length):
+            pos = self._get_slot(number % self._capacity)
+            (event, strings) = self._parse_record(pos)
+
+            for (name, index, string_length) in strings:
+                start = pos + self._record_size + index * self._string_size
+                event[name] = bytes(self._data[start:start + string_length]) \
+                    .decode()
+
+            yield event
+
+    def _generate_file_events(self):
+        """Generates the events of a binary data file"""
+
+        pos = self._data_offset
+        while pos < len(self._data):
+            if pos + self._record_size > len(self._data):
+                raise ValueError("Truncated record at offset {}".format(pos))
+            (event, strings) = self._parse_record(pos)
+            pos += self._record_size
+
+            for (name, _, length) in strings:
+                if pos + length > len(self._data):
+                    raise ValueError("Truncated string at offset {}" \
+                        .format(pos))
+                event[name] = bytes(self._data[pos:pos + length]).decode()
+                pos += length
+
+            yield event
+
+    def _parse_record(self, pos):
+        """Parses the record at the given position and returns the event
+
+        String values are not added to the event. Instead, the list of
+        (variable name, string column index, string length) tuples is returned
+        in a tuple together with the event.
+        """
+
+        event = Event(self._unpack("d", pos)[0])
+        strings = []
+        string_index = 0
+
+        for i in range(0, len(self._name_list)):
+            vartype = self._type_list[i]
+            if self._data[pos + 8 + i // 8] & (1 << (i % 8)) == 0:
+                if vartype == SimulationDataType.STRING:
+                    string_index += 1
+                continue # Ignore unpopulated model variables
+
+            value = self._unpack(self._VALUE_FORMATS[vartype], \
+                pos + self._offsets[i])[0]
+            if vartype == SimulationDataType.BOOLEAN:
+                event[self._name_list[i]] = (value != 0)
+            elif vartype == SimulationDataType.STRING:
+                strings.append((self._name_list[i], string_index, value))
+                string_index += 1
+            else:
+                event[self._name_list[i]] = value
+
+        return (event, strings)
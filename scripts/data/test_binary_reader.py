@@ -0,0 +1,150 @@
+import unittest
+import struct
+from data.binary_reader import BinaryReader
+from data.simulation_data_type import SimulationDataType
+
+def make_header(columns, record_size, byte_order="<", control=b""):
+    """Returns the schema header of the given (type, offset, name) columns
+
+    The control block of a ring file is inserted in front of the column list if
+    it is given.
+    """
+
+    column_data = control
+    for (fmi_type, offset, name) in columns:
+        column_data += struct.pack(byte_order + "IIII", fmi_type, 0, offset, \
+            len(name)) + name.encode()
+    column_data += b"\0" * (-len(column_data) % 8)
+    magic = b"FMITBRNG" if control else b"FMITBDAT"
+    return magic + struct.pack(byte_order + "IIIIII", 0x01020304, 1, \
+        len(columns), record_size, 32 + len(column_data), 0) + column_data
+
+class TestBinaryReader(unittest.TestCase):
+
+    def test_minimal_file(self):
+        """Test a valid input file without any event"""
+
+        file_reader = BinaryReader(make_header([], 16))
+
+        self.assertEqual(len(file_reader.get_header()), 0)
+        self.assertEqual(len(file_reader), 0)
+        it = iter(file_reader)
+        self.assertRaises(StopIteration, next, it)
+
+    def test_all_data_types(self):
+        """Tests a file which contains all data types"""
+
+        columns = [(0, 16, "a"), (1, 24, "b"), (2, 28, "c"), (3, 32, "d")]
+        data = make_header(columns, 40)
+        data += struct.pack("<dBxxxxxxxdiBxxxIxxxx", 0.0, 0x05, 0.2, 0, 1, 0)
+        data += struct.pack("<dBxxxxxxxdiBxxxIxxxx", 0.1, 0x0A, 0.0, 42, 0, 3)
+        data += b"h;i"
+
+        file_reader = BinaryReader(data)
+
+        reference_header = {"a":SimulationDataType.REAL, \
+                            "b":SimulationDataType.INTEGER, \
+                            "c":SimulationDataType.BOOLEAN, \
+                            "d":SimulationDataType.STRING}
+        self.assertDictEqual(file_reader.get_header(), reference_header)
+
+        it = iter(file_reader)
+        event = next(it)
+        self.assertEqual(event.get_time(), 0.0)
+        self.assertEqual(len(event), 2)
+        self.assertEqual(event["a"], 0.2)
+        self.assertEqual(event["c"], True)
+
+        event = next(it)
+        self.assertEqual(event.get_time(), 0.1)
+        self.assertEqual(len(event), 2)
+        self.assertEqual(event["b"], 42)
+        self.assertEqual(event["d"], "h;i")
+
+        self.assertRaises(StopIteration, next, it)
+        self.assertRaises(TypeError, len, file_reader)
+
+    def test_columns(self):
+        """Tests the column accessors of fixed size records"""
+
+        columns = [(0, 16, "a"), (2, 24, "b")]
+        data = make_header(columns, 32, ">")
+        data += struct.pack(">dBxxxxxxxdBxxxxxxx", 0.0, 0x03, 0.5, 0)
+        data += struct.pack(">dBxxxxxxxdBxxxxxxx", 1.0, 0x02, 0.0, 1)
+
+        file_reader = BinaryReader(data)
+
+        self.assertEqual(len(file_reader), 2)
+        self.assertEqual(file_reader.get_times(), [0.0, 1.0])
+        self.assertEqual(file_reader.get_column("a"), [0.5, None])
+        self.assertEqual(file_reader.get_column("b"), [False, True])
+        self.assertRaises(ValueError, file_reader.get_column, "c")
+
+    def test_ring(self):
+        """Tests a ring file which wrapped around
+
+        The oldest event is skipped since it may be partly overwritten.
+        """
+
+        columns = [(1, 16, "a"), (3, 20, "b")]
+        control = struct.pack("<QIIII", 5, 32, 3, 8, 0)
+        data = make_header(columns, 24, control=control)
+        data += struct.pack("<dBxxxxxxxiI8s", 3.0, 0x01, 3, 0, b"")
+        data += struct.pack("<dBxxxxxxxiI8s", 4.0, 0x03, 4, 2, b"hi")
+        data += struct.pack("<dBxxxxxxxiI8s", 2.0, 0x02, 0, 8, b"abcdefgh")
+
+        file_reader = BinaryReader(data)
+
+        reference_header = {"a":SimulationDataType.INTEGER, \
+                            "b":SimulationDataType.STRING}
+        self.assertDictEqual(file_reader.get_header(), reference_header)
+        self.assertEqual(len(file_reader), 2)
+        self.assertEqual(file_reader.get_times(), [3.0, 4.0])
+        self.assertEqual(file_reader.get_column("a"), [3, 4])
+        self.assertEqual(file_reader.get_column("b"), [None, "hi"])
+
+        events = list(file_reader)
+        self.assertEqual(len(events), 2)
+        self.assertEqual(events[0].get_time(), 3.0)
+        self.assertDictEqual(dict(events[0]), {"a":3})
+        self.assertDictEqual(dict(events[1]), {"a":4, "b":"hi"})
+
+    def test_partial_ring(self):
+        """Tests a ring file which is not full"""
+
+        control = struct.pack("<QIIII", 1, 24, 3, 8, 0)
+        data = make_header([(0, 16, "x")], 24, control=control)
+        data += struct.pack("<dBxxxxxxxd", 1.5, 0x01, -1.0)
+        data += b"\0" * 48
+
+        file_reader = BinaryReader(data)
+
+        self.assertEqual(len(file_reader), 1)
+        self.assertEqual(file_reader.get_column("x"), [-1.0])
+        self.assertEqual([event.get_time() for event in file_reader], [1.5])
+
+    def test_invalid_magic(self):
+        """Test a file which does not start with the magic number"""
+
+        data = b"FMITBDAX" + make_header([], 16)[8:]
+        self.assertRaises(ValueError, BinaryReader, data)
+
+    def test_invalid_version(self):
+        """Test a file of an unsupported format version"""
+
+        data = bytearray(make_header([], 16))
+        struct.pack_into("<I", data, 12, 2)
+        self.assertRaises(ValueError, BinaryReader, data)
+
+    def test_truncated_record(self):
+        """Test a file which ends within a record"""
+
+        data = make_header([(1, 16, "x")], 24) + struct.pack("<dB", 0.0, 1)
+        file_reader = BinaryReader(data)
+
+        it = iter(file_reader)
+        self.assertRaises(ValueError, next, it)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -64,6 +64,9 @@ class Reader:
                 pre = action == '1'
                 self._add_new_event(open_events, duplicates, t_sim, t_real, pre)
                 
+            elif action == '5' and t_sim in open_events: # Released by the queue
+                open_events[t_sim].set_release_time(t_real)
+                
             elif action == '3' and t_sim in open_events: # Begin distribution
                 open_events[t_sim].set_begin_distribution_time(t_real)
                 
@@ -94,7 +97,8 @@ class Reader:
         t_real = float(row[6])
         action = row[5]
         
-        if action not in ['0', '1', '2', '3', '4']:
+        # Stages 6 to 8 are recorded by asynchronous channels and are ignored
+        if action not in ['0', '1', '2', '3', '4', '5', '6', '7', '8']:
             raise ValueError("Invalid processing stage code '{}' found at "\
                     "{} for simulation time {}".format(action, t_real, t_sim))
         
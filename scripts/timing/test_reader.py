@@ -31,6 +31,41 @@ class TestReader(unittest.TestCase):
         
         self.assertRaises(StopIteration, next, it)
     
+    def test_released_event(self):
+        """Test the timing trace of an event which records its release"""
+        
+        raw = ['-;-;-;-;0.3;1;0.1;', \
+               '-;-;-;-;0.3;5;0.31;', \
+               '-;-;-;-;0.3;3;0.32;', \
+               '-;-;-;-;0.3;2;0.33;']
+        reader = Reader(raw)
+        it = iter(reader)
+        
+        entry = next(it)
+        self.assertEqual(entry.get_release_time(), 0.31)
+        self.assertAlmostEqual(entry.get_release_delay(), 0.01)
+        self.assertEqual(entry.get_begin_distribution_time(), 0.32)
+        
+        self.assertRaises(StopIteration, next, it)
+    
+    def test_asynchronous_channel_stages(self):
+        """Test that the stages of asynchronous channels are ignored"""
+        
+        raw = ['-;-;-;-;0.3;1;0.1;', \
+               '-;-;-;-;0.3;3;0.32;', \
+               '-;-;-;-;0.3;6;0.33;', \
+               '-;-;-;-;0.3;2;0.34;', \
+               '-;-;-;-;0.3;7;0.35;', \
+               '-;-;-;-;0.3;8;0.36;']
+        reader = Reader(raw)
+        it = iter(reader)
+        
+        entry = next(it)
+        self.assertEqual(entry.get_begin_distribution_time(), 0.32)
+        self.assertEqual(entry.get_end_distribution_time(), 0.34)
+        
+        self.assertRaises(StopIteration, next, it)
+    
     def test_one_external_event_1(self):
         """Test the timing trace of a single external event"""
         
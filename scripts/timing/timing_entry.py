@@ -52,6 +52,21 @@ class TimingEntry:
         """
         return self._is_predicted
     
+    def set_release_time(self, release_time):
+        """Sets the timestamp when the event queue released the event
+        
+        The release time is not recorded by older versions of FMITerminalBlock.
+        """
+        self._release_time = release_time
+    
+    def get_release_time(self):
+        """Returns the time when the event was released by the event queue"""
+        return self._release_time
+    
+    def get_release_delay(self):
+        """Returns the lateness of the event's release"""
+        return self.get_release_time() - self.get_simulation_time()
+    
     def set_begin_distribution_time(self, begin_distribution_time):
         """Sets the timestamp when the distribution phase started
         """
@@ -210,6 +210,30 @@ ApplicationContext::getRealPositiveDoubleProperty(const std::string &path) const
 	return getRealPositiveDoubleProperty(path, 1.0);
 }
 
+int 
+ApplicationContext::getRealPositiveIntegerProperty(const std::string &path, int def) const
+{
+	assert(def > 0);
+
+	int ret = 0;
+
+	try
+	{
+		ret = getProperty<int>(path, def);
+	}catch(std::invalid_argument&){
+		throw Base::SystemConfigurationException("The Property is not an integer",
+			path,	getProperty<std::string>(path));
+	}
+
+	if(ret <= 0)
+	{
+		throw Base::SystemConfigurationException("Real positive value expected",
+			path,	getProperty<std::string>(path));
+	}
+
+	return ret;
+}
+
 const boost::property_tree::ptree & 
 ApplicationContext::getPropertyTree(const std::string &path) const
 {
@@ -0,0 +1,73 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file Deadband.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "base/Deadband.h"
+#include "base/BaseExceptions.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace FMITerminalBlock::Base;
+
+const std::string Deadband::PROP_ABSOLUTE = "deadband.absolute";
+const std::string Deadband::PROP_RELATIVE = "deadband.relative";
+
+Deadband::Deadband(const boost::property_tree::ptree &portConfig):
+	absolute_(getWidth(portConfig, PROP_ABSOLUTE)),
+	relative_(getWidth(portConfig, PROP_RELATIVE))
+{
+}
+
+bool
+Deadband::isSignificant(fmiReal reference, fmiReal value) const
+{
+	if (reference == value) return false;
+
+	fmiReal distance = std::fabs(value - reference);
+	fmiReal width = std::max(absolute_, relative_ * std::fabs(reference));
+	// Also passes NaN values
+	return !(distance <= width);
+}
+
+bool
+Deadband::isEnabled() const
+{
+	return absolute_ > 0.0 || relative_ > 0.0;
+}
+
+Deadband
+Deadband::getNarrowest(const Deadband &a, const Deadband &b)
+{
+	Deadband ret;
+	ret.absolute_ = std::min(a.absolute_, b.absolute_);
+	ret.relative_ = std::min(a.relative_, b.relative_);
+	return ret;
+}
+
+fmiReal
+Deadband::getWidth(const boost::property_tree::ptree &portConfig,
+	const std::string &key)
+{
+	fmiReal width = 0.0;
+	try
+	{
+		width = portConfig.get<fmiReal>(key, 0.0);
+	} catch (boost::property_tree::ptree_bad_data&) {
+		throw SystemConfigurationException("The deadband is not a floating "
+			"point number", key, portConfig.get<std::string>(key));
+	}
+
+	if (!(width >= 0.0))
+	{ // Also checks NaN
+		throw SystemConfigurationException("Non-negative deadband expected",
+			key, portConfig.get<std::string>(key));
+	}
+	return width;
+}
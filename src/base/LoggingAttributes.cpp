@@ -14,4 +14,6 @@ using namespace FMITerminalBlock;
 
 const char* Base::ATTR_EVENT_TIME = "EventTime";
 
-const char* Base::ATTR_TIMING_RECORD_TIME = "TimingRecordTime";
\ No newline at end of file
+const char* Base::ATTR_TIMING_RECORD_TIME = "TimingRecordTime";
+
+const char* Base::ATTR_TIMING_RECORD_TIMESTAMP = "TimingRecordTimeStamp";
\ No newline at end of file
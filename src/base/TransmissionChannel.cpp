@@ -9,14 +9,17 @@
  */
 
 #include "base/TransmissionChannel.h"
+#include "base/BaseExceptions.h"
 
-
+#include <assert.h>
+#include <boost/optional.hpp>
 
 using namespace FMITerminalBlock::Base;
 
 TransmissionChannel::TransmissionChannel(
 	const boost::property_tree::ptree &channelConfig):
-	channelConfig_(channelConfig)
+	channelConfig_(channelConfig), portIDs_(), portConfig_(), 
+	firstPortIndex_(), nextPortIndex_()
 {
 }
 
@@ -26,6 +29,30 @@ TransmissionChannel::getChannelConfig() const
 	return channelConfig_;
 }
 
+int 
+TransmissionChannel::getRealPositiveIntegerProperty(const std::string &path,
+	int def) const
+{
+	assert(def > 0);
+
+	boost::optional<std::string> value = 
+		channelConfig_.get_optional<std::string>(path);
+	if (!value) return def;
+
+	boost::optional<int> ret = channelConfig_.get_optional<int>(path);
+	if (!ret)
+	{
+		throw SystemConfigurationException("The Property is not an integer", 
+			path, value.get());
+	}
+	if (ret.get() <= 0)
+	{
+		throw SystemConfigurationException("Real positive value expected", path,
+			value.get());
+	}
+	return ret.get();
+}
+
 const std::vector<const boost::property_tree::ptree *> &
 TransmissionChannel::getPortConfig() const
 {
@@ -39,10 +66,51 @@ const std::vector<PortID> & TransmissionChannel::getPortIDs() const
 	return portIDs_;
 }
 
+int TransmissionChannel::getPortIndex(const PortID &id) const
+{
+	const unsigned int type = (unsigned int) id.first;
+	if (type >= firstPortIndex_.size() || id.second < 0 ||
+		((unsigned int) id.second) >= firstPortIndex_[type].size())
+	{
+		return -1;
+	}
+	return firstPortIndex_[type][id.second];
+}
+
+int TransmissionChannel::getNextPortIndex(int index) const
+{
+	assert(index >= 0);
+	assert(((unsigned int) index) < nextPortIndex_.size());
+	return nextPortIndex_[index];
+}
+
 void TransmissionChannel::pushBackPort(
 	PortID id, const boost::property_tree::ptree &portConfig)
 {
 	assert(portConfig_.size() == portIDs_.size());
+	assert(nextPortIndex_.size() == portIDs_.size());
+	assert(id.second >= 0);
+
+	const int index = (int) portIDs_.size();
 	portConfig_.push_back(&portConfig);
 	portIDs_.push_back(id);
+	nextPortIndex_.push_back(-1);
+
+	// Update the lookup table
+	const unsigned int type = (unsigned int) id.first;
+	if (type >= firstPortIndex_.size())
+	{
+		firstPortIndex_.resize(type + 1);
+	}
+	if (((unsigned int) id.second) >= firstPortIndex_[type].size())
+	{
+		firstPortIndex_[type].resize(id.second + 1, -1);
+	}
+
+	int * last = &firstPortIndex_[type][id.second];
+	while (*last >= 0)
+	{
+		last = &nextPortIndex_[*last];
+	}
+	*last = index;
 }
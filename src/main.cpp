@@ -14,6 +14,7 @@
 #include "base/environment-helper.h"
 
 #include <assert.h>
+#include <csignal>
 #include <stdexcept>
 #include <string>
 #include <boost/log/trivial.hpp>
@@ -31,11 +32,21 @@
 #include "model/EventPredictorFactory.h"
 #include "timing/EventDispatcher.h"
 #include "timing/EventLogger.h"
-#include "timing/CSVDataLogger.h"
+#include "timing/DataLoggerFactory.h"
+#include "timing/RingDataLogger.h"
 #include "network/NetworkManager.h"
 
 using namespace FMITerminalBlock;
 
+/**
+ * @brief Asks a ring data logger to dump the recorded events
+ * @param signal The number of the received signal
+ */
+static void requestDump(int)
+{
+	Timing::RingDataLogger::requestDump();
+}
+
 /**
  * @brief Initializes the program and starts the execution
  * @param argc The number of elements stored in argv
@@ -54,6 +65,7 @@ int main (int argc, const char *argv[])
 		<< "----------------";
 
 	Base::ApplicationContext context;
+	std::shared_ptr<Timing::EventListener> dataLogger;
 	try
 	{
 		// Initialize the application
@@ -71,8 +83,11 @@ int main (int argc, const char *argv[])
 		Timing::EventDispatcher dispatcher(context, *predictor);
 		Network::NetworkManager nwManager(context, dispatcher);
 		
-		Timing::CSVDataLogger dataLogger(context);
-		dispatcher.addEventListener(&dataLogger);
+		dataLogger = Timing::DataLoggerFactory::makeDataLogger(context);
+		dispatcher.addEventListener(dataLogger.get());
+#ifdef SIGUSR1
+		std::signal(SIGUSR1, requestDump);
+#endif
 
 		// Run the simulation
 		dispatcher.run();
@@ -92,6 +107,11 @@ int main (int argc, const char *argv[])
 		BOOST_LOG_TRIVIAL(fatal)
 			<< "An error during solving the model occurred: "
 			<< ex.what() << " (At time " << ex.getTimestamp() << ")"; 
+
+		// Preserve the events which led to the error
+		auto recorder = std::dynamic_pointer_cast<Timing::RingDataLogger>(
+			dataLogger);
+		if (recorder) recorder->dumpToFile();
 		return 4;
 	}catch(std::invalid_argument &ex){
 		BOOST_LOG_TRIVIAL(fatal) << "Invalid command line argument detected: " 
@@ -468,7 +468,7 @@ Timing::Event* EventPredictor::predictNextDirectDependency()
 	
 	std::vector<Timing::Variable> outVars;
 	fetchOutputs(outVars, currentTime_);
-	return new Timing::StaticEvent(currentTime_, outVars);
+	return new Timing::StaticEvent(currentTime_, std::move(outVars));
 }
 
 template<typename InputType>
@@ -479,7 +479,7 @@ bool EventPredictor::updateInputImage(std::vector<InputType> *destinationImage,
 	assert(ev != NULL);
 	assert(((unsigned int) type) < inputIDs_.size());
 
-	std::vector<Timing::Variable> vars = ev->getVariables();
+	const std::vector<Timing::Variable> &vars = ev->getVariables();
 	std::vector<Base::PortID> &ports = inputIDs_[type];
 	bool found = false;
 	for (auto varIt = vars.begin(); varIt != vars.end(); ++varIt)
@@ -489,7 +489,7 @@ bool EventPredictor::updateInputImage(std::vector<InputType> *destinationImage,
 			if (varIt->getID() == ports[i])
 			{
 				found = true;
-				(*destinationImage)[i] = boost::any_cast<InputType>(varIt->getValue());
+				(*destinationImage)[i] = varIt->getTypedValue<InputType>();
 			}
 		}
 	}
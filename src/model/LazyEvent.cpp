@@ -19,7 +19,7 @@ LazyEvent::LazyEvent(fmiTime time, EventPredictor &predictor):
 {
 }
 
-std::vector<Timing::Variable> 
+const std::vector<Timing::Variable> & 
 LazyEvent::getVariables(void)
 {
 	assert(predictor_.solver_ != NULL);
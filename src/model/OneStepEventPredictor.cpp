@@ -12,6 +12,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <algorithm>
 
 #include <boost/format.hpp>
 #include <boost/log/trivial.hpp>
@@ -20,6 +21,7 @@
 #include <import/base/include/FMUModelExchange_v2.h>
 
 #include "base/BaseExceptions.h"
+#include "base/Deadband.h"
 #include "model/SolverConfiguration.h"
 
 using namespace FMITerminalBlock;
@@ -28,6 +30,7 @@ using namespace FMITerminalBlock::Model;
 const std::string OneStepEventPredictor::PROP_FMU_INSTANCE_NAME = "fmu.instanceName";
 const std::string OneStepEventPredictor::PROP_DEFAULT_INPUT = Base::ApplicationContext::PROP_IN + ".default";
 const std::string OneStepEventPredictor::PROP_VARIABLE_STEP_SIZE = "app.variableStepSize";
+const std::string OneStepEventPredictor::PROP_EMIT_CHANGED_ONLY = "app.emitChangedOnly";
 
 OneStepEventPredictor::OneStepEventPredictor(
 	Base::ApplicationContext &appContext):
@@ -35,6 +38,7 @@ OneStepEventPredictor::OneStepEventPredictor(
 	outputRealImage_(), outputIntegerImage_(), outputBooleanImage_(), 
 	outputStringImage_(),
 	outputValueReference_(4, std::vector<fmiValueReference>()),
+	outputChanged_(4, std::vector<bool>()),
 	outputMapping_(NULL), 
 	inputValueReference_(0, Base::hashPortID), 
 	currentPrediction_(), fmu_()
@@ -70,6 +74,9 @@ OneStepEventPredictor::init()
 
 	initModel(start);
 	(void) updateOutputImage();
+
+	// The initial image must not be filtered
+	initOutputDeadbands();
 }
 
 Timing::Event * 
@@ -86,12 +93,13 @@ OneStepEventPredictor::predictNext()
 			currentPrediction_ = getOutputEvent();
 		} else {
 			// Set an empty event, nothing has changed significantly.
-			std::vector<Timing::Variable> emptyVector;
 			currentPrediction_ = std::unique_ptr<Timing::StaticEvent>(
-				new Timing::StaticEvent(fmu_->getTime(), emptyVector));
+				new Timing::StaticEvent(fmu_->getTime(), 
+					std::vector<Timing::Variable>()));
 		}
 	}
 
+	// Shares the variables of the current prediction without copying them
 	return new Timing::StaticEvent(*currentPrediction_);
 }
 
@@ -133,6 +141,15 @@ OneStepEventPredictor::initOutputStructures(
 	outputStringImage_.resize(
 		outputMapping_->getVariableIDs(fmiTypeString).size(), "");
 
+	// Initially, every output is considered to be changed
+	outputChanged_[fmiTypeReal].resize(outputRealImage_.size(), true);
+	outputChanged_[fmiTypeInteger].resize(outputIntegerImage_.size(), true);
+	outputChanged_[fmiTypeBoolean].resize(outputBooleanImage_.size(), true);
+	outputChanged_[fmiTypeString].resize(outputStringImage_.size(), true);
+
+	// Deadbands are set after fetching the initial outputs
+	outputRealDeadband_.resize(outputRealImage_.size(), Base::Deadband());
+
 	// Init output value reference
 	initOutputValueReferences(appContext, fmiTypeReal);
 	initOutputValueReferences(appContext, fmiTypeInteger);
@@ -168,6 +185,45 @@ OneStepEventPredictor::initOutputValueReferences(
 	}
 }
 
+void 
+OneStepEventPredictor::initOutputDeadbands()
+{
+	assert(outputMapping_);
+
+	const std::vector<Base::PortID> &ids = 
+		outputMapping_->getVariableIDs(fmiTypeReal);
+	assert(ids.size() == outputRealDeadband_.size());
+	std::vector<bool> configured(ids.size(), false);
+
+	for (int channel = 0; channel < outputMapping_->getNumberOfChannels(); 
+		channel++)
+	{
+		const Base::TransmissionChannel &transmissionChannel = 
+			outputMapping_->getTransmissionChannel(channel);
+		const std::vector<Base::PortID> &ports = transmissionChannel.getPortIDs();
+
+		for (unsigned int i = 0; i < ports.size(); i++)
+		{
+			if (ports[i].first != fmiTypeReal) continue;
+
+			auto it = std::find(ids.begin(), ids.end(), ports[i]);
+			assert(it != ids.end());
+			unsigned int index = (unsigned int) (it - ids.begin());
+
+			Base::Deadband deadband(*transmissionChannel.getPortConfig()[i]);
+			// A variable may be published by several ports. Any of them must 
+			// receive its significant changes.
+			if (configured[index])
+			{
+				deadband = Base::Deadband::getNarrowest(outputRealDeadband_[index],
+					deadband);
+			}
+			outputRealDeadband_[index] = deadband;
+			configured[index] = true;
+		}
+	}
+}
+
 void 
 OneStepEventPredictor::initInputValueReference(
 	const Base::ChannelMapping *inputMapping)
@@ -219,6 +275,9 @@ OneStepEventPredictor::initSimulationProperties(
 		appContext.getProperty<bool>(PROP_VARIABLE_STEP_SIZE, false);
 
 	simulationProperties_.timingPrecision = 1e-4;
+
+	simulationProperties_.emitChangedOnly = 
+		appContext.getProperty<bool>(PROP_EMIT_CHANGED_ONLY, false);
 }
 
 std::unique_ptr<FMUModelExchangeBase>
@@ -400,10 +459,12 @@ template<typename valType>
 bool 
 OneStepEventPredictor::updateOutputImage(
 	std::vector<valType> *destinationImage,
-	std::vector<fmiValueReference> &referenceVector)
+	std::vector<fmiValueReference> &referenceVector, std::vector<bool> *changed)
 {
 	assert(destinationImage);
+	assert(changed);
 	assert(referenceVector.size() == destinationImage->size());
+	assert(changed->size() == destinationImage->size());
 	assert(fmu_);
 
 	// Some FMUs issue a warning in case no output should be fetched
@@ -424,28 +485,45 @@ OneStepEventPredictor::updateOutputImage(
 	bool significantChange = false;
 	for (unsigned int i = 0; i < referenceVector.size(); i++)
 	{
-		if (destinationImage->operator[](i) != tmpVal[i])
+		if (isSignificantChange(i, destinationImage->operator[](i), tmpVal[i]))
 		{
 			significantChange = true;
+			changed->operator[](i) = true;
+			destinationImage->operator[](i) = tmpVal[i];
 		}
-		destinationImage->operator[](i) = tmpVal[i];
 	}
 	return significantChange;
 }
 
+template<typename valType>
+bool 
+OneStepEventPredictor::isSignificantChange(unsigned index, 
+	const valType &reference, const valType &value) const
+{
+	return reference != value;
+}
+
+bool 
+OneStepEventPredictor::isSignificantChange(unsigned index, fmiReal reference,
+	fmiReal value) const
+{
+	assert(index < outputRealDeadband_.size());
+	return outputRealDeadband_[index].isSignificant(reference, value);
+}
+
 bool 
 OneStepEventPredictor::updateOutputImage()
 {
 	bool significantChange = false;
 
 	significantChange |= updateOutputImage(&outputRealImage_, 
-		outputValueReference_[fmiTypeReal]);
+		outputValueReference_[fmiTypeReal], &outputChanged_[fmiTypeReal]);
 	significantChange |= updateOutputImage(&outputIntegerImage_, 
-		outputValueReference_[fmiTypeInteger]);
+		outputValueReference_[fmiTypeInteger], &outputChanged_[fmiTypeInteger]);
 	significantChange |= updateOutputImage(&outputBooleanImage_, 
-		outputValueReference_[fmiTypeBoolean]);
+		outputValueReference_[fmiTypeBoolean], &outputChanged_[fmiTypeBoolean]);
 	significantChange |= updateOutputImage(&outputStringImage_, 
-		outputValueReference_[fmiTypeString]);
+		outputValueReference_[fmiTypeString], &outputChanged_[fmiTypeString]);
 
 	return significantChange;
 }
@@ -460,16 +538,21 @@ OneStepEventPredictor::getOutputEvent()
 	vars.reserve(outputMapping_->getTotalNumberOfVariables());
 	
 	appendOutputVariables(&vars, outputMapping_->getVariableIDs(fmiTypeReal), 
-		outputRealImage_);
+		outputRealImage_, outputChanged_[fmiTypeReal]);
 	appendOutputVariables(&vars, outputMapping_->getVariableIDs(fmiTypeInteger), 
-		outputIntegerImage_);
+		outputIntegerImage_, outputChanged_[fmiTypeInteger]);
 	appendOutputVariables(&vars, outputMapping_->getVariableIDs(fmiTypeBoolean), 
-		outputBooleanImage_);
+		outputBooleanImage_, outputChanged_[fmiTypeBoolean]);
 	appendOutputVariables(&vars, outputMapping_->getVariableIDs(fmiTypeString), 
-		outputStringImage_);
+		outputStringImage_, outputChanged_[fmiTypeString]);
+
+	for (auto it = outputChanged_.begin(); it != outputChanged_.end(); ++it)
+	{
+		std::fill(it->begin(), it->end(), false);
+	}
 
 	return std::unique_ptr<Timing::StaticEvent>(
-		new Timing::StaticEvent(fmu_->getTime(), vars));
+		new Timing::StaticEvent(fmu_->getTime(), std::move(vars)));
 }
 
 template<typename valType>
@@ -477,14 +560,18 @@ void
 OneStepEventPredictor::appendOutputVariables(
 	std::vector<Timing::Variable> *destination,
 	const std::vector<Base::PortID> &ids,
-	const std::vector<valType> &values) const
+	const std::vector<valType> &values, const std::vector<bool> &changed) const
 {
 	assert(ids.size() == values.size());
+	assert(ids.size() == changed.size());
 	assert(destination);
 
 	for (unsigned int i = 0; i < ids.size(); i++)
 	{
-		destination->push_back(Timing::Variable(ids[i], values[i]));
+		if (!simulationProperties_.emitChangedOnly || changed[i])
+		{
+			destination->push_back(Timing::Variable(ids[i], values[i]));
+		}
 	}
 }
 
@@ -494,7 +581,7 @@ OneStepEventPredictor::updateInputVariables(Timing::Event *ev)
 	assert(ev);
 	bool inputVariableSet = false;
 
-	auto vars = ev->getVariables();
+	const auto &vars = ev->getVariables();
 	for (auto it = vars.begin(); it != vars.end(); ++it)
 	{
 		inputVariableSet |= updateInputVariable(*it);
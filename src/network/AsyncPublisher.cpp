@@ -0,0 +1,258 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file AsyncPublisher.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "network/AsyncPublisher.h"
+
+#include "base/BaseExceptions.h"
+#include "timing/StaticEvent.h"
+
+#include <assert.h>
+#include <boost/format.hpp>
+#include <boost/log/trivial.hpp>
+
+using namespace FMITerminalBlock::Network;
+
+const std::string AsyncPublisher::PROP_ASYNC = "async";
+const std::string AsyncPublisher::PROP_QUEUE_SIZE = "queueSize";
+const std::string AsyncPublisher::PROP_OVERFLOW = "overflow";
+
+const char * AsyncPublisher::OVERFLOW_POLICY_NAMES[3] = {
+	"drop-oldest", "coalesce-latest", "block"
+};
+
+AsyncPublisher::AsyncPublisher(std::shared_ptr<Publisher> publisher,
+	std::function<void(std::exception_ptr)> errorCallback):
+	publisher_(publisher), errorCallback_(errorCallback), channel_(NULL),
+	queueSize_(DEFAULT_QUEUE_SIZE), overflowPolicy_(BLOCK), queue_(),
+	queueMutex_(), queueNotEmpty_(), queueNotFull_(), terminate_(false),
+	senderThread_(), eventLogger_(), mergeIndex_()
+{
+	assert(publisher_);
+	assert(errorCallback_);
+}
+
+AsyncPublisher::~AsyncPublisher()
+{
+	{
+		std::lock_guard<std::mutex> lock(queueMutex_);
+		terminate_ = true;
+	}
+	queueNotEmpty_.notify_all();
+	queueNotFull_.notify_all();
+
+	if (senderThread_.joinable())
+	{
+		senderThread_.join();
+	}
+
+	while (!queue_.empty())
+	{
+		dropEvent(queue_.front());
+		queue_.pop_front();
+	}
+}
+
+void
+AsyncPublisher::init(const Base::TransmissionChannel &channel)
+{
+	assert(!senderThread_.joinable());
+
+	initConfiguration(channel);
+	publisher_->init(channel);
+
+	senderThread_ = std::thread(&AsyncPublisher::run, this);
+}
+
+void
+AsyncPublisher::eventTriggered(Timing::Event * ev)
+{
+	assert(ev != NULL);
+	assert(senderThread_.joinable());
+
+	Timing::Event * copy = copyEvent(ev);
+	{
+		std::unique_lock<std::mutex> lock(queueMutex_);
+		if (queue_.size() >= queueSize_)
+		{
+			switch (overflowPolicy_)
+			{
+			case DROP_OLDEST:
+				dropEvent(queue_.front());
+				queue_.pop_front();
+				break;
+			case COALESCE_LATEST:
+			{
+				Timing::Event * merged = mergeEvents(queue_.back(), copy);
+				dropEvent(queue_.back());
+				queue_.pop_back();
+				delete copy;
+				copy = merged;
+				break;
+			}
+			case BLOCK:
+				queueNotFull_.wait(lock, [this]() {
+					return queue_.size() < queueSize_ || terminate_;
+				});
+				break;
+			default:
+				assert(false);
+			}
+		}
+		queue_.push_back(copy);
+		// The sender thread may delete the event as soon as the lock is released
+		eventLogger_.logEvent(copy, Timing::ProcessingStage::queuedForPublishing);
+	}
+	queueNotEmpty_.notify_one();
+}
+
+bool
+AsyncPublisher::isEnabled(const Base::TransmissionChannel &channel)
+{
+	const boost::property_tree::ptree &config = channel.getChannelConfig();
+	if (!config.get_optional<std::string>(PROP_ASYNC)) return false;
+	try
+	{
+		// The defaulted getter would silently ignore invalid values
+		return config.get<bool>(PROP_ASYNC);
+	} catch (boost::property_tree::ptree_bad_data&) {
+		throw Base::SystemConfigurationException("The flag is not a boolean value",
+			PROP_ASYNC, config.get<std::string>(PROP_ASYNC));
+	}
+}
+
+void
+AsyncPublisher::initConfiguration(const Base::TransmissionChannel &channel)
+{
+	channel_ = &channel;
+	mergeIndex_.assign(channel.getPortIDs().size(), -1);
+
+	const boost::property_tree::ptree &config = channel.getChannelConfig();
+
+	queueSize_ = (size_t) channel.getRealPositiveIntegerProperty(PROP_QUEUE_SIZE,
+		(int) DEFAULT_QUEUE_SIZE);
+
+	std::string policy = config.get<std::string>(PROP_OVERFLOW,
+		OVERFLOW_POLICY_NAMES[BLOCK]);
+	bool found = false;
+	for (unsigned i = 0; i < 3; i++)
+	{
+		if (policy == OVERFLOW_POLICY_NAMES[i])
+		{
+			overflowPolicy_ = (OverflowPolicy) i;
+			found = true;
+		}
+	}
+	if (!found)
+	{
+		throw Base::SystemConfigurationException("Unknown overflow policy",
+			PROP_OVERFLOW, policy);
+	}
+}
+
+void
+AsyncPublisher::run()
+{
+	std::unique_lock<std::mutex> lock(queueMutex_);
+	while (!terminate_)
+	{
+		if (queue_.empty())
+		{
+			queueNotEmpty_.wait(lock);
+			continue;
+		}
+
+		Timing::Event * ev = queue_.front();
+		queue_.pop_front();
+		lock.unlock();
+		queueNotFull_.notify_one();
+
+		try
+		{
+			publisher_->eventTriggered(ev);
+			eventLogger_.logEvent(ev, Timing::ProcessingStage::published);
+		} catch (...) {
+			BOOST_LOG_TRIVIAL(error) << "The asynchronous publisher could not "
+				"publish event " << ev->toString();
+			errorCallback_(std::current_exception());
+		}
+		delete ev;
+
+		lock.lock();
+	}
+}
+
+FMITerminalBlock::Timing::Event *
+AsyncPublisher::copyEvent(Timing::Event * ev)
+{
+	assert(ev != NULL);
+
+	Timing::StaticEvent * staticEvent = dynamic_cast<Timing::StaticEvent *>(ev);
+	if (staticEvent != NULL)
+	{
+		return new Timing::StaticEvent(*staticEvent);
+	}
+	return new Timing::StaticEvent(ev->getTime(), ev->getVariables());
+}
+
+FMITerminalBlock::Timing::Event *
+AsyncPublisher::mergeEvents(Timing::Event * older, Timing::Event * newer)
+{
+	assert(older != NULL);
+	assert(newer != NULL);
+	assert(channel_ != NULL);
+
+	std::vector<Timing::Variable> merged;
+	merged.reserve(mergeIndex_.size());
+
+	const std::vector<Timing::Variable> &olderVars = older->getVariables();
+	for (auto it = olderVars.begin(); it != olderVars.end(); ++it)
+	{
+		mergeVariable(&merged, *it);
+	}
+	const std::vector<Timing::Variable> &newerVars = newer->getVariables();
+	for (auto it = newerVars.begin(); it != newerVars.end(); ++it)
+	{
+		mergeVariable(&merged, *it);
+	}
+
+	// Reset the temporary index
+	for (auto it = merged.begin(); it != merged.end(); ++it)
+	{
+		mergeIndex_[channel_->getPortIndex(it->getID())] = -1;
+	}
+
+	return new Timing::StaticEvent(newer->getTime(), std::move(merged));
+}
+
+void
+AsyncPublisher::mergeVariable(std::vector<Timing::Variable> * merged,
+	const Timing::Variable &var)
+{
+	assert(merged != NULL);
+
+	int portIndex = channel_->getPortIndex(var.getID());
+	if (portIndex < 0) return;
+
+	if (mergeIndex_[portIndex] < 0)
+	{
+		mergeIndex_[portIndex] = (int) merged->size();
+		merged->push_back(var);
+	} else {
+		(*merged)[mergeIndex_[portIndex]] = var;
+	}
+}
+
+void
+AsyncPublisher::dropEvent(Timing::Event * ev)
+{
+	assert(ev != NULL);
+	eventLogger_.logEvent(ev, Timing::ProcessingStage::droppedByPublisher);
+	delete ev;
+}
@@ -14,6 +14,7 @@
 #include <assert.h>
 #include <boost/asio.hpp>
 #include <boost/format.hpp>
+#include <boost/predef/other/endian.h>
 #include <string.h>
 
 using namespace FMITerminalBlock::Network;
@@ -29,15 +30,20 @@ const bool CompactASN1Publisher::CASTABLE[5][ASN1Commons::DATA_TYPE_SIZE] = {
 	{false, false, false, false, false} // fmiTypeUnknown
 };
 
-CompactASN1Publisher::CompactASN1Publisher(): outputVariables_(), outputTypes_()
+CompactASN1Publisher::CompactASN1Publisher(): outputVariables_(), outputTypes_(),
+	outputDeadbands_(), outputPublished_(), channel_(NULL), frame_(), 
+	frameOffsets_(), fixedFrameLayout_(false)
 {
 
 }
 
 void CompactASN1Publisher::init(const Base::TransmissionChannel &channel)
 {
+	channel_ = &channel;
 	initOutputVariables(channel.getPortIDs());
 	initOutputTypes(channel);
+	initOutputDeadbands(channel);
+	initFrame();
 }
 
 void CompactASN1Publisher::eventTriggered(Timing::Event * ev)
@@ -47,9 +53,13 @@ void CompactASN1Publisher::eventTriggered(Timing::Event * ev)
 	bool updated = updateOutputVariables(ev);
 	if (updated)
 	{
-		std::vector<uint8_t> buffer;
-		encodeASN1OutputVariables(buffer);
-		sendData(buffer);
+		if (!fixedFrameLayout_)
+		{
+			// Keeps the capacity of the previous frame
+			frame_.clear();
+			encodeASN1OutputVariables(frame_);
+		}
+		sendData(frame_);
 	}
 }
 
@@ -74,6 +84,7 @@ CompactASN1Publisher::initOutputVariables(
 	const std::vector<Base::PortID> & ports)
 {
 	outputVariables_.clear();
+	outputPublished_.assign(ports.size(), false);
 
 	for(unsigned i = 0; i < ports.size(); i++)
 	{
@@ -145,6 +156,72 @@ CompactASN1Publisher::initOutputTypes(const Base::TransmissionChannel &channel)
 	}
 }
 
+void 
+CompactASN1Publisher::initOutputDeadbands(
+	const Base::TransmissionChannel &channel)
+{
+	const std::vector<Base::PortID> &ports = channel.getPortIDs();
+	for(unsigned i = 0; i < ports.size(); i++)
+	{
+		Base::Deadband deadband(*channel.getPortConfig()[i]);
+
+		if(deadband.isEnabled() && ports[i].first != fmiTypeReal)
+		{
+			boost::format err("A deadband is configured at the ASN.1 publisher port "
+				"%1% which is not real-valued (fmiType %2%)");
+			err % i % ports[i].first;
+			throw Base::SystemConfigurationException(err.str());
+		}
+
+		outputDeadbands_.push_back(deadband);
+	}
+}
+
+void 
+CompactASN1Publisher::initFrame()
+{
+	assert(outputVariables_.size() == outputTypes_.size());
+
+	frame_.clear();
+	frameOffsets_.clear();
+	fixedFrameLayout_ = true;
+	for(unsigned i = 0; i < outputVariables_.size(); i++)
+	{
+		frameOffsets_.push_back(frame_.size());
+		encodeOutputVariable(frame_, i);
+		fixedFrameLayout_ &= getEncodedSize(outputTypes_[i]) > 0;
+	}
+}
+
+void 
+CompactASN1Publisher::patchFrame(unsigned index)
+{
+	assert(fixedFrameLayout_);
+	assert(index < frameOffsets_.size());
+	assert(frameOffsets_[index] + getEncodedSize(outputTypes_[index]) <= 
+		frame_.size());
+
+	encodeOutputVariable(&frame_[frameOffsets_[index]], index);
+}
+
+size_t 
+CompactASN1Publisher::getEncodedSize(ASN1Commons::DataType type)
+{
+	switch(type)
+	{
+	case ASN1Commons::DataType::LREAL:
+		return 1 + sizeof(uint64_t);
+	case ASN1Commons::DataType::REAL:
+		return 1 + sizeof(uint32_t);
+	case ASN1Commons::DataType::DINT:
+		return 1 + sizeof(fmiInteger);
+	case ASN1Commons::DataType::BOOL:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
 ASN1Commons::DataType 
 CompactASN1Publisher::getDefaultType(FMIVariableType srcType)
 {
@@ -174,18 +251,30 @@ bool
 CompactASN1Publisher::updateOutputVariables(Timing::Event * ev)
 {
 	assert(ev != NULL);
+	assert(channel_ != NULL);
+	assert(outputVariables_.size() == outputDeadbands_.size());
 	bool updated = false;
-	std::vector<Timing::Variable> vars = ev->getVariables();
+	const std::vector<Timing::Variable> &vars = ev->getVariables();
 	for(unsigned i = 0; i < vars.size(); i++)
 	{
-		for(unsigned j = 0; j < outputVariables_.size(); j++)
+		for(int j = channel_->getPortIndex(vars[i].getID()); j >= 0; 
+			j = channel_->getNextPortIndex(j))
 		{
-			if(vars[i].getID() == outputVariables_[j].getID())
+			assert(vars[i].getID() == outputVariables_[j].getID());
+
+			// Keep the last published value as long as the change is negligible
+			if(outputPublished_[j] && outputDeadbands_[j].isEnabled() && 
+				!outputDeadbands_[j].isSignificant(
+					outputVariables_[j].getRealValue(), vars[i].getRealValue()))
 			{
-				// Update
-				outputVariables_[j].setValue(vars[i].getValue());
-				updated = true;
+				continue;
 			}
+
+			// Update
+			outputVariables_[j] = vars[i];
+			outputPublished_[j] = true;
+			if(fixedFrameLayout_) patchFrame(j);
+			updated = true;
 		}
 	}
 	return updated;
@@ -198,83 +287,94 @@ CompactASN1Publisher::encodeASN1OutputVariables(std::vector<uint8_t> &buffer)
 
 	for(unsigned i = 0; i < outputVariables_.size(); i++)
 	{
+		encodeOutputVariable(buffer, i);
+	}
+}
 
-		switch(outputTypes_[i])
-		{
-		case ASN1Commons::DataType::LREAL:
-			encodeLREALValue(buffer,outputVariables_[i].getRealValue());
-			break;
-		case ASN1Commons::DataType::REAL:
-			encodeREALValue(buffer, outputVariables_[i].getRealValue());
-			break;
-		case ASN1Commons::DataType::DINT:
-			encodeValue(buffer, outputVariables_[i].getIntegerValue());
-			break;
-		case ASN1Commons::DataType::BOOL:
-			encodeValue(buffer, outputVariables_[i].getBooleanValue());
-			break;
-		case ASN1Commons::DataType::STRING:
-			encodeValue(buffer, outputVariables_[i].getStringValue());
-			break;
-		default:
-			assert(0);
-		}
+void 
+CompactASN1Publisher::encodeOutputVariable(std::vector<uint8_t> &buffer, 
+	unsigned index)
+{
+	assert(index < outputTypes_.size());
 
+	if(outputTypes_[index] == ASN1Commons::DataType::STRING)
+	{
+		encodeValue(buffer, outputVariables_[index].getStringValue());
+	} else {
+		size_t offset = buffer.size();
+		buffer.resize(offset + getEncodedSize(outputTypes_[index]));
+		encodeOutputVariable(&buffer[offset], index);
 	}
+}
 
+void 
+CompactASN1Publisher::encodeOutputVariable(uint8_t * dest, unsigned index)
+{
+	assert(index < outputTypes_.size());
+	assert(dest != NULL);
+
+	switch(outputTypes_[index])
+	{
+	case ASN1Commons::DataType::LREAL:
+		encodeLREALValue(dest, outputVariables_[index].getRealValue());
+		break;
+	case ASN1Commons::DataType::REAL:
+		encodeREALValue(dest, outputVariables_[index].getRealValue());
+		break;
+	case ASN1Commons::DataType::DINT:
+		encodeValue(dest, outputVariables_[index].getIntegerValue());
+		break;
+	case ASN1Commons::DataType::BOOL:
+		encodeValue(dest, outputVariables_[index].getBooleanValue());
+		break;
+	default:
+		assert(0);
+	}
 }
 
 void
-CompactASN1Publisher::encodeLREALValue(std::vector<uint8_t> &buffer, fmiReal value)
+CompactASN1Publisher::encodeLREALValue(uint8_t * dest, fmiReal value)
 {
-	// Append tag encoding
-	buffer.push_back(ASN1Commons::CLASS_APPLICATION | ASN1Commons::LREAL_TAG_NR);
+	// Tag encoding
+	dest[0] = ASN1Commons::CLASS_APPLICATION | ASN1Commons::LREAL_TAG_NR;
 
-	// Append value, lsb first
+	// Value, msb first
 	uint64_t val = 0;
 	memcpy(&val, &value, sizeof(value));
-
-	for(int i = sizeof(val) - 1; i >= 0; i--)
-		buffer.push_back((uint8_t) ((val >> (8*i)) & 0xFF) );
+	storeBigEndian(dest + 1, val);
 }
 
 void
-CompactASN1Publisher::encodeREALValue(std::vector<uint8_t> &buffer, fmiReal value)
+CompactASN1Publisher::encodeREALValue(uint8_t * dest, fmiReal value)
 {
-	// Append tag encoding
-	buffer.push_back(ASN1Commons::CLASS_APPLICATION | ASN1Commons::REAL_TAG_NR);
+	// Tag encoding
+	dest[0] = ASN1Commons::CLASS_APPLICATION | ASN1Commons::REAL_TAG_NR;
 
-	// Append value, lsb first
+	// Value, msb first
 	uint32_t val = 0;
 	float tmpVal = (float) value; // Convert to 32Bit floating point number
-	memcpy(&val, &tmpVal, sizeof(value));
-
-	for(int i = sizeof(val) - 1; i >= 0; i--)
-		buffer.push_back((uint8_t) ((val >> (8*i)) & 0xFF) );
+	memcpy(&val, &tmpVal, sizeof(tmpVal));
+	storeBigEndian(dest + 1, val);
 }
 
 
 void
-CompactASN1Publisher::encodeValue(std::vector<uint8_t> &buffer, fmiInteger value)
+CompactASN1Publisher::encodeValue(uint8_t * dest, fmiInteger value)
 {
-	// Append tag encoding
-	buffer.push_back(ASN1Commons::CLASS_APPLICATION | ASN1Commons::DINT_TAG_NR);
-
-	for(int i = sizeof(value) - 1; i >= 0; i--)
-		buffer.push_back((uint8_t) ((value >> (8*i)) & 0xFF) );
+	// Tag encoding
+	dest[0] = ASN1Commons::CLASS_APPLICATION | ASN1Commons::DINT_TAG_NR;
+	storeBigEndian(dest + 1, (uint32_t) value);
 }
 
 void
-CompactASN1Publisher::encodeValue(std::vector<uint8_t> &buffer, fmiBoolean value)
+CompactASN1Publisher::encodeValue(uint8_t * dest, fmiBoolean value)
 {
-
 	if(value)
 	{
-		buffer.push_back(ASN1Commons::CLASS_APPLICATION | ASN1Commons::BOOL1_TAG_NR);
+		dest[0] = ASN1Commons::CLASS_APPLICATION | ASN1Commons::BOOL1_TAG_NR;
 	}else{
-		buffer.push_back(ASN1Commons::CLASS_APPLICATION | ASN1Commons::BOOL0_TAG_NR);
+		dest[0] = ASN1Commons::CLASS_APPLICATION | ASN1Commons::BOOL0_TAG_NR;
 	}
-
 }
 
 void
@@ -288,6 +388,31 @@ CompactASN1Publisher::encodeValue(std::vector<uint8_t> &buffer, const std::strin
 	buffer.push_back((uint8_t) (size >> 8) & 0xFF);
 	buffer.push_back((uint8_t) size & 0xFF);
 
-	for(unsigned i = 0; i < size; i++)
-		buffer.push_back((uint8_t) value[i]);
+	buffer.insert(buffer.end(), value.begin(), value.begin() + size);
+}
+
+template<typename IntType>
+void
+CompactASN1Publisher::storeBigEndian(uint8_t * dest, IntType value)
+{
+#if BOOST_ENDIAN_LITTLE_BYTE
+	value = swapBytes(value);
+#elif !BOOST_ENDIAN_BIG_BYTE
+#error "The byte order of the host is not supported"
+#endif
+	memcpy(dest, &value, sizeof(value));
+}
+
+uint32_t
+CompactASN1Publisher::swapBytes(uint32_t value)
+{
+	return (value >> 24) | ((value >> 8) & 0x0000FF00u) |
+		((value << 8) & 0x00FF0000u) | (value << 24);
+}
+
+uint64_t
+CompactASN1Publisher::swapBytes(uint64_t value)
+{
+	return ((uint64_t) swapBytes((uint32_t) value) << 32) |
+		swapBytes((uint32_t) (value >> 32));
 }
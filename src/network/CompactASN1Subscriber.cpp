@@ -11,6 +11,7 @@
 #include "network/CompactASN1Subscriber.h"
 
 #include <assert.h>
+#include <cstring>
 
 #include <boost/asio.hpp>
 #include <boost/endian/conversion.hpp>
@@ -25,8 +26,13 @@ using namespace FMITerminalBlock::Network;
 using namespace FMITerminalBlock;
 
 const std::string CompactASN1Subscriber::PROP_PACKET_TIMEOUT = "packetTimeout";
+const std::string CompactASN1Subscriber::PROP_RECEIVE_BATCH = "receiveBatch";
 
-CompactASN1Subscriber::CompactASN1Subscriber(): channelConfig_(NULL)
+CompactASN1Subscriber::CompactASN1Subscriber(size_t defaultReceiveBatch): 
+	channelConfig_(NULL), remainingFrameSize_(), 
+	receiveBatch_(defaultReceiveBatch), datagramReceived_(), fixedLayout_(),
+	ioPool_(), strand_(), packetTimeout_(boost::posix_time::milliseconds(500)), defaultState_(), 
+	state_()
 {
 }
 
@@ -42,16 +48,20 @@ void CompactASN1Subscriber::init(const Base::TransmissionChannel &settings,
 			" associated ports");
 	}
 
-	clearUnprocessedData();
+	initFrameSizes();
+	initFixedLayout();
 
 	busyKeeper_ = std::unique_ptr<boost::asio::io_service::work>(
 			new boost::asio::io_service::work(service_));
+	strand_.reset(new ChannelStrand(*getIOService()));
 
 	// Initialize the timer
 	uint32_t packetTimeout;
 	packetTimeout = settings.getChannelConfig().get(PROP_PACKET_TIMEOUT, 500);
-	packetTimeoutTimer_= std::make_shared<boost::asio::deadline_timer>(service_, 
-		boost::posix_time::milliseconds(packetTimeout));
+	packetTimeout_ = boost::posix_time::milliseconds(packetTimeout);
+
+	defaultState_ = createFrameState();
+	selectFrameState(defaultState_);
 
 	initNetwork();
 }
@@ -63,12 +73,36 @@ void CompactASN1Subscriber::run()
 
 void CompactASN1Subscriber::terminationRequest()
 {
-	service_.post(boost::bind(&CompactASN1Subscriber::handleTermination, this));
+	assert(strand_);
+	strand_->post(boost::bind(&CompactASN1Subscriber::handleTermination, this));
+	if (ioPool_)
+	{
+		// Closing the connections completes all pending handlers
+		strand_->waitUntilIdle();
+	}
+}
+
+bool CompactASN1Subscriber::requiresThread() const
+{
+	return !ioPool_;
+}
+
+void CompactASN1Subscriber::setIOServicePool(
+	std::shared_ptr<IOServicePool> pool)
+{
+	assert(!strand_);
+	ioPool_ = pool;
 }
 
 boost::asio::io_service* CompactASN1Subscriber::getIOService()
 {
-	return &service_;
+	return ioPool_ ? &ioPool_->getIOService() : &service_;
+}
+
+ChannelStrand* CompactASN1Subscriber::getStrand()
+{
+	assert(strand_);
+	return strand_.get();
 }
 
 const Base::TransmissionChannel* 
@@ -81,21 +115,31 @@ CompactASN1Subscriber::getChannelConfiguration() const
 boost::asio::streambuf::mutable_buffers_type 
 CompactASN1Subscriber::prepareData()
 {
-	// TODO: Estimate the size of the next or remaining packet and return the 
-	//       buffer accordingly (#381)
-	return remainingRawData_.prepare(128);
+	size_t size = getRemainingFrameSize();
+	size += (receiveBatch_ - 1) * remainingFrameSize_.front();
+	return state_->rawData.prepare(size);
 }
 
 void CompactASN1Subscriber::commitData(size_t actualSize)
 {
 	restartPacketTimer();
-	remainingRawData_.commit(actualSize);
+	state_->rawData.commit(actualSize);
+	state_->missingData = 0;
+	decodeData();
+}
 
-	while (remainingRawData_.size() > 0)
+void CompactASN1Subscriber::decodeData()
+{
+	while (state_->rawData.size() > 0)
 	{
-		if (partialData_ == NULL)
+		if (state_->partialData == NULL && processFixedLayoutFrame())
+		{
+			continue;
+		}
+
+		if (state_->partialData == NULL)
 		{
-			partialData_ = new PartialEvent(eventSink_->getTimeStampNow(), 
+			state_->partialData = new PartialEvent(getFrameTimeStamp(), 
 				channelConfig_->getPortIDs());
 		}
 		
@@ -108,34 +152,274 @@ void CompactASN1Subscriber::commitData(size_t actualSize)
 		}
 		else if(status.state == Incomplete)
 		{
-			// TODO: Set the number of bytes which are missing
+			state_->missingData = status.missingData;
 			break;
 		}
 
-		if (partialData_ != NULL && !partialData_->hasRemainingElements())
+		if (state_->partialData != NULL && !state_->partialData->hasRemainingElements())
 		{
 			pushPartialEvent();
 		}
 	}
 }
 
+CompactASN1Subscriber::FrameState::FrameState(
+	boost::asio::io_service &service): partialData(NULL), rawData(), 
+	missingData(0), packetTimer(service)
+{
+}
+
+CompactASN1Subscriber::FrameState::~FrameState()
+{
+	if (partialData != NULL)
+	{
+		delete partialData;
+	}
+}
+
+std::shared_ptr<CompactASN1Subscriber::FrameState> 
+CompactASN1Subscriber::createFrameState()
+{
+	return std::make_shared<FrameState>(*getIOService());
+}
+
+void CompactASN1Subscriber::selectFrameState(
+	const std::shared_ptr<FrameState> &state)
+{
+	assert(state);
+	state_ = state;
+}
+
+void CompactASN1Subscriber::flushFrameState()
+{
+	assert(state_);
+
+	state_->packetTimer.cancel();
+	if (state_->partialData != NULL)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "ASN.1 data missing: Triggering event "
+			<< state_->partialData->toString() << " due to a closed stream";
+		pushPartialEvent();
+	}
+	clearUnprocessedData();
+}
+
+void CompactASN1Subscriber::commitDatagram(const uint8_t *data, size_t size,
+	boost::optional<std::chrono::system_clock::time_point> received)
+{
+	assert(data != NULL || size == 0);
+	assert(state_->partialData == NULL);
+
+	size_t copied = boost::asio::buffer_copy(state_->rawData.prepare(size),
+		boost::asio::buffer(data, size));
+	assert(copied == size);
+
+	state_->rawData.commit(copied);
+	state_->missingData = 0;
+	datagramReceived_ = received;
+	decodeData();
+	datagramReceived_.reset();
+
+	// The next datagram starts a new frame
+	if (state_->partialData != NULL)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Incomplete ASN.1 datagram: Triggering "
+			"event " << state_->partialData->toString();
+		pushPartialEvent();
+	}
+	clearUnprocessedData();
+}
+
+size_t CompactASN1Subscriber::getReceiveBatch() const
+{
+	return receiveBatch_;
+}
+
+size_t CompactASN1Subscriber::getEstimatedFrameSize() const
+{
+	assert(!remainingFrameSize_.empty());
+	return remainingFrameSize_.front();
+}
+
+void CompactASN1Subscriber::initFrameSizes()
+{
+	assert(channelConfig_ != NULL);
+
+	const std::vector<Base::PortID> &ports = channelConfig_->getPortIDs();
+	remainingFrameSize_.assign(ports.size() + 1, 0);
+	for (size_t i = ports.size(); i > 0; i--)
+	{
+		remainingFrameSize_[i - 1] = remainingFrameSize_[i] + 
+			getEstimatedSize(ports[i - 1].first);
+	}
+
+	receiveBatch_ = (size_t) channelConfig_->getRealPositiveIntegerProperty(
+		PROP_RECEIVE_BATCH, (int) receiveBatch_);
+}
+
+size_t CompactASN1Subscriber::getRemainingFrameSize() const
+{
+	assert(!remainingFrameSize_.empty());
+
+	if (state_->partialData == NULL || !state_->partialData->hasRemainingElements())
+	{
+		return remainingFrameSize_.front();
+	}
+
+	unsigned int next = state_->partialData->getNextPortIndex();
+	if (state_->missingData > 0)
+	{
+		// The next variable is partly received
+		return state_->missingData + remainingFrameSize_[next + 1];
+	}
+	return remainingFrameSize_[next];
+}
+
+size_t CompactASN1Subscriber::getEstimatedSize(FMIVariableType type)
+{
+	switch (type)
+	{
+	case fmiTypeReal: return 1 + sizeof(double); // LREAL
+	case fmiTypeInteger: return 1 + sizeof(int32_t); // DINT
+	case fmiTypeBoolean: return 1; // BOOL
+	case fmiTypeString: return 1 + sizeof(uint16_t); // Empty STRING
+	default:
+		assert(false);
+		return 1;
+	}
+}
+
+void CompactASN1Subscriber::initFixedLayout()
+{
+	assert(channelConfig_ != NULL);
+
+	fixedLayout_.clear();
+	const std::vector<Base::PortID> &ports = channelConfig_->getPortIDs();
+	size_t offset = 0;
+	for (auto it = ports.begin(); it != ports.end(); ++it)
+	{
+		DecodingStep step = {it->first, ASN1Commons::CLASS_APPLICATION, offset};
+		switch (it->first)
+		{
+		case fmiTypeReal:    step.tag |= ASN1Commons::LREAL_TAG_NR; break;
+		case fmiTypeInteger: step.tag |= ASN1Commons::DINT_TAG_NR;  break;
+		case fmiTypeBoolean: step.tag |= ASN1Commons::BOOL0_TAG_NR; break;
+		default:
+			// Strings don't have a fixed size
+			fixedLayout_.clear();
+			BOOST_LOG_TRIVIAL(debug) << "The ASN.1 input channel doesn't have a "
+				"fixed layout. Use the generic decoder only.";
+			return;
+		}
+		fixedLayout_.push_back(step);
+		offset += getEstimatedSize(it->first);
+	}
+	assert(offset == remainingFrameSize_.front());
+}
+
+bool CompactASN1Subscriber::processFixedLayoutFrame()
+{
+	assert(state_->partialData == NULL);
+
+	const size_t frameSize = remainingFrameSize_.front();
+	if (fixedLayout_.empty() || state_->rawData.size() < frameSize)
+	{
+		return false;
+	}
+
+	const uint8_t *frame = boost::asio::buffer_cast<const uint8_t *>(
+		state_->rawData.data());
+
+	// Validate the whole frame before converting anything
+	for (auto it = fixedLayout_.begin(); it != fixedLayout_.end(); ++it)
+	{
+		uint8_t tag = frame[it->offset];
+		if (tag != it->tag && (it->type != fmiTypeBoolean || tag != 
+			(ASN1Commons::CLASS_APPLICATION | ASN1Commons::BOOL1_TAG_NR)))
+		{
+			return false;
+		}
+	}
+
+	PartialEvent *ev = new PartialEvent(getFrameTimeStamp(),
+		channelConfig_->getPortIDs());
+	for (auto it = fixedLayout_.begin(); it != fixedLayout_.end(); ++it)
+	{
+		const uint8_t *value = frame + it->offset + 1;
+		switch (it->type)
+		{
+		case fmiTypeReal:
+		{
+			uint64_t raw;
+			std::memcpy(&raw, value, sizeof(raw));
+			raw = boost::endian::big_to_native(raw);
+			double realValue;
+			std::memcpy(&realValue, &raw, sizeof(realValue));
+			ev->pushNextTypedValue<fmiReal>(realValue);
+			break;
+		}
+		case fmiTypeInteger:
+		{
+			int32_t intValue;
+			std::memcpy(&intValue, value, sizeof(intValue));
+			ev->pushNextTypedValue<fmiInteger>(
+				boost::endian::big_to_native(intValue));
+			break;
+		}
+		case fmiTypeBoolean:
+			ev->pushNextTypedValue<fmiBoolean>(frame[it->offset] == it->tag ? 
+				fmiFalse : fmiTrue);
+			break;
+		default:
+			assert(false);
+		}
+	}
+	state_->rawData.consume(frameSize);
+
+	state_->partialData = ev;
+	pushPartialEvent();
+	return true;
+}
+
+fmiTime CompactASN1Subscriber::getFrameTimeStamp()
+{
+	fmiTime now = eventSink_->getTimeStampNow();
+	if (datagramReceived_)
+	{
+		std::chrono::system_clock::duration age =
+			std::chrono::system_clock::now() - datagramReceived_.get();
+		// The system clock may have been adjusted in the meantime
+		if (age.count() > 0)
+		{
+			now -= std::chrono::duration<fmiTime>(age).count();
+		}
+	}
+	return now;
+}
+
 void CompactASN1Subscriber::restartPacketTimer()
 {
-	assert(packetTimeoutTimer_);
+	assert(state_);
 
-	packetTimeoutTimer_->cancel();
-	packetTimeoutTimer_->async_wait(boost::bind(
+	// Setting the expiry time cancels any pending wait operation
+	state_->packetTimer.expires_from_now(packetTimeout_);
+	state_->packetTimer.async_wait(strand_->wrap(boost::bind(
 		&CompactASN1Subscriber::handlePacketTimeout, this,
-		boost::asio::placeholders::error));
+		std::weak_ptr<FrameState>(state_), boost::asio::placeholders::error)));
 }
 
 void CompactASN1Subscriber::handlePacketTimeout(
-	const boost::system::error_code& error)
+	std::weak_ptr<FrameState> weakState, const boost::system::error_code& error)
 {
-	if (!error && partialData_ != NULL)
+	if (error) return;
+
+	// The state may have been released in the meantime
+	std::shared_ptr<FrameState> state = weakState.lock();
+	if (state && state->partialData != NULL)
 	{
+		selectFrameState(state);
 		BOOST_LOG_TRIVIAL(warning) << "ASN.1 data missing: Triggering event " 
-			<< partialData_->toString() << " due to a timeout";
+			<< state_->partialData->toString() << " due to a timeout";
 		pushPartialEvent();
 		clearUnprocessedData();
 	}
@@ -143,61 +427,67 @@ void CompactASN1Subscriber::handlePacketTimeout(
 
 void CompactASN1Subscriber::clearUnprocessedData()
 {
-	if (remainingRawData_.size() > 0)
+	if (state_->rawData.size() > 0)
 	{
-		BOOST_LOG_TRIVIAL(warning) << "Ignore " << remainingRawData_.size() <<
+		BOOST_LOG_TRIVIAL(warning) << "Ignore " << state_->rawData.size() <<
 			" bytes of unprocessed ASN.1 data to gain a consistent decoding state";
-		remainingRawData_.consume(remainingRawData_.size());
+		state_->rawData.consume(state_->rawData.size());
 	}
+	state_->missingData = 0;
 }
 
 void CompactASN1Subscriber::pushPartialEvent()
 {
 	assert(eventSink_);
-	assert(partialData_);
+	assert(state_->partialData);
 
-	eventSink_->pushExternalEvent(partialData_);
-	partialData_ = NULL;
+	eventSink_->pushExternalEvent(state_->partialData);
+	state_->partialData = NULL;
 }
 
 void CompactASN1Subscriber::handleTermination()
 {
-	assert(packetTimeoutTimer_);
+	assert(defaultState_);
 	
 	busyKeeper_.reset();
 	terminateNetworkConnection();
-	packetTimeoutTimer_->cancel();
-	service_.stop();
+	selectFrameState(defaultState_);
+	state_->packetTimer.cancel();
+	if (!ioPool_)
+	{
+		service_.stop();
+	}
 
 	// Clean buffered data
-	if (partialData_ != NULL)
+	if (state_->partialData != NULL)
 	{
 		BOOST_LOG_TRIVIAL(debug) << "Clear partially received event because the "
-			<< "subscriber is requested to terminate: " << partialData_->toString();
-		delete partialData_;
-		partialData_ = NULL;
+			<< "subscriber is requested to terminate: " 
+			<< state_->partialData->toString();
+		delete state_->partialData;
+		state_->partialData = NULL;
 	}
 	clearUnprocessedData();
 }
 
 uint8_t CompactASN1Subscriber::getFirstRawDataByte() const
 {
-	assert(remainingRawData_.size() >= sizeof(uint8_t));
+	assert(state_->rawData.size() >= sizeof(uint8_t));
 	return boost::asio::buffer_cast<const uint8_t *>(
-		remainingRawData_.data())[0];
+		state_->rawData.data())[0];
 }
 
 CompactASN1Subscriber::ParsingStatus
 CompactASN1Subscriber::processRawDataToEvent()
 {
-	assert(partialData_ != NULL);
+	assert(state_->partialData != NULL);
 
 	ParsingStatus state = {Ok, 0};
-	while (remainingRawData_.size() > 0 && partialData_->hasRemainingElements()
+	while (state_->rawData.size() > 0 && state_->partialData->hasRemainingElements()
 		&& (state.state == Ok || state.state == TypeConversionError))
 	{
 		boost::any value;
-		switch (partialData_->getNextPortType())
+		switch (state_->partialData->getNextPortType())
 		{
 		case fmiTypeReal:	    state = readNextVariable<fmiReal>(&value);     break;
 		case fmiTypeInteger:	state = readNextVariable<fmiInteger>(&value);  break;
@@ -209,11 +499,11 @@ CompactASN1Subscriber::processRawDataToEvent()
 
 		if (state.state == Ok)
 		{
-			partialData_->pushNextValue(value);
+			state_->partialData->pushNextValue(value);
 		}
 		else if (state.state == TypeConversionError)
 		{
-			partialData_->ignoreNextValue();
+			state_->partialData->ignoreNextValue();
 		}
 	}
 	return state;
@@ -223,7 +513,7 @@ template<typename DestinationType>
 CompactASN1Subscriber::ParsingStatus
 CompactASN1Subscriber::readNextVariable(boost::any *dest)
 {
-	assert(remainingRawData_.size() > 0);
+	assert(state_->rawData.size() > 0);
 
 	boost::optional<DestinationType> convertedValue;
 	ParsingStatus state;
@@ -300,20 +590,20 @@ CompactASN1Subscriber::readXREALVariable(FloatType *dest)
 	ParsingStatus status;
 	const size_t expectedSize = sizeof(*dest) + 1;
 
-	if (remainingRawData_.size() < expectedSize)
+	if (state_->rawData.size() < expectedSize)
 	{
 		status.state = Incomplete;
-		status.missingData = expectedSize - remainingRawData_.size();
+		status.missingData = expectedSize - state_->rawData.size();
 	}
 	else
 	{
-		remainingRawData_.consume(sizeof(uint8_t)); // Assume the tag is correct
+		state_->rawData.consume(sizeof(uint8_t)); // Assume the tag is correct
 
 		const UIntType *buffer = boost::asio::buffer_cast<const UIntType*>(
-			remainingRawData_.data());
+			state_->rawData.data());
 		UIntType *rawDest = reinterpret_cast<UIntType*>(dest);
 		*rawDest = boost::endian::big_to_native(*buffer);
-		remainingRawData_.consume(sizeof(*buffer));
+		state_->rawData.consume(sizeof(*buffer));
 
 		status.state = Ok;
 		status.missingData = 0;
@@ -330,11 +620,11 @@ CompactASN1Subscriber::readSTRINGVariable(std::string *dest)
 	assert(dest != NULL);
 
 	const size_t expectedMetaDataSize = sizeof(uint8_t) + sizeof(uint16_t);
-	if (remainingRawData_.size() < expectedMetaDataSize)
+	if (state_->rawData.size() < expectedMetaDataSize)
 	{
 		ParsingStatus status;
 		status.state = Incomplete;
-		status.missingData = expectedMetaDataSize - remainingRawData_.size();
+		status.missingData = expectedMetaDataSize - state_->rawData.size();
 		return status;
 	}
 
@@ -342,25 +632,25 @@ CompactASN1Subscriber::readSTRINGVariable(std::string *dest)
 		(ASN1Commons::CLASS_APPLICATION | ASN1Commons::STRING_TAG_NR));
 
 	const uint8_t *buffer;
-	buffer = buffer_cast<const uint8_t *>(remainingRawData_.data());
+	buffer = buffer_cast<const uint8_t *>(state_->rawData.data());
 	buffer++;
 	const size_t length = boost::endian::big_to_native<uint16_t>(
 		*reinterpret_cast<const uint16_t*>(buffer));
 
-	if (remainingRawData_.size() < expectedMetaDataSize + length)
+	if (state_->rawData.size() < expectedMetaDataSize + length)
 	{
 		ParsingStatus status;
 		status.state = Incomplete;
 		status.missingData = expectedMetaDataSize + length;
-		status.missingData -= remainingRawData_.size();
+		status.missingData -= state_->rawData.size();
 		return status;
 	}
 
-	const char *str = buffer_cast<const char *>(remainingRawData_.data());
+	const char *str = buffer_cast<const char *>(state_->rawData.data());
 	str += (expectedMetaDataSize / sizeof(char));
 	*dest = std::string(str, length);
 
-	remainingRawData_.consume(expectedMetaDataSize + length);
+	state_->rawData.consume(expectedMetaDataSize + length);
 
 	ParsingStatus status;
 	status.state = Ok;
@@ -376,7 +666,7 @@ CompactASN1Subscriber::readBOOL0Variable(fmiBoolean *dest)
 	assert(dest != NULL);
 
 	*dest = fmiFalse;
-	remainingRawData_.consume(sizeof(uint8_t));
+	state_->rawData.consume(sizeof(uint8_t));
 
 	ParsingStatus status = {Ok,0};
 	return status;
@@ -390,7 +680,7 @@ CompactASN1Subscriber::readBOOL1Variable(fmiBoolean *dest)
 	assert(dest != NULL);
 
 	*dest = fmiTrue;
-	remainingRawData_.consume(sizeof(uint8_t));
+	state_->rawData.consume(sizeof(uint8_t));
 
 	ParsingStatus status = {Ok,0};
 	return status;
@@ -405,20 +695,20 @@ CompactASN1Subscriber::readXINTVariable(IntType *dest)
 	assert(dest != NULL);
 
 	const size_t expectedSize = sizeof(uint8_t) + sizeof(IntType);
-	if (remainingRawData_.size() < expectedSize)
+	if (state_->rawData.size() < expectedSize)
 	{
 		ParsingStatus status;
 		status.state = Incomplete;
-		status.missingData = expectedSize - remainingRawData_.size();
+		status.missingData = expectedSize - state_->rawData.size();
 		return status;
 	}
 
-	remainingRawData_.consume(sizeof(uint8_t)); // Consume the tag
+	state_->rawData.consume(sizeof(uint8_t)); // Consume the tag
 
-	const IntType *dat = buffer_cast<const IntType*>(remainingRawData_.data());
+	const IntType *dat = buffer_cast<const IntType*>(state_->rawData.data());
 	*dest = boost::endian::big_to_native<IntType>(*dat);
 
-	remainingRawData_.consume(sizeof(IntType)); // Consume the value
+	state_->rawData.consume(sizeof(IntType)); // Consume the value
 
 	ParsingStatus status = {Ok, 0};
 	return status;
@@ -12,79 +12,375 @@
 #include "network/CompactASN1TCPClientPublisher.h"
 #include "base/BaseExceptions.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <stdexcept>
+#include <boost/bind.hpp>
 #include <boost/log/trivial.hpp>
 
 using namespace FMITerminalBlock::Network;
 
 const std::string CompactASN1TCPClientPublisher::PUBLISHER_ID = "CompactASN.1-TCP";
 const std::string CompactASN1TCPClientPublisher::PROP_ADDR	= "addr";
+const std::string CompactASN1TCPClientPublisher::PROP_COALESCE = "coalesce";
+const std::string CompactASN1TCPClientPublisher::PROP_NO_DELAY = "noDelay";
+const std::string CompactASN1TCPClientPublisher::PROP_WRITE_QUEUE_SIZE =
+	"writeQueueSize";
+const std::string CompactASN1TCPClientPublisher::PROP_DROP_OLDEST =
+	"dropOldest";
+const std::string CompactASN1TCPClientPublisher::PROP_RECON_INTERVAL =
+	"reconnectionInterval";
+const std::string CompactASN1TCPClientPublisher::PROP_RECON_MAX_INTERVAL =
+	"reconnectionMaxInterval";
+const std::string CompactASN1TCPClientPublisher::PROP_RETRY_COUNT =
+	"reconnectionRetryCount";
 
-CompactASN1TCPClientPublisher::CompactASN1TCPClientPublisher(): 
-	service_(), socket_(NULL)
+/**
+ * @brief Returns the boolean value of the given property
+ * @details Contrary to the defaulted ptree getter, an invalid value is not
+ * silently replaced by the default value. Instead, a
+ * Base::SystemConfigurationException is thrown.
+ */
+static bool getFlag(const boost::property_tree::ptree &config,
+	const std::string &key, bool defaultValue)
+{
+	if (!config.get_optional<std::string>(key)) return defaultValue;
+	try
+	{
+		return config.get<bool>(key);
+	} catch (boost::property_tree::ptree_bad_data&) {
+		throw FMITerminalBlock::Base::SystemConfigurationException("The flag is "
+			"not a boolean value", key, config.get<std::string>(key));
+	}
+}
+
+CompactASN1TCPClientPublisher::CompactASN1TCPClientPublisher():
+	ioPool_(), service_(), work_(), ioThread_(), strand_(), socket_(),
+	reconnectTimer_(), endpoints_(), addr_(), coalesce_(false),
+	noDelay_(true), writeQueueSize_(DEFAULT_WRITE_QUEUE_SIZE),
+	dropOldest_(false), reconnectInterval_(500), reconnectMaxInterval_(8000),
+	reconnectRetries_(4), mutex_(), queueDrained_(), writeQueue_(),
+	writeBatch_(), spareBuffers_(), gatherBuffers_(), connected_(false),
+	writing_(false), closing_(false), failedAttempts_(0), nextInterval_(500),
+	error_()
 {
 
 }
 
 CompactASN1TCPClientPublisher::~CompactASN1TCPClientPublisher()
 {
-	if(socket_ != NULL)
+	if (ioThread_.joinable())
 	{
-		delete socket_;
+		// Don't wait for a lagging or disconnected peer
+		work_.reset();
+		service_.stop();
+		ioThread_.join();
+	} else if (strand_) {
+		// The shared service keeps running. Abort and await pending handlers.
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			closing_ = true;
+			boost::system::error_code ignored;
+			socket_->close(ignored);
+			reconnectTimer_->cancel(ignored);
+		}
+		strand_->waitUntilIdle();
 	}
 }
 
-void 
+void
+CompactASN1TCPClientPublisher::setIOServicePool(
+	std::shared_ptr<IOServicePool> pool)
+{
+	assert(!strand_);
+	ioPool_ = pool;
+}
+
+void
 CompactASN1TCPClientPublisher::init(const Base::TransmissionChannel &channel)
 {
+	assert(!ioThread_.joinable());
+	assert(!strand_);
+
 	CompactASN1Publisher::init(channel);
-	
-	boost::optional<const boost::property_tree::ptree&> addrProp = 
-		channel.getChannelConfig().get_child_optional(PROP_ADDR);
-	if(! ((bool) addrProp))
+	initConfiguration(channel);
+
+	strand_.reset(new ChannelStrand(getIOService()));
+	socket_.reset(new tcp::socket(getIOService()));
+	reconnectTimer_.reset(new boost::asio::steady_timer(getIOService()));
+
+	size_t sepPos = addr_.find(":");
+
+	// Try to resolve the addresses
+	tcp::resolver resolver(getIOService());
+	tcp::resolver::query query(addr_.substr(0, sepPos), addr_.substr(sepPos + 1));
+	tcp::resolver::iterator remoteCandidates = resolver.resolve(query);
+	endpoints_.assign(remoteCandidates, tcp::resolver::iterator());
+
+	boost::asio::connect(*socket_, endpoints_.begin(), endpoints_.end());
+	configureSocket();
+	connected_ = true;
+
+	BOOST_LOG_TRIVIAL(trace) << "Just initialized publishing ASN.1 TCP client"
+		" connected to " << socket_->remote_endpoint().protocol().type() << ":"
+		<< addr_.substr(0, sepPos) << ":" << socket_->remote_endpoint().port();
+
+	if (!ioPool_)
+	{
+		work_.reset(new boost::asio::io_service::work(service_));
+		ioThread_ = std::thread([this]() { service_.run(); });
+	}
+}
+
+void
+CompactASN1TCPClientPublisher::sendData(const std::vector<uint8_t> &buffer)
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	// Don't drop any message unless it is explicitly requested
+	while (!coalesce_ && !dropOldest_ && !error_ &&
+		writeQueue_.size() >= writeQueueSize_)
 	{
-		throw Base::SystemConfigurationException("Address property of ASN.1 publisher not found");
+		queueDrained_.wait(lock);
 	}
-	
-	std::string addr = addrProp.value().get_value<std::string>();
 
-	size_t sepPos = addr.find(":");
-	if(sepPos == std::string::npos || sepPos == (addr.size() - 1) || sepPos == 0)
+	if (error_)
 	{
-		throw Base::SystemConfigurationException("Invalid address format. Expected "
-			"<addr>:<port>", PROP_ADDR, addr);
+		std::exception_ptr err = error_;
+		error_ = std::exception_ptr();
+		std::rethrow_exception(err);
 	}
 
+	queueMessage(buffer);
+	if (connected_ && !writing_)
+	{
+		startWrite();
+	}
+}
 
+void
+CompactASN1TCPClientPublisher::initConfiguration(
+	const Base::TransmissionChannel &channel)
+{
+	const boost::property_tree::ptree &config = channel.getChannelConfig();
 
-	// Try to resolve the addresses
-	tcp::resolver resolver(service_);
-	tcp::resolver::query query(addr.substr(0, sepPos), addr.substr(sepPos + 1));
-	tcp::resolver::iterator remoteCandidates = resolver.resolve(query);
+	boost::optional<std::string> addr =
+		config.get_optional<std::string>(PROP_ADDR);
+	if (!addr)
+	{
+		throw Base::SystemConfigurationException("Address property of ASN.1 "
+			"publisher not found");
+	}
+	addr_ = addr.get();
 
-	if(socket_ != NULL)
+	size_t sepPos = addr_.find(":");
+	if (sepPos == std::string::npos || sepPos == (addr_.size() - 1) ||
+		sepPos == 0)
 	{
-		delete socket_;
+		throw Base::SystemConfigurationException("Invalid address format. "
+			"Expected <addr>:<port>", PROP_ADDR, addr_);
 	}
-	socket_ = new tcp::socket(service_);
-	boost::asio::connect(*socket_, remoteCandidates);
 
-	BOOST_LOG_TRIVIAL(trace) << "Just initialized publishing ASN.1 TCP client"
-		" connected to " << socket_->remote_endpoint().protocol().type() << ":" 
-		<< addr.substr(0, sepPos) << ":" << socket_->remote_endpoint().port();
+	coalesce_ = getFlag(config, PROP_COALESCE, false);
+	noDelay_ = getFlag(config, PROP_NO_DELAY, true);
+
+	const int queueSize = channel.getRealPositiveIntegerProperty(
+		PROP_WRITE_QUEUE_SIZE, (int) DEFAULT_WRITE_QUEUE_SIZE);
+	// A single message is sufficient to hold the latest output image
+	writeQueueSize_ = coalesce_ ? 1 : (size_t) queueSize;
+	dropOldest_ = getFlag(config, PROP_DROP_OLDEST, false);
+
+	reconnectInterval_ = std::chrono::milliseconds(
+		config.get<uint64_t>(PROP_RECON_INTERVAL, 500));
+	reconnectMaxInterval_ = std::max(reconnectInterval_,
+		std::chrono::milliseconds(
+			config.get<uint64_t>(PROP_RECON_MAX_INTERVAL, 8000)));
+	reconnectRetries_ = config.get<uint32_t>(PROP_RETRY_COUNT, 4);
+	nextInterval_ = reconnectInterval_;
 }
 
-void 
-CompactASN1TCPClientPublisher::sendData(const std::vector<uint8_t> &buffer)
+boost::asio::io_service &
+CompactASN1TCPClientPublisher::getIOService()
+{
+	return ioPool_ ? ioPool_->getIOService() : service_;
+}
+
+void
+CompactASN1TCPClientPublisher::queueMessage(const std::vector<uint8_t> &buffer)
 {
-	size_t trSize = socket_->send(boost::asio::buffer(buffer));
-	if(trSize != buffer.size())
+	if (writeQueue_.size() >= writeQueueSize_)
 	{
-		BOOST_LOG_TRIVIAL(warning) << "TCP message "  << toString(buffer)
-			<< " was only partly transferred (" << trSize << 	"/" << buffer.size() 
-			<< " bytes)";
+		if (!coalesce_)
+		{
+			BOOST_LOG_TRIVIAL(warning) << "The write queue of the TCP publisher "
+				"connected to " << addr_ << " is full. Drop message "
+				<< toString(writeQueue_.front());
+		}
+		recycle(writeQueue_.front());
+		writeQueue_.pop_front();
+	}
+
+	if (spareBuffers_.empty())
+	{
+		writeQueue_.push_back(buffer);
 	} else {
-		BOOST_LOG_TRIVIAL(trace) << "Compact ASN.1 message sent: " 
-			<< toString(buffer);
+		writeQueue_.push_back(std::move(spareBuffers_.back()));
+		spareBuffers_.pop_back();
+		writeQueue_.back().assign(buffer.begin(), buffer.end());
+	}
+}
+
+void
+CompactASN1TCPClientPublisher::startWrite()
+{
+	assert(connected_);
+	assert(!writing_);
+
+	if (coalesce_ && !writeQueue_.empty())
+	{
+		// A failed write operation is superseded by the latest output image
+		for (auto it = writeBatch_.begin(); it != writeBatch_.end(); ++it)
+		{
+			recycle(*it);
+		}
+		writeBatch_.clear();
+	}
+
+	// Messages of a failed write operation are sent first
+	while (!writeQueue_.empty())
+	{
+		writeBatch_.push_back(std::move(writeQueue_.front()));
+		writeQueue_.pop_front();
+	}
+	queueDrained_.notify_all();
+	if (writeBatch_.empty()) return;
+
+	gatherBuffers_.clear();
+	for (auto it = writeBatch_.begin(); it != writeBatch_.end(); ++it)
+	{
+		gatherBuffers_.push_back(boost::asio::buffer(*it));
+	}
+
+	writing_ = true;
+	boost::asio::async_write(*socket_, gatherBuffers_,
+		strand_->wrap(boost::bind(&CompactASN1TCPClientPublisher::handleWrite, 
+			this, boost::asio::placeholders::error)));
+}
+
+void
+CompactASN1TCPClientPublisher::handleWrite(
+	const boost::system::error_code &error)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	writing_ = false;
+	if (closing_) return;
+
+	if (error)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Could not send " << writeBatch_.size()
+			<< " TCP message(s) to " << addr_ << ": " << error.message()
+			<< ". Try reconnecting";
+		connected_ = false;
+		boost::system::error_code ignored;
+		socket_->close(ignored);
+		startConnect();
+		return;
+	}
+
+	for (auto it = writeBatch_.begin(); it != writeBatch_.end(); ++it)
+	{
+		BOOST_LOG_TRIVIAL(trace) << "Compact ASN.1 message sent: "
+			<< toString(*it);
+		recycle(*it);
+	}
+	writeBatch_.clear();
+
+	startWrite();
+}
+
+void
+CompactASN1TCPClientPublisher::startConnect()
+{
+	assert(!connected_);
+	boost::asio::async_connect(*socket_, endpoints_.begin(), endpoints_.end(),
+		strand_->wrap(boost::bind(&CompactASN1TCPClientPublisher::handleConnect,
+			this, boost::asio::placeholders::error)));
+}
+
+void
+CompactASN1TCPClientPublisher::handleConnect(
+	const boost::system::error_code &error)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (closing_) return;
+
+	boost::system::error_code err = error;
+	if (!err)
+	{
+		try
+		{
+			configureSocket();
+		} catch (boost::system::system_error &ex) {
+			err = ex.code();
+		}
+	}
+
+	if (err)
+	{
+		failedAttempts_++;
+		BOOST_LOG_TRIVIAL(error) << "Could not re-connect to " << addr_ << ": "
+			<< err.message();
+
+		boost::system::error_code ignored;
+		socket_->close(ignored);
+
+		if (failedAttempts_ >= reconnectRetries_)
+		{
+			error_ = std::make_exception_ptr(std::runtime_error("Couldn't "
+				"successfully re-connect to the TCP server " + addr_));
+			queueDrained_.notify_all();
+			return;
+		}
+
+		BOOST_LOG_TRIVIAL(info) << "Wait for " << nextInterval_.count()
+			<< " ms and try reconnecting again";
+		reconnectTimer_->expires_from_now(nextInterval_);
+		reconnectTimer_->async_wait(strand_->wrap(boost::bind(
+			&CompactASN1TCPClientPublisher::handleReconnectTimer, this,
+			boost::asio::placeholders::error)));
+		nextInterval_ = std::min(2 * nextInterval_, reconnectMaxInterval_);
+		return;
+	}
+
+	BOOST_LOG_TRIVIAL(info) << "Re-connected the TCP publisher to " << addr_;
+	connected_ = true;
+	failedAttempts_ = 0;
+	nextInterval_ = reconnectInterval_;
+	startWrite();
+}
+
+void
+CompactASN1TCPClientPublisher::handleReconnectTimer(
+	const boost::system::error_code &error)
+{
+	if (error == boost::asio::error::operation_aborted) return;
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	if (closing_) return;
+	startConnect();
+}
+
+void
+CompactASN1TCPClientPublisher::configureSocket()
+{
+	socket_->set_option(tcp::no_delay(noDelay_));
+}
+
+void
+CompactASN1TCPClientPublisher::recycle(std::vector<uint8_t> &buffer)
+{
+	if (spareBuffers_.size() < writeQueueSize_ + 1)
+	{
+		spareBuffers_.push_back(std::move(buffer));
 	}
 }
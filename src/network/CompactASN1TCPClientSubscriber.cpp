@@ -11,7 +11,7 @@
 #include "network/CompactASN1TCPClientSubscriber.h"
 
 #include <assert.h>
-#include <thread>
+#include <stdexcept>
 
 #include <boost/asio/connect.hpp>
 #include <boost/asio/placeholders.hpp>
@@ -31,6 +31,7 @@ const std::string CompactASN1TCPClientSubscriber::PROP_RETRY_COUNT	= "reconnecti
 void CompactASN1TCPClientSubscriber::initNetwork()
 {
 	socket_ = std::make_shared<boost::asio::ip::tcp::socket>(*getIOService());
+	reconnectTimer_.reset(new boost::asio::steady_timer(*getIOService()));
 	initConfigVariables();
 	syncConnect();
 	initiateAsyncReceiving();
@@ -40,6 +41,8 @@ void CompactASN1TCPClientSubscriber::terminateNetworkConnection()
 {
 	assert(socket_);
 	socket_->close();
+	boost::system::error_code ignored;
+	reconnectTimer_->cancel(ignored);
 }
 
 void CompactASN1TCPClientSubscriber::syncConnect()
@@ -55,14 +58,15 @@ void CompactASN1TCPClientSubscriber::syncConnect()
 	tcp::resolver resolver(*getIOService());
 	boost::system::error_code err;
 
-	auto addrItr = resolver.resolve(destQuery, err);
+	tcp::resolver::iterator addrItr = resolver.resolve(destQuery, err);
 	if (err)
 	{
 		throw Base::SystemConfigurationException("Couldn't resolve address", 
 			PROP_ADDR, addr.first + ":" + addr.second);
 	}
 
-	boost::asio::connect(*socket_, addrItr, err);
+	endpoints_.assign(addrItr, tcp::resolver::iterator());
+	boost::asio::connect(*socket_, endpoints_.begin(), endpoints_.end(), err);
 	if (err)
 	{
 		throw Base::SystemConfigurationException("Couldn't connect to server", 
@@ -71,58 +75,97 @@ void CompactASN1TCPClientSubscriber::syncConnect()
 }
 
 
-void CompactASN1TCPClientSubscriber::syncReconnect()
+void CompactASN1TCPClientSubscriber::startReconnect()
 {
-	for (unsigned retry = 0; retry < reconnectionRetries_; retry++)
+	assert(socket_);
+	boost::asio::async_connect(*socket_, endpoints_.begin(), endpoints_.end(),
+		getStrand()->wrap(boost::bind(
+			&CompactASN1TCPClientSubscriber::handleReconnect, this,
+			boost::asio::placeholders::error)));
+}
+
+void CompactASN1TCPClientSubscriber::handleReconnect(
+	const boost::system::error_code &error)
+{
+	if (isTerminationRequestPending() ||
+		error == boost::asio::error::operation_aborted)
 	{
-		try {
-			syncConnect();
-		} catch (std::exception &ex) {
-			BOOST_LOG_TRIVIAL(error) << "Could not re-connect: " << ex.what();
-		}
+		return;
+	}
+
+	if (error)
+	{
+		failedAttempts_++;
+		BOOST_LOG_TRIVIAL(error) << "Could not re-connect: " << error.message();
 
-		if (socket_->is_open())	break; 
-		
-		if (retry < reconnectionRetries_ - 1)
+		boost::system::error_code ignored;
+		socket_->close(ignored);
+		if (failedAttempts_ >= reconnectionRetries_)
 		{
-			BOOST_LOG_TRIVIAL(info) << "Sleep for " << reconnectionTimeout_.count()
-					<< " ms and try reconnecting again";
-			std::this_thread::sleep_for(reconnectionTimeout_);
+			throw std::runtime_error("Couldn't successfully re-connect to the "
+				"TCP server");
 		}
+
+		BOOST_LOG_TRIVIAL(info) << "Wait for " << reconnectionTimeout_.count()
+			<< " ms and try reconnecting again";
+		reconnectTimer_->expires_from_now(reconnectionTimeout_);
+		reconnectTimer_->async_wait(getStrand()->wrap(boost::bind(
+			&CompactASN1TCPClientSubscriber::handleReconnectTimer, this,
+			boost::asio::placeholders::error)));
+		return;
 	}
 
-	if (!socket_->is_open())
+	BOOST_LOG_TRIVIAL(info) << "Re-connected the TCP subscriber";
+	failedAttempts_ = 0;
+	initiateAsyncReceiving();
+}
+
+void CompactASN1TCPClientSubscriber::handleReconnectTimer(
+	const boost::system::error_code &error)
+{
+	if (isTerminationRequestPending() ||
+		error == boost::asio::error::operation_aborted)
 	{
-		throw std::runtime_error("Couldn't successfully re-connect to the "
-			"TCP server");
+		return;
 	}
-
+	startReconnect();
 }
 
 void CompactASN1TCPClientSubscriber::initiateAsyncReceiving()
 {
 	assert(socket_);
 	auto buffer = prepareData();
-	socket_->async_receive(buffer, boost::bind(
+	socket_->async_receive(buffer, getStrand()->wrap(boost::bind(
 		&CompactASN1TCPClientSubscriber::handleReceive, this, 
 		boost::asio::placeholders::error, 
-		boost::asio::placeholders::bytes_transferred));
+		boost::asio::placeholders::bytes_transferred)));
 }
 
 void CompactASN1TCPClientSubscriber::handleReceive(
 	const boost::system::error_code& error,
 	std::size_t bytesTransferred)
 {
+	// A pooled service still executes the handler after the socket was closed
+	if (isTerminationRequestPending() ||
+		error == boost::asio::error::operation_aborted)
+	{
+		return;
+	}
+
 	commitData(bytesTransferred);
-	if (!isTerminationRequestPending())
+	// is_open() does not necessarily reflect the connection status
+	if (!socket_->is_open() || error)
 	{
-		// is_open() does not necessarily reflect the connection status
-		if (!socket_->is_open() || error == boost::asio::error::eof)
-		{
-			syncReconnect();
-		}
-		initiateAsyncReceiving();
+		BOOST_LOG_TRIVIAL(warning) << "Lost the connection of the TCP "
+			"subscriber: " << error.message() << ". Try reconnecting";
+
+		// Receiving continues as soon as the connection is re-established
+		boost::system::error_code ignored;
+		socket_->close(ignored);
+		startReconnect();
+		return;
 	}
+	initiateAsyncReceiving();
 }
 
 void CompactASN1TCPClientSubscriber::initConfigVariables()
@@ -0,0 +1,207 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file CompactASN1TCPServerSubscriber.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "network/CompactASN1TCPServerSubscriber.h"
+
+#include <assert.h>
+#include <sstream>
+
+#include <boost/asio/placeholders.hpp>
+#include <boost/bind.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/system/error_code.hpp>
+
+#include "base/BaseExceptions.h"
+
+using namespace FMITerminalBlock::Network;
+using namespace FMITerminalBlock;
+using boost::asio::ip::tcp;
+
+const std::string CompactASN1TCPServerSubscriber::SUBSCRIBER_ID =
+	"CompactASN.1-TCP-Server";
+const std::string CompactASN1TCPServerSubscriber::PROP_ADDR = "addr";
+const std::string CompactASN1TCPServerSubscriber::PROP_MAX_CONNECTIONS =
+	"maxConnections";
+
+CompactASN1TCPServerSubscriber::Connection::Connection(
+	boost::asio::io_service &service, std::shared_ptr<FrameState> state):
+	socket(service), state(state), peer()
+{
+}
+
+CompactASN1TCPServerSubscriber::CompactASN1TCPServerSubscriber():
+	acceptor_(), maxConnections_(DEFAULT_MAX_CONNECTIONS), connections_()
+{
+}
+
+void CompactASN1TCPServerSubscriber::initNetwork()
+{
+	initConfigVariables();
+	listen();
+	initiateAsyncAccepting();
+}
+
+void CompactASN1TCPServerSubscriber::terminateNetworkConnection()
+{
+	assert(acceptor_);
+
+	boost::system::error_code ignored;
+	acceptor_->close(ignored);
+	for (auto it = connections_.begin(); it != connections_.end(); ++it)
+	{
+		(*it)->socket.close(ignored);
+	}
+	// Pending handlers may still hold a reference to the connection
+	connections_.clear();
+}
+
+void CompactASN1TCPServerSubscriber::initConfigVariables()
+{
+	maxConnections_ = (size_t) getChannelConfiguration()->
+		getRealPositiveIntegerProperty(PROP_MAX_CONNECTIONS,
+			(int) DEFAULT_MAX_CONNECTIONS);
+}
+
+void CompactASN1TCPServerSubscriber::listen()
+{
+	boost::optional<std::string> addr = getChannelConfiguration()->
+		getChannelConfig().get_optional<std::string>(PROP_ADDR);
+	if (!addr)
+	{
+		throw Base::SystemConfigurationException("No addr property set.");
+	}
+
+	size_t colonPos = addr->rfind(':');
+	if (colonPos == std::string::npos || colonPos == 0 ||
+		colonPos == addr->length() - 1)
+	{
+		throw Base::SystemConfigurationException("Invalid address format. "
+			"Expected <addr>:<port>", PROP_ADDR, *addr);
+	}
+
+	tcp::resolver resolver(*getIOService());
+	tcp::resolver::query query(addr->substr(0, colonPos),
+		addr->substr(colonPos + 1));
+	boost::system::error_code err;
+	tcp::resolver::iterator endpoints = resolver.resolve(query, err);
+	if (err || endpoints == tcp::resolver::iterator())
+	{
+		throw Base::SystemConfigurationException("Couldn't resolve address",
+			PROP_ADDR, *addr);
+	}
+
+	tcp::endpoint local = endpoints->endpoint();
+	acceptor_ = std::make_shared<tcp::acceptor>(*getIOService());
+	acceptor_->open(local.protocol(), err);
+	if (!err) acceptor_->set_option(tcp::acceptor::reuse_address(true), err);
+	if (!err) acceptor_->bind(local, err);
+	if (!err) acceptor_->listen(tcp::acceptor::max_connections, err);
+	if (err)
+	{
+		throw Base::SystemConfigurationException("Couldn't listen for TCP "
+			"connections: " + err.message(), PROP_ADDR, *addr);
+	}
+
+	BOOST_LOG_TRIVIAL(trace) << "Just started the ASN.1 TCP server subscriber "
+		"on " << local;
+}
+
+void CompactASN1TCPServerSubscriber::initiateAsyncAccepting()
+{
+	assert(acceptor_);
+
+	auto connection = std::make_shared<Connection>(*getIOService(),
+		createFrameState());
+	acceptor_->async_accept(connection->socket, getStrand()->wrap(boost::bind(
+		&CompactASN1TCPServerSubscriber::handleAccept, this, connection,
+		boost::asio::placeholders::error)));
+}
+
+void CompactASN1TCPServerSubscriber::handleAccept(
+	std::shared_ptr<Connection> connection,
+	const boost::system::error_code& error)
+{
+	if (isTerminationRequestPending() ||
+		error == boost::asio::error::operation_aborted)
+	{
+		return;
+	}
+
+	if (error)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Could not accept a TCP connection: "
+			<< error.message();
+	} else {
+		boost::system::error_code err;
+		std::ostringstream peer;
+		peer << connection->socket.remote_endpoint(err);
+		connection->peer = peer.str();
+
+		if (connections_.size() >= maxConnections_)
+		{
+			BOOST_LOG_TRIVIAL(warning) << "Reject the TCP connection of "
+				<< connection->peer << ". The maximum number of " << maxConnections_
+				<< " connections is reached";
+			connection->socket.close(err);
+		} else {
+			BOOST_LOG_TRIVIAL(info) << "Accepted the TCP connection of "
+				<< connection->peer;
+			connections_.push_back(connection);
+			initiateAsyncReceiving(connection);
+		}
+	}
+
+	initiateAsyncAccepting();
+}
+
+void CompactASN1TCPServerSubscriber::initiateAsyncReceiving(
+	std::shared_ptr<Connection> connection)
+{
+	selectFrameState(connection->state);
+	auto buffer = prepareData();
+	connection->socket.async_receive(buffer, getStrand()->wrap(boost::bind(
+		&CompactASN1TCPServerSubscriber::handleReceive, this, connection,
+		boost::asio::placeholders::error,
+		boost::asio::placeholders::bytes_transferred)));
+}
+
+void CompactASN1TCPServerSubscriber::handleReceive(
+	std::shared_ptr<Connection> connection,
+	const boost::system::error_code& error, std::size_t bytesTransferred)
+{
+	if (isTerminationRequestPending() ||
+		error == boost::asio::error::operation_aborted)
+	{
+		return;
+	}
+
+	selectFrameState(connection->state);
+	commitData(bytesTransferred);
+
+	if (error)
+	{
+		if (error == boost::asio::error::eof)
+		{
+			BOOST_LOG_TRIVIAL(info) << "The TCP connection of " << connection->peer
+				<< " was closed";
+		} else {
+			BOOST_LOG_TRIVIAL(warning) << "Close the TCP connection of "
+				<< connection->peer << ": " << error.message();
+		}
+
+		flushFrameState();
+		boost::system::error_code ignored;
+		connection->socket.close(ignored);
+		connections_.remove(connection);
+		return;
+	}
+
+	initiateAsyncReceiving(connection);
+}
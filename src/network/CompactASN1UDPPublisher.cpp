@@ -21,7 +21,8 @@ const std::string CompactASN1UDPPublisher::PUBLISHER_ID = "CompactASN.1-UDP";
 const std::string CompactASN1UDPPublisher::PROP_ADDR	= "addr";
 
 CompactASN1UDPPublisher::CompactASN1UDPPublisher():
-	service_(), destination_(), socket_(NULL)
+	service_(), destination_(), socket_(NULL), transmitter_(), 
+	transmitterSlot_(0)
 {
 
 }
@@ -68,17 +69,35 @@ void CompactASN1UDPPublisher::init(const Base::TransmissionChannel &channel)
 		socket_ = NULL;
 	}
 
-	socket_ = new udp::socket(service_);
-	socket_->open(destination_.protocol());
+	if(transmitter_)
+	{
+		transmitterSlot_ = transmitter_->addDestination(destination_);
+	} else {
+		socket_ = new udp::socket(service_);
+		socket_->open(destination_.protocol());
+	}
 
 	BOOST_LOG_TRIVIAL(trace) << "Just initialized CompactASN.1-UDP publisher "
 		"sending to " << destination_.protocol().type() << ":" 
 		<< addr.substr(0, sepPos) << ":" << destination_.port();
 }
 
+void 
+CompactASN1UDPPublisher::setTransmitter(
+	std::shared_ptr<UDPTransmitter> transmitter)
+{
+	transmitter_ = transmitter;
+}
+
 void 
 CompactASN1UDPPublisher::sendData(const std::vector<uint8_t> &buffer)
 {
+	if(transmitter_)
+	{
+		transmitter_->enqueue(transmitterSlot_, buffer);
+		return;
+	}
+
 	size_t trSize = socket_->send_to(boost::asio::buffer(buffer), destination_);
 
 	if(trSize != buffer.size())
@@ -0,0 +1,274 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file CompactASN1UDPSubscriber.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "network/CompactASN1UDPSubscriber.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include <boost/asio/placeholders.hpp>
+#include <boost/bind.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/system/error_code.hpp>
+
+#include "base/BaseExceptions.h"
+
+using namespace FMITerminalBlock::Network;
+using namespace FMITerminalBlock;
+using boost::asio::ip::udp;
+
+const std::string CompactASN1UDPSubscriber::SUBSCRIBER_ID = "CompactASN.1-UDP";
+const std::string CompactASN1UDPSubscriber::PROP_ADDR = "addr";
+const std::string CompactASN1UDPSubscriber::PROP_MAX_DATAGRAM_SIZE =
+	"maxDatagramSize";
+
+CompactASN1UDPSubscriber::CompactASN1UDPSubscriber():
+	CompactASN1Subscriber(DEFAULT_RECEIVE_BATCH), socket_(),
+	maxDatagramSize_(MAX_DATAGRAM_SIZE), buffer_()
+#ifdef __linux__
+	, messages_(), dataVectors_(), control_(), controlSize_(0)
+#endif
+{
+}
+
+void CompactASN1UDPSubscriber::initNetwork()
+{
+	socket_ = std::make_shared<udp::socket>(*getIOService());
+	initConfigVariables();
+	bindSocket();
+
+#ifdef __linux__
+	const size_t batch = getReceiveBatch();
+	buffer_.resize(batch * maxDatagramSize_);
+	controlSize_ = CMSG_SPACE(sizeof(struct timespec));
+	control_.resize(batch * controlSize_);
+	dataVectors_.resize(batch);
+	messages_.resize(batch);
+	for (size_t i = 0; i < batch; i++)
+	{
+		dataVectors_[i].iov_base = &buffer_[i * maxDatagramSize_];
+		dataVectors_[i].iov_len = maxDatagramSize_;
+		memset(&messages_[i], 0, sizeof(messages_[i]));
+		messages_[i].msg_hdr.msg_iov = &dataVectors_[i];
+		messages_[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	int enable = 1;
+	if (setsockopt(socket_->native_handle(), SOL_SOCKET, SO_TIMESTAMPNS,
+		&enable, sizeof(enable)) != 0)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Could not enable the kernel receive time "
+			"stamps of the UDP subscriber: " << strerror(errno);
+	}
+#else
+	buffer_.resize(maxDatagramSize_);
+#endif
+
+	initiateAsyncReceiving();
+}
+
+void CompactASN1UDPSubscriber::terminateNetworkConnection()
+{
+	assert(socket_);
+	socket_->close();
+}
+
+void CompactASN1UDPSubscriber::initConfigVariables()
+{
+	const int size = getChannelConfiguration()->getRealPositiveIntegerProperty(
+		PROP_MAX_DATAGRAM_SIZE, (int) getDefaultDatagramSize());
+	if (size > (int) MAX_DATAGRAM_SIZE)
+	{
+		throw Base::SystemConfigurationException("The maximum datagram size is "
+			"out of range", PROP_MAX_DATAGRAM_SIZE, std::to_string(size));
+	}
+	maxDatagramSize_ = (size_t) size;
+}
+
+size_t CompactASN1UDPSubscriber::getDefaultDatagramSize() const
+{
+	const std::vector<Base::PortID> &ports =
+		getChannelConfiguration()->getPortIDs();
+	size_t size = 2 * getEstimatedFrameSize();
+	for (auto it = ports.begin(); it != ports.end(); ++it)
+	{
+		if (it->first == fmiTypeString) size += DEFAULT_STRING_SIZE;
+	}
+	return size < MAX_DATAGRAM_SIZE ? size : (size_t) MAX_DATAGRAM_SIZE;
+}
+
+void CompactASN1UDPSubscriber::bindSocket()
+{
+	assert(socket_);
+
+	boost::optional<std::string> addr = getChannelConfiguration()->
+		getChannelConfig().get_optional<std::string>(PROP_ADDR);
+	if (!addr)
+	{
+		throw Base::SystemConfigurationException("No addr property set.");
+	}
+
+	size_t colonPos = addr->rfind(':');
+	if (colonPos == std::string::npos || colonPos == 0 ||
+		colonPos == addr->length() - 1)
+	{
+		throw Base::SystemConfigurationException("Invalid address format. "
+			"Expected <addr>:<port>", PROP_ADDR, *addr);
+	}
+
+	udp::resolver resolver(*getIOService());
+	udp::resolver::query query(addr->substr(0, colonPos),
+		addr->substr(colonPos + 1));
+	boost::system::error_code err;
+	udp::resolver::iterator endpoints = resolver.resolve(query, err);
+	if (err || endpoints == udp::resolver::iterator())
+	{
+		throw Base::SystemConfigurationException("Couldn't resolve address",
+			PROP_ADDR, *addr);
+	}
+
+	udp::endpoint local = endpoints->endpoint();
+	socket_->open(local.protocol(), err);
+	if (!err) socket_->bind(local, err);
+	if (err)
+	{
+		throw Base::SystemConfigurationException("Couldn't bind the UDP socket: "
+			+ err.message(), PROP_ADDR, *addr);
+	}
+
+	BOOST_LOG_TRIVIAL(trace) << "Just bound the ASN.1 UDP subscriber to "
+		<< local;
+}
+
+#ifdef __linux__
+
+void CompactASN1UDPSubscriber::initiateAsyncReceiving()
+{
+	assert(socket_);
+	// Just wait until the socket is readable and drain it by recvmmsg
+	socket_->async_receive(boost::asio::null_buffers(), getStrand()->wrap(
+		boost::bind(&CompactASN1UDPSubscriber::handleReceive, this,
+			boost::asio::placeholders::error,
+			boost::asio::placeholders::bytes_transferred)));
+}
+
+void CompactASN1UDPSubscriber::handleReceive(
+	const boost::system::error_code& error, std::size_t)
+{
+	if (isTerminationRequestPending() ||
+		error == boost::asio::error::operation_aborted)
+	{
+		return;
+	}
+
+	if (error)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Could not receive UDP datagrams: "
+			<< error.message();
+	} else {
+		receiveDatagrams();
+	}
+	initiateAsyncReceiving();
+}
+
+void CompactASN1UDPSubscriber::receiveDatagrams()
+{
+	const unsigned batch = (unsigned) messages_.size();
+	int ret;
+	do
+	{
+		for (unsigned i = 0; i < batch; i++)
+		{
+			messages_[i].msg_hdr.msg_control = &control_[i * controlSize_];
+			messages_[i].msg_hdr.msg_controllen = controlSize_;
+			messages_[i].msg_hdr.msg_flags = 0;
+		}
+
+		ret = ::recvmmsg(socket_->native_handle(), messages_.data(), batch,
+			MSG_DONTWAIT, NULL);
+		if (ret < 0)
+		{
+			if (errno == EINTR) continue;
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+			{
+				BOOST_LOG_TRIVIAL(warning) << "Could not receive UDP datagrams: "
+					<< strerror(errno);
+			}
+			return;
+		}
+
+		for (int i = 0; i < ret; i++)
+		{
+			if ((messages_[i].msg_hdr.msg_flags & MSG_TRUNC) != 0)
+			{
+				BOOST_LOG_TRIVIAL(warning) << "Drop a UDP datagram which exceeds the "
+					"maximum size of " << maxDatagramSize_ << " bytes. Consider "
+					"raising " << PROP_MAX_DATAGRAM_SIZE;
+				continue;
+			}
+			commitDatagram(&buffer_[i * maxDatagramSize_], messages_[i].msg_len,
+				getReceptionTime(messages_[i].msg_hdr));
+		}
+	} while (ret < 0 || (unsigned) ret == batch);
+}
+
+boost::optional<std::chrono::system_clock::time_point>
+CompactASN1UDPSubscriber::getReceptionTime(const struct msghdr &message)
+{
+	for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != NULL;
+		cmsg = CMSG_NXTHDR(const_cast<struct msghdr *>(&message), cmsg))
+	{
+		if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_TIMESTAMPNS)
+		{
+			continue;
+		}
+
+		struct timespec stamp;
+		memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+		return std::chrono::system_clock::time_point(
+			std::chrono::duration_cast<std::chrono::system_clock::duration>(
+				std::chrono::seconds(stamp.tv_sec) +
+				std::chrono::nanoseconds(stamp.tv_nsec)));
+	}
+	return boost::none;
+}
+
+#else
+
+void CompactASN1UDPSubscriber::initiateAsyncReceiving()
+{
+	assert(socket_);
+	socket_->async_receive(boost::asio::buffer(buffer_), getStrand()->wrap(
+		boost::bind(&CompactASN1UDPSubscriber::handleReceive, this,
+			boost::asio::placeholders::error,
+			boost::asio::placeholders::bytes_transferred)));
+}
+
+void CompactASN1UDPSubscriber::handleReceive(
+	const boost::system::error_code& error, std::size_t bytesTransferred)
+{
+	if (isTerminationRequestPending() ||
+		error == boost::asio::error::operation_aborted)
+	{
+		return;
+	}
+
+	if (error)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Could not receive a UDP datagram: "
+			<< error.message();
+	} else {
+		commitDatagram(buffer_.data(), bytesTransferred, boost::none);
+	}
+	initiateAsyncReceiving();
+}
+
+#endif
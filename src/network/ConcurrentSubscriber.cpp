@@ -44,19 +44,31 @@ void ConcurrentSubscriber::initAndStart(
 
 	init(settings, eventSink);
 
-	subscriptionThread_ = std::thread(&ConcurrentSubscriber::executeRun, this);
+	if (requiresThread())
+	{
+		subscriptionThread_ = std::thread(&ConcurrentSubscriber::executeRun, 
+			this);
+	}
 }
 
 void ConcurrentSubscriber::terminate()
 {
-	assert(subscriptionThread_.joinable());
+	assert(subscriptionThread_.joinable() || !requiresThread());
 
 	{
 		std::lock_guard<std::mutex> guard(objectMut_);
 		terminationRequest_ = true;
 	}
 	terminationRequest();
-	subscriptionThread_.join();
+
+	if (subscriptionThread_.joinable())
+	{
+		subscriptionThread_.join();
+	} else {
+		// Termination request is successfully executed
+		std::lock_guard<std::mutex> guard(objectMut_);
+		terminationRequest_ = false;
+	}
 }
 
 bool ConcurrentSubscriber::isTerminationRequestPending()
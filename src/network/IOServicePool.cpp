@@ -0,0 +1,103 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file IOServicePool.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "network/IOServicePool.h"
+
+#include <assert.h>
+#include <boost/log/trivial.hpp>
+
+using namespace FMITerminalBlock::Network;
+
+IOServicePool::IOServicePool(size_t threads,
+	std::function<void(std::exception_ptr)> errorCallback):
+	service_(), work_(new boost::asio::io_service::work(service_)), threads_(),
+	errorCallback_(errorCallback)
+{
+	assert(threads > 0);
+	assert(errorCallback_);
+
+	for (size_t i = 0; i < threads; i++)
+	{
+		threads_.push_back(std::thread(&IOServicePool::run, this));
+	}
+	BOOST_LOG_TRIVIAL(debug) << "Started " << threads << " network thread(s)";
+}
+
+IOServicePool::~IOServicePool()
+{
+	work_.reset();
+	service_.stop();
+	for (auto it = threads_.begin(); it != threads_.end(); ++it)
+	{
+		it->join();
+	}
+}
+
+boost::asio::io_service &
+IOServicePool::getIOService()
+{
+	return service_;
+}
+
+size_t
+IOServicePool::getNumberOfThreads() const
+{
+	return threads_.size();
+}
+
+void
+IOServicePool::run()
+{
+	for (;;)
+	{
+		try
+		{
+			service_.run();
+			return;
+		} catch (std::exception &ex) {
+			BOOST_LOG_TRIVIAL(debug) << "A network handler terminated by throwing "
+				"an exception: " << ex.what();
+			errorCallback_(std::current_exception());
+		} catch (...) {
+			errorCallback_(std::current_exception());
+		}
+	}
+}
+
+ChannelStrand::ChannelStrand(boost::asio::io_service &service):
+	strand_(service), mutex_(), idle_(), pending_(0)
+{
+}
+
+void
+ChannelStrand::waitUntilIdle()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	idle_.wait(lock, [this]() { return pending_ == 0; });
+}
+
+void
+ChannelStrand::acquire()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	pending_++;
+}
+
+void
+ChannelStrand::release()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	assert(pending_ > 0);
+	pending_--;
+	if (pending_ == 0)
+	{
+		idle_.notify_all();
+	}
+}
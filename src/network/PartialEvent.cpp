@@ -25,7 +25,7 @@ PartialEvent::PartialEvent(fmiTime time,
 	var_.reserve(portTemplate.size());
 }
 
-std::vector<Timing::Variable> PartialEvent::getVariables()
+const std::vector<Timing::Variable> & PartialEvent::getVariables()
 {
 	return var_;
 }
@@ -50,6 +50,12 @@ FMIVariableType PartialEvent::getNextPortType() const
 	return portTemplate_[nextTemplateIndex_].first;
 }
 
+unsigned int PartialEvent::getNextPortIndex() const
+{
+	assert(hasRemainingElements());
+	return nextTemplateIndex_;
+}
+
 void PartialEvent::pushNextValue(boost::any value)
 {
 	assert(hasRemainingElements());
@@ -0,0 +1,200 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file UDPTransmitter.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "network/UDPTransmitter.h"
+#include "network/CompactASN1Publisher.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+#include <boost/log/trivial.hpp>
+
+using namespace FMITerminalBlock::Network;
+
+UDPTransmitter::UDPTransmitter(): service_(), socketV4_(), socketV6_(),
+	slots_(), pendingSlots_()
+{
+}
+
+size_t
+UDPTransmitter::addDestination(const udp::endpoint &destination)
+{
+	std::unique_ptr<udp::socket> &socket =
+		destination.address().is_v6() ? socketV6_ : socketV4_;
+	if (!socket)
+	{
+		socket.reset(new udp::socket(service_));
+		socket->open(destination.protocol());
+	}
+
+	Slot slot;
+	slot.destination = destination;
+	slot.socket = socket.get();
+	slot.pending = false;
+	slots_.push_back(slot);
+
+	pendingSlots_.reserve(slots_.size());
+#ifdef __linux__
+	messages_.reserve(slots_.size());
+	dataVectors_.reserve(slots_.size());
+	messageSlots_.reserve(slots_.size());
+#endif
+
+	return slots_.size() - 1;
+}
+
+void
+UDPTransmitter::enqueue(size_t slot, const std::vector<uint8_t> &buffer)
+{
+	assert(slot < slots_.size());
+
+	// Keeps the capacity of the previous datagram
+	slots_[slot].datagram.assign(buffer.begin(), buffer.end());
+	if (!slots_[slot].pending)
+	{
+		slots_[slot].pending = true;
+		pendingSlots_.push_back(slot);
+	}
+}
+
+void
+UDPTransmitter::flush()
+{
+	if (pendingSlots_.empty()) return;
+
+	boost::system::error_code err, v6Err;
+	if (socketV4_) err = flush(socketV4_.get());
+	if (socketV6_) v6Err = flush(socketV6_.get());
+	if (!err) err = v6Err;
+
+	for (auto it = pendingSlots_.begin(); it != pendingSlots_.end(); ++it)
+	{
+		slots_[*it].pending = false;
+	}
+	pendingSlots_.clear();
+
+	// Report the failure as a single publisher's send_to call would do
+	if (err) throw boost::system::system_error(err);
+}
+
+void
+UDPTransmitter::eventTriggered(Timing::Event *)
+{
+	flush();
+}
+
+#ifdef __linux__
+
+boost::system::error_code
+UDPTransmitter::flush(udp::socket * socket)
+{
+	assert(socket != NULL);
+
+	messages_.clear();
+	dataVectors_.clear();
+	messageSlots_.clear();
+	for (auto it = pendingSlots_.begin(); it != pendingSlots_.end(); ++it)
+	{
+		Slot &slot = slots_[*it];
+		if (slot.socket != socket) continue;
+
+		struct iovec data;
+		data.iov_base = slot.datagram.data();
+		data.iov_len = slot.datagram.size();
+		dataVectors_.push_back(data);
+
+		struct mmsghdr message;
+		memset(&message, 0, sizeof(message));
+		message.msg_hdr.msg_name = slot.destination.data();
+		message.msg_hdr.msg_namelen = (socklen_t) slot.destination.size();
+		messages_.push_back(message);
+		messageSlots_.push_back(*it);
+	}
+
+	// The data vectors don't move after they were populated
+	for (unsigned i = 0; i < messages_.size(); i++)
+	{
+		messages_[i].msg_hdr.msg_iov = &dataVectors_[i];
+		messages_[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	boost::system::error_code firstErr;
+	unsigned sent = 0;
+	while (sent < messages_.size())
+	{
+		int ret = ::sendmmsg(socket->native_handle(), &messages_[sent],
+			(unsigned) (messages_.size() - sent), 0);
+		if (ret < 0)
+		{
+			if (errno == EINTR) continue;
+
+			// Skip the failing message only and send the remaining ones
+			boost::system::error_code err(errno, boost::system::system_category());
+			BOOST_LOG_TRIVIAL(warning) << "Could not send UDP message "
+				<< CompactASN1Publisher::toString(slots_[messageSlots_[sent]].datagram)
+				<< ": " << err.message();
+			if (!firstErr) firstErr = err;
+			sent++;
+			continue;
+		}
+
+		for (unsigned i = sent; i < sent + (unsigned) ret; i++)
+		{
+			logTransmission(slots_[messageSlots_[i]], messages_[i].msg_len);
+		}
+		sent += (unsigned) ret;
+	}
+	return firstErr;
+}
+
+#else
+
+boost::system::error_code
+UDPTransmitter::flush(udp::socket * socket)
+{
+	assert(socket != NULL);
+
+	boost::system::error_code firstErr;
+	for (auto it = pendingSlots_.begin(); it != pendingSlots_.end(); ++it)
+	{
+		Slot &slot = slots_[*it];
+		if (slot.socket != socket) continue;
+
+		boost::system::error_code err;
+		size_t trSize = socket->send_to(boost::asio::buffer(slot.datagram),
+			slot.destination, 0, err);
+		if (err)
+		{
+			BOOST_LOG_TRIVIAL(warning) << "Could not send UDP message: "
+				<< err.message();
+			if (!firstErr) firstErr = err;
+		} else {
+			logTransmission(slot, trSize);
+		}
+	}
+	return firstErr;
+}
+
+#endif
+
+void
+UDPTransmitter::logTransmission(const Slot &slot, size_t transferred) const
+{
+	if (transferred != slot.datagram.size())
+	{
+		BOOST_LOG_TRIVIAL(warning) << "UDP message "
+			<< CompactASN1Publisher::toString(slot.datagram)
+			<< " was only partly transferred (" << transferred << "/"
+			<< slot.datagram.size() << " bytes)";
+	} else {
+		BOOST_LOG_TRIVIAL(trace) << "Compact ASN.1 message sent: "
+			<< CompactASN1Publisher::toString(slot.datagram);
+	}
+}
@@ -0,0 +1,292 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file AsyncStreamWriter.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "timing/AsyncStreamWriter.h"
+
+#include <assert.h>
+#include <stdexcept>
+#include <boost/log/trivial.hpp>
+
+#include "base/BaseExceptions.h"
+
+using namespace FMITerminalBlock::Timing;
+
+const std::string AsyncStreamWriter::PROP_FLUSH = "flush";
+const std::string AsyncStreamWriter::PROP_FLUSH_INTERVAL = "flushInterval";
+const std::string AsyncStreamWriter::PROP_BUFFER_SIZE = "bufferSize";
+const std::string AsyncStreamWriter::PROP_BACKLOG = "backlog";
+const std::string AsyncStreamWriter::PROP_OVERFLOW = "overflow";
+
+const char * AsyncStreamWriter::FLUSH_POLICY_NAMES[3] = {
+	"row", "interval", "size"
+};
+
+const char * AsyncStreamWriter::OVERFLOW_POLICY_NAMES[2] = {
+	"block", "drop"
+};
+
+AsyncStreamWriter::AsyncStreamWriter(std::ostream &destination,
+	const Base::ApplicationContext &context, const std::string &prefix):
+	destination_(destination), flushPolicy_(FLUSH_ROW),
+	flushInterval_((int) DEFAULT_FLUSH_INTERVAL),
+	bufferSize_(DEFAULT_BUFFER_SIZE), backlog_(DEFAULT_BACKLOG),
+	overflowPolicy_(BLOCK), buffer_(), records_(0),
+	lastHandOver_(std::chrono::steady_clock::now()), queue_(), spareBuffers_(),
+	mutex_(), queueNotEmpty_(), written_(), writing_(false), terminate_(false),
+	error_(), droppedRecords_(0), writerThread_()
+{
+	initConfiguration(context, prefix);
+	setBuffer(std::string());
+	writerThread_ = std::thread(&AsyncStreamWriter::run, this);
+}
+
+AsyncStreamWriter::~AsyncStreamWriter()
+{
+	try
+	{
+		handOver();
+	} catch (std::exception &ex) {
+		BOOST_LOG_TRIVIAL(warning) << "Could not write all buffered data: "
+			<< ex.what();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		terminate_ = true;
+	}
+	queueNotEmpty_.notify_all();
+	writerThread_.join();
+
+	if (error_)
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Could not write the last buffered data";
+	}
+}
+
+void
+AsyncStreamWriter::endRecord()
+{
+	records_++;
+
+	bool due = true;
+	switch (flushPolicy_)
+	{
+	case FLUSH_ROW:
+		break;
+	case FLUSH_INTERVAL:
+		due = std::chrono::steady_clock::now() - lastHandOver_ >= flushInterval_;
+		break;
+	case FLUSH_SIZE:
+		due = getBufferedSize() >= bufferSize_;
+		break;
+	default:
+		assert(false);
+	}
+
+	if (due) handOver();
+}
+
+void
+AsyncStreamWriter::flush()
+{
+	handOver();
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	written_.wait(lock, [this]() { return queue_.empty() && !writing_; });
+	if (error_)
+	{
+		std::exception_ptr err = error_;
+		error_ = std::exception_ptr();
+		std::rethrow_exception(err);
+	}
+}
+
+size_t
+AsyncStreamWriter::getDroppedRecords()
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	return droppedRecords_;
+}
+
+AsyncStreamWriter::int_type
+AsyncStreamWriter::overflow(int_type c)
+{
+	size_t used = getBufferedSize();
+	buffer_.resize(2 * buffer_.size());
+	setp(&buffer_[0], &buffer_[0] + buffer_.size());
+	pbump((int) used);
+
+	if (!traits_type::eq_int_type(c, traits_type::eof()))
+	{
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+void
+AsyncStreamWriter::initConfiguration(const Base::ApplicationContext &context,
+	const std::string &prefix)
+{
+	std::string key = prefix + "." + PROP_FLUSH;
+	std::string policy = context.getProperty<std::string>(key,
+		FLUSH_POLICY_NAMES[FLUSH_ROW]);
+	bool found = false;
+	for (unsigned i = 0; i < 3; i++)
+	{
+		if (policy == FLUSH_POLICY_NAMES[i])
+		{
+			flushPolicy_ = (FlushPolicy) i;
+			found = true;
+		}
+	}
+	if (!found)
+	{
+		throw Base::SystemConfigurationException("Unknown flush policy", key,
+			policy);
+	}
+
+	key = prefix + "." + PROP_OVERFLOW;
+	policy = context.getProperty<std::string>(key, OVERFLOW_POLICY_NAMES[BLOCK]);
+	found = false;
+	for (unsigned i = 0; i < 2; i++)
+	{
+		if (policy == OVERFLOW_POLICY_NAMES[i])
+		{
+			overflowPolicy_ = (OverflowPolicy) i;
+			found = true;
+		}
+	}
+	if (!found)
+	{
+		throw Base::SystemConfigurationException("Unknown overflow policy", key,
+			policy);
+	}
+
+	flushInterval_ = std::chrono::milliseconds(
+		context.getRealPositiveIntegerProperty(prefix + "." + PROP_FLUSH_INTERVAL,
+			DEFAULT_FLUSH_INTERVAL));
+	bufferSize_ = (size_t) context.getRealPositiveIntegerProperty(
+		prefix + "." + PROP_BUFFER_SIZE, (int) DEFAULT_BUFFER_SIZE);
+	backlog_ = (size_t) context.getRealPositiveIntegerProperty(
+		prefix + "." + PROP_BACKLOG, (int) DEFAULT_BACKLOG);
+}
+
+size_t
+AsyncStreamWriter::getBufferedSize() const
+{
+	return (size_t) (pptr() - pbase());
+}
+
+void
+AsyncStreamWriter::setBuffer(std::string &&buffer)
+{
+	buffer_ = std::move(buffer);
+	if (buffer_.size() < bufferSize_)
+	{
+		buffer_.resize(bufferSize_);
+	}
+	setp(&buffer_[0], &buffer_[0] + buffer_.size());
+	records_ = 0;
+}
+
+void
+AsyncStreamWriter::handOver()
+{
+	lastHandOver_ = std::chrono::steady_clock::now();
+	size_t used = getBufferedSize();
+	if (used == 0) return;
+
+	std::unique_lock<std::mutex> lock(mutex_);
+	if (error_)
+	{
+		std::exception_ptr err = error_;
+		error_ = std::exception_ptr();
+		std::rethrow_exception(err);
+	}
+
+	if (queue_.size() >= backlog_)
+	{
+		switch (overflowPolicy_)
+		{
+		case BLOCK:
+			written_.wait(lock, [this]() { return queue_.size() < backlog_; });
+			break;
+		case DROP:
+			BOOST_LOG_TRIVIAL(warning) << "The write backlog is full. Drop "
+				<< records_ << " buffered record(s)";
+			droppedRecords_ += records_;
+			// Reuse the current buffer
+			setp(&buffer_[0], &buffer_[0] + buffer_.size());
+			records_ = 0;
+			return;
+		default:
+			assert(false);
+		}
+	}
+
+	queue_.push_back(Chunk());
+	queue_.back().data = std::move(buffer_);
+	queue_.back().size = used;
+
+	std::string next;
+	if (!spareBuffers_.empty())
+	{
+		next = std::move(spareBuffers_.back());
+		spareBuffers_.pop_back();
+	}
+	lock.unlock();
+	queueNotEmpty_.notify_one();
+
+	setBuffer(std::move(next));
+}
+
+void
+AsyncStreamWriter::run()
+{
+	std::deque<Chunk> batch;
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (;;)
+	{
+		queueNotEmpty_.wait(lock, [this]() { return !queue_.empty() ||
+			terminate_; });
+		// Every buffer is written before the thread terminates
+		if (queue_.empty()) return;
+
+		batch.swap(queue_);
+		writing_ = true;
+		lock.unlock();
+		written_.notify_all();
+
+		for (auto it = batch.begin(); it != batch.end(); ++it)
+		{
+			destination_.write(it->data.data(), (std::streamsize) it->size);
+		}
+		destination_.flush();
+		bool failed = destination_.fail();
+
+		lock.lock();
+		for (auto it = batch.begin(); it != batch.end(); ++it)
+		{
+			if (spareBuffers_.size() <= backlog_)
+			{
+				spareBuffers_.push_back(std::move(it->data));
+			}
+		}
+		batch.clear();
+		writing_ = false;
+		if (failed && !error_)
+		{
+			error_ = std::make_exception_ptr(std::runtime_error("Could not write "
+				"the buffered data to the destination stream"));
+		}
+		written_.notify_all();
+	}
+}
@@ -0,0 +1,134 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file BinaryDataLogger.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "timing/BinaryDataLogger.h"
+
+#include <assert.h>
+#include <stdexcept>
+#include <boost/log/trivial.hpp>
+
+#include "base/BaseExceptions.h"
+
+using namespace FMITerminalBlock::Timing;
+
+const std::string BinaryDataLogger::PROP_FILE_NAME = "app.dataFile";
+
+const char BinaryDataLogger::MAGIC[8] = {
+	'F', 'M', 'I', 'T', 'B', 'D', 'A', 'T'
+};
+
+BinaryDataLogger::BinaryDataLogger(std::ostream &destination,
+	Base::ApplicationContext &context):
+	outputFileStream_(), writer_(), layout_(), record_()
+{
+	// The flush properties are stored below the file name
+	if (!context.getProperty<std::string>(PROP_FILE_NAME, "").empty())
+	{
+		throw Base::SystemConfigurationException("The data file name must not be "
+			"specified while externally setting the data destination.");
+	}
+	init(destination, context);
+}
+
+BinaryDataLogger::BinaryDataLogger(Base::ApplicationContext &context):
+	outputFileStream_(), writer_(), layout_(), record_()
+{
+	std::string filename = context.getProperty<std::string>(PROP_FILE_NAME, "");
+	if (!filename.empty())
+	{
+		openFileStream(filename);
+		init(*outputFileStream_, context);
+	}
+}
+
+BinaryDataLogger::~BinaryDataLogger()
+{
+	// Write all buffered records before closing the file
+	writer_.reset();
+
+	if (outputFileStream_ && outputFileStream_->is_open())
+	{
+		try {
+			outputFileStream_->close();
+		} catch (...) {
+			BOOST_LOG_TRIVIAL(warning) << "Unable to close the opened data file";
+		}
+	}
+}
+
+void BinaryDataLogger::eventTriggered(Event * ev)
+{
+	assert(ev != NULL);
+
+	if (!writer_) return;
+
+	layout_.encode(ev, &record_[0]);
+	append(&record_[0], record_.size());
+
+	// The characters of the strings follow in the order of their columns
+	for (unsigned i = 0; i < layout_.getStringColumns().size(); i++)
+	{
+		const Variable *var = layout_.getString(i);
+		if (var != NULL)
+		{
+			const std::string &value = var->getStringValue();
+			append(value.data(), value.size());
+		}
+	}
+
+	writer_->endRecord();
+}
+
+void BinaryDataLogger::openFileStream(const std::string &filename)
+{
+	assert(!outputFileStream_);
+
+	outputFileStream_ = std::unique_ptr<std::ofstream>(new std::ofstream(
+		filename, std::ios_base::trunc | std::ios_base::out |
+		std::ios_base::binary));
+	if (outputFileStream_->fail())
+	{
+		outputFileStream_.reset();
+		throw Base::SystemConfigurationException(
+			"Couldn't open data file for writing.", PROP_FILE_NAME, filename);
+	}
+}
+
+void BinaryDataLogger::init(std::ostream &destination,
+	Base::ApplicationContext &context)
+{
+	assert(!writer_);
+
+	writer_ = std::unique_ptr<AsyncStreamWriter>(new AsyncStreamWriter(
+		destination, context, PROP_FILE_NAME));
+
+	// The mappings are created in order. Hence, the PortIDs are stable.
+	const Base::ChannelMapping *inChannelMapping =
+		context.getInputChannelMapping();
+	const Base::ChannelMapping *outChannelMapping =
+		context.getOutputChannelMapping();
+	layout_.init(inChannelMapping, outChannelMapping);
+	record_.assign(layout_.getSize(), 0);
+
+	const std::vector<char> header = layout_.makeHeader(MAGIC);
+	append(header.data(), header.size());
+	try
+	{
+		writer_->flush();
+	} catch (std::runtime_error&) {
+		throw Base::SystemConfigurationException("Cannot write to data file");
+	}
+}
+
+void BinaryDataLogger::append(const char *data, size_t length)
+{
+	assert(writer_);
+	writer_->sputn(data, (std::streamsize) length);
+}
@@ -0,0 +1,176 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file BinaryRecord.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "timing/BinaryRecord.h"
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+
+using namespace FMITerminalBlock::Timing;
+
+BinaryRecord::BinaryRecord(): header_(), names_(), columns_(), offsets_(),
+	stringColumns_(), strings_(), size_(TIME_SIZE)
+{
+}
+
+void BinaryRecord::init(const Base::ChannelMapping *inChannelMapping,
+	const Base::ChannelMapping *outChannelMapping)
+{
+	assert(inChannelMapping != NULL);
+	assert(outChannelMapping != NULL);
+
+	header_ = inChannelMapping->getAllVariableIDs();
+	auto allVarIDs = outChannelMapping->getAllVariableIDs();
+	header_.insert(header_.end(), allVarIDs.begin(), allVarIDs.end());
+	columns_.init(header_);
+
+	names_ = inChannelMapping->getAllVariableNames();
+	auto allVarNames = outChannelMapping->getAllVariableNames();
+	names_.insert(names_.end(), allVarNames.begin(), allVarNames.end());
+	assert(names_.size() == header_.size());
+
+	initLayout();
+}
+
+void BinaryRecord::encode(Event * ev, char *record)
+{
+	assert(ev != NULL);
+	assert(record != NULL);
+
+	memset(record, 0, size_);
+	std::fill(strings_.begin(), strings_.end(), (const Variable *) NULL);
+
+	const double time = ev->getTime();
+	memcpy(record, &time, TIME_SIZE);
+
+	// Set the present bit and the value of each column. The first occurrence
+	// wins.
+	unsigned char *present = (unsigned char *) (record + PRESENT_OFFSET);
+	const auto &variables = ev->getVariables();
+	for (auto it = variables.begin(); it != variables.end(); ++it)
+	{
+		for (int col = columns_.getFirstColumn(it->getID()); col >= 0;
+			col = columns_.getNextColumn(col))
+		{
+			const unsigned char mask = (unsigned char) (1u << (col % 8));
+			if ((present[col / 8] & mask) == 0)
+			{
+				present[col / 8] |= mask;
+				setValue(record, col, *it);
+			}
+		}
+	}
+}
+
+std::vector<char> BinaryRecord::makeHeader(const char magic[8],
+	uint32_t reserved) const
+{
+	std::vector<char> columns(reserved, 0);
+	for (unsigned i = 0; i < header_.size(); i++)
+	{
+		append(columns, (uint32_t) header_[i].first);
+		append(columns, (uint32_t) header_[i].second);
+		append(columns, offsets_[i]);
+		append(columns, (uint32_t) names_[i].size());
+		columns.insert(columns.end(), names_[i].begin(), names_[i].end());
+	}
+	// Align the first record
+	columns.resize((columns.size() + 7) / 8 * 8, 0);
+
+	std::vector<char> ret(magic, magic + 8);
+	append(ret, BYTE_ORDER_MARK);
+	append(ret, FORMAT_VERSION);
+	append(ret, (uint32_t) header_.size());
+	append(ret, size_);
+	append(ret, (uint32_t) (HEADER_SIZE + columns.size()));
+	append(ret, (uint32_t) 0); // Reserved, aligns the column list
+	assert(ret.size() == HEADER_SIZE);
+	ret.insert(ret.end(), columns.begin(), columns.end());
+	return ret;
+}
+
+void BinaryRecord::initLayout()
+{
+	offsets_.clear();
+	stringColumns_.clear();
+
+	uint32_t offset = PRESENT_OFFSET + (uint32_t) ((header_.size() + 7) / 8);
+	for (unsigned i = 0; i < header_.size(); i++)
+	{
+		// Align each value to its size
+		const uint32_t size = getValueSize(header_[i].first);
+		if (size > 0) offset = (offset + size - 1) / size * size;
+		offsets_.push_back(offset);
+		offset += size;
+
+		if (header_[i].first == fmiTypeString) stringColumns_.push_back(i);
+	}
+
+	strings_.assign(stringColumns_.size(), NULL);
+	size_ = (offset + TIME_SIZE - 1) / TIME_SIZE * TIME_SIZE;
+}
+
+void BinaryRecord::setValue(char *record, int column, const Variable &var)
+{
+	char *value = record + offsets_[column];
+	switch (var.getID().first)
+	{
+	case fmiTypeReal:
+		{
+			const double real = var.getRealValue();
+			memcpy(value, &real, sizeof(real));
+		}
+		break;
+	case fmiTypeInteger:
+		{
+			const int32_t integer = var.getIntegerValue();
+			memcpy(value, &integer, sizeof(integer));
+		}
+		break;
+	case fmiTypeBoolean:
+		*value = var.getBooleanValue() ? 1 : 0;
+		break;
+	case fmiTypeString:
+		{
+			const uint32_t length = (uint32_t) var.getStringValue().size();
+			memcpy(value, &length, sizeof(length));
+
+			// The string columns are ordered by their column number
+			auto it = std::lower_bound(stringColumns_.begin(),
+				stringColumns_.end(), column);
+			assert(it != stringColumns_.end() && *it == column);
+			strings_[it - stringColumns_.begin()] = &var;
+		}
+		break;
+	case fmiTypeUnknown:
+		break;
+	default:
+		assert(false);
+	}
+}
+
+void BinaryRecord::append(std::vector<char> &dest, uint32_t value)
+{
+	const char *begin = (const char *) &value;
+	dest.insert(dest.end(), begin, begin + sizeof(value));
+}
+
+uint32_t BinaryRecord::getValueSize(FMIVariableType type)
+{
+	switch (type)
+	{
+	case fmiTypeReal: return 8;
+	case fmiTypeInteger: return 4;
+	case fmiTypeBoolean: return 1;
+	case fmiTypeString: return 4;
+	default: return 0;
+	}
+}
@@ -10,6 +10,7 @@
 
 #include "timing/CSVDataLogger.h"
 
+#include <stdexcept>
 #include <boost/log/trivial.hpp>
 
 #include "base/BaseExceptions.h"
@@ -17,6 +18,8 @@
 using namespace FMITerminalBlock::Timing;
 
 const std::string CSVDataLogger::PROP_CSV_FILE_NAME = "app.dataFile";
+const std::string CSVDataLogger::PROP_CSV_PRECISION = 
+	"app.dataFile.precision";
 
 const char* CSVDataLogger::FMI_TYPE_NAMES[] = {
 	"fmiReal","fmiInteger","fmiBoolean","fmiString","fmiUnknown"
@@ -24,24 +27,32 @@ const char* CSVDataLogger::FMI_TYPE_NAMES[] = {
 
 CSVDataLogger::CSVDataLogger(std::ostream &destination,
 	Base::ApplicationContext &context): 
-	outputFileStream_(), header_(), outputStream_(NULL)
+	outputFileStream_(), writer_(), bufferStream_(), formatter_(), header_(),
+	columns_(), row_(), outputStream_(NULL)
 {
-	if (context.hasProperty(PROP_CSV_FILE_NAME))
+	// The flush properties are stored below the file name
+	if (!context.getProperty<std::string>(PROP_CSV_FILE_NAME, "").empty())
 	{
 		throw Base::SystemConfigurationException("The CSV file name must not be "
 			"specified while externally setting the data destination.");
 	}
-	outputStream_ = &destination;
+	initFormatter(context);
+	initWriter(destination, context);
 	initHeader(context.getInputChannelMapping(), 
 		context.getOutputChannelMapping());
 }
 
 CSVDataLogger::CSVDataLogger(Base::ApplicationContext &context): 
-	outputFileStream_(), header_(), outputStream_(NULL)
+	outputFileStream_(), writer_(), bufferStream_(), formatter_(), header_(),
+	columns_(), row_(), outputStream_(NULL)
 {
-	if (context.hasProperty(PROP_CSV_FILE_NAME))
+	std::string filename = context.getProperty<std::string>(PROP_CSV_FILE_NAME,
+		"");
+	if (!filename.empty())
 	{
-		openFileStream(context.getProperty<std::string>(PROP_CSV_FILE_NAME));
+		initFormatter(context);
+		openFileStream(filename);
+		initWriter(*outputFileStream_, context);
 		initHeader(context.getInputChannelMapping(), 
 		context.getOutputChannelMapping());
 	}
@@ -49,6 +60,11 @@ CSVDataLogger::CSVDataLogger(Base::ApplicationContext &context):
 
 CSVDataLogger::~CSVDataLogger()
 {
+	// Write all buffered rows before closing the file
+	outputStream_ = NULL;
+	bufferStream_.reset();
+	writer_.reset();
+
 	if (outputFileStream_ && outputFileStream_->is_open())
 	{
 		try {
@@ -66,24 +82,34 @@ void CSVDataLogger::eventTriggered(Event * ev)
 	if (outputStream_ == NULL) return;
 
 	auto &out = *outputStream_;
-	out << ev->getTime() << SEPARATOR;
+	append(ev->getTime());
+	out << SEPARATOR;
 	
-	auto variables = ev->getVariables();
+	// Scatter the variables into their columns. The first occurrence wins.
+	const auto &variables = ev->getVariables();
+	for (auto it = variables.begin(); it != variables.end(); ++it)
+	{
+		for (int col = columns_.getFirstColumn(it->getID()); col >= 0; 
+			col = columns_.getNextColumn(col))
+		{
+			if (row_[col] == NULL) row_[col] = &(*it);
+		}
+	}
+
 	for (unsigned i = 0; i < header_.size(); i++)
 	{
-		auto var = findVariable(header_[i], variables);
-		append(var);
+		append(row_[i]);
+		row_[i] = NULL;
 		if ((i + 1) < header_.size()) out << SEPARATOR;
 	}
 
 	out << '\n';
-	out.flush();
+	writer_->endRecord();
 }
 
 void CSVDataLogger::openFileStream(const std::string &filename)
 {
 	assert(!outputFileStream_);
-	assert(!outputStream_);
 
 	outputFileStream_ = std::unique_ptr<std::ofstream>(
 		new std::ofstream(filename, std::ios_base::trunc | std::ios_base::out));
@@ -93,8 +119,38 @@ void CSVDataLogger::openFileStream(const std::string &filename)
 		throw Base::SystemConfigurationException(
 			"Couldn't open CSV file for writing.", PROP_CSV_FILE_NAME, filename);
 	}
+}
 
-	outputStream_ = outputFileStream_.get();
+void CSVDataLogger::initFormatter(const Base::ApplicationContext &context)
+{
+	int precision;
+	try
+	{
+		precision = context.getProperty<int>(PROP_CSV_PRECISION, 
+			RealFormatter::SHORTEST);
+	} catch (std::invalid_argument&) {
+		precision = -1;
+	}
+	if (precision < 0 || precision > RealFormatter::MAX_PRECISION)
+	{
+		throw Base::SystemConfigurationException("The precision must be a number "
+			"of significant digits between 1 and 17 or 0", PROP_CSV_PRECISION,
+			context.getProperty<std::string>(PROP_CSV_PRECISION));
+	}
+	formatter_ = RealFormatter(precision);
+}
+
+void CSVDataLogger::initWriter(std::ostream &destination, 
+	Base::ApplicationContext &context)
+{
+	assert(!writer_);
+	assert(!outputStream_);
+
+	writer_ = std::unique_ptr<AsyncStreamWriter>(new AsyncStreamWriter(
+		destination, context, PROP_CSV_FILE_NAME));
+	bufferStream_ = std::unique_ptr<std::ostream>(new std::ostream(
+		writer_.get()));
+	outputStream_ = bufferStream_.get();
 }
 
 void CSVDataLogger::initHeader(const Base::ChannelMapping *inChannelMapping,
@@ -111,6 +167,8 @@ void CSVDataLogger::initHeader(const Base::ChannelMapping *inChannelMapping,
 	header_.insert(header_.end(), allVarIDs.begin(), allVarIDs.end());
 	allVarIDs = outChannelMapping->getAllVariableIDs();
 	header_.insert(header_.end(), allVarIDs.begin(), allVarIDs.end());
+	columns_.init(header_);
+	row_.assign(header_.size(), NULL);
 
 	auto nameHeader = inChannelMapping->getAllVariableNames();
 	auto allVarNames = outChannelMapping->getAllVariableNames();
@@ -118,10 +176,10 @@ void CSVDataLogger::initHeader(const Base::ChannelMapping *inChannelMapping,
 
 	// Write the content to the CSV file
 	appendHeader(nameHeader, header_);
-	outputStream_->flush();
-
-	if (outputStream_->fail())
+	try
 	{
+		writer_->flush();
+	} catch (std::runtime_error&) {
 		throw Base::SystemConfigurationException("Cannot write to CSV data file");
 	}
 }
@@ -188,7 +246,7 @@ void CSVDataLogger::append(const std::string &value)
 	out << '"';
 }
 
-void CSVDataLogger::append(boost::optional<Variable> var)
+void CSVDataLogger::append(const Variable *var)
 {
 	assert(outputStream_ != NULL);
 	auto &out = *outputStream_;
@@ -198,7 +256,7 @@ void CSVDataLogger::append(boost::optional<Variable> var)
 		switch (var->getID().first)
 		{
 			case fmiTypeReal: 
-				out << var->getRealValue(); break;
+				append(var->getRealValue()); break;
 			case fmiTypeInteger:
 				out << var->getIntegerValue(); break;
 			case fmiTypeBoolean:
@@ -213,19 +271,12 @@ void CSVDataLogger::append(boost::optional<Variable> var)
 	}
 }
 
-boost::optional<Variable> CSVDataLogger::findVariable(Base::PortID id,
-	const std::vector<Variable> &variables)
+void CSVDataLogger::append(double value)
 {
-	boost::optional<Variable> ret;
-
-	for (auto it = variables.begin(); it != variables.end(); ++it)
-	{
-		if (it->getID() == id)
-		{
-			ret = *it;
-			return ret;
-		}
-	}
+	assert(writer_);
 
-	return ret;
+	// Bypass the stream and write the characters to the buffer directly
+	char buffer[RealFormatter::BUFFER_SIZE];
+	size_t length = formatter_.format(value, buffer);
+	writer_->sputn(buffer, (std::streamsize) length);
 }
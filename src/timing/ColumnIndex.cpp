@@ -0,0 +1,51 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file ColumnIndex.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "timing/ColumnIndex.h"
+
+#include <assert.h>
+
+using namespace FMITerminalBlock::Timing;
+
+ColumnIndex::ColumnIndex(): firstColumn_(), nextColumn_()
+{
+}
+
+void ColumnIndex::init(const std::vector<Base::PortID> &columns)
+{
+	firstColumn_.clear();
+	nextColumn_.assign(columns.size(), -1);
+
+	// Iterate backwards to chain the columns of each port in ascending order
+	for (int col = ((int) columns.size()) - 1; col >= 0; col--)
+	{
+		const unsigned int type = (unsigned int) columns[col].first;
+		const int id = columns[col].second;
+		assert(id >= 0);
+
+		if (type >= firstColumn_.size()) firstColumn_.resize(type + 1);
+		std::vector<int> &first = firstColumn_[type];
+		if (((unsigned int) id) >= first.size()) first.resize(id + 1, -1);
+
+		nextColumn_[col] = first[id];
+		first[id] = col;
+	}
+}
+
+int ColumnIndex::getFirstColumn(const Base::PortID &id) const
+{
+	const unsigned int type = (unsigned int) id.first;
+	if (type >= firstColumn_.size() || id.second < 0 ||
+		((unsigned int) id.second) >= firstColumn_[type].size())
+	{
+		return -1;
+	}
+	return firstColumn_[type][id.second];
+}
@@ -0,0 +1,40 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file DataLoggerFactory.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "timing/DataLoggerFactory.h"
+
+#include "timing/BinaryDataLogger.h"
+#include "timing/CSVDataLogger.h"
+#include "timing/RingDataLogger.h"
+#include "base/BaseExceptions.h"
+
+using namespace FMITerminalBlock::Timing;
+
+const std::string DataLoggerFactory::PROP_DATA_FILE_FORMAT = 
+	"app.dataFile.format";
+
+std::shared_ptr<EventListener>
+DataLoggerFactory::makeDataLogger(Base::ApplicationContext &appContext)
+{
+	std::string format;
+	format = appContext.getProperty<std::string>(PROP_DATA_FILE_FORMAT, "csv");
+
+	if (format == "csv")
+	{
+		return std::make_shared<CSVDataLogger>(appContext);
+	} else if (format == "binary") {
+		return std::make_shared<BinaryDataLogger>(appContext);
+	} else if (format == "ring") {
+		return std::make_shared<RingDataLogger>(appContext);
+	} else {
+		throw Base::SystemConfigurationException("Invalid data file format "
+			"property", PROP_DATA_FILE_FORMAT, format);
+	}
+}
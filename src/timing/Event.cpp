@@ -9,6 +9,7 @@
  */
 
 #include "timing/Event.h"
+#include "timing/EventPool.h"
 
 #include <assert.h>
 #include <boost/any.hpp>
@@ -22,6 +23,18 @@ Event::Event(fmiTime time):time_(time)
 {
 }
 
+void *
+Event::operator new(std::size_t size)
+{
+	return EventPool::allocate(size);
+}
+
+void
+Event::operator delete(void * ptr, std::size_t size)
+{
+	EventPool::release(ptr, size);
+}
+
 std::string
 Event::toString(void) const
 {
@@ -36,8 +49,6 @@ bool Event::isValid(const std::vector<Variable> &values)
 {
 	for(unsigned i = 0; i < values.size(); i++)
 	{
-		const boost::any & val = values[i].getValue();
-
 		if (values[i].isTypeUnknown())
 		{
 			BOOST_LOG_TRIVIAL(debug) << "Value of unknown type in event variable list"
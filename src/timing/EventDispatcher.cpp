@@ -30,7 +30,7 @@ EventDispatcher::EventDispatcher(Base::ApplicationContext &context,
 	theEnd_ = context.getProperty<fmiTime>(PROP_STOP_TIME, DBL_MAX);
 
 	// Eventually loaded dynamically in future versions.
-	queue_ = std::make_shared<TimedEventQueue>();
+	queue_ = std::make_shared<TimedEventQueue>(context);
 
 	// Notify the predictor via the common event listener interface.
 	addEventListener(predictor);
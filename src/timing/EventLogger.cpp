@@ -22,6 +22,7 @@
 #include <boost/log/support/date_time.hpp>
 #include <fstream>
 #include <iomanip>
+#include <math.h>
 
 #include "base/LoggingAttributes.h"
 
@@ -30,14 +31,21 @@ using namespace FMITerminalBlock::Timing;
 using namespace boost::log;
 
 const std::string EventLogger::PROP_FILE_NAME = "app.timingFile";
-boost::system_time EventLogger::simulationEpoch_ = getAbsoluteRecordTimeNow();
+std::chrono::steady_clock::time_point EventLogger::simulationEpoch_ = 
+	getAbsoluteRecordTimeNow();
+boost::posix_time::ptime EventLogger::systemSimulationEpoch_ = 
+	getSystemEpoch(simulationEpoch_);
+bool EventLogger::eventFileSinkAdded_ = false;
 
 EventLogger::EventLogger(): 
 	channel_logger_mt(locationUndefined), eventTimeAttribute_(-1.0), 
-	recordTimeAttribute_(-1.0),	objectMutex_()
+	recordTimeAttribute_(-1.0),	
+	recordTimeStampAttribute_(boost::posix_time::not_a_date_time), 
+	objectMutex_()
 {
 	add_attribute(Base::ATTR_EVENT_TIME, eventTimeAttribute_);
 	add_attribute(Base::ATTR_TIMING_RECORD_TIME, recordTimeAttribute_);
+	add_attribute(Base::ATTR_TIMING_RECORD_TIMESTAMP, recordTimeStampAttribute_);
 }
 
 void 
@@ -60,7 +68,8 @@ EventLogger::addEventFileSink(const Base::ApplicationContext& context)
 
 		sink->set_formatter(
 			expressions::stream << std::setprecision(8) << std::fixed
-			<< expressions::format_date_time<boost::posix_time::ptime>("TimeStamp", "%w;%H;%M;%S.%f")
+			<< expressions::format_date_time<boost::posix_time::ptime>(
+				Base::ATTR_TIMING_RECORD_TIMESTAMP, "%w;%H;%M;%S.%f")
 			<< ";"
 			<< expressions::attr<fmiTime>(Base::ATTR_EVENT_TIME)
 			<< ";"
@@ -76,13 +85,16 @@ EventLogger::addEventFileSink(const Base::ApplicationContext& context)
 		sink->locked_backend()->auto_flush(true);
 
 		core::get()->add_sink(sink);
+		eventFileSinkAdded_ = true;
 	}
 }
 
 void 
-EventLogger::setGlobalSimulationEpoch(boost::system_time simulationEpoch)
+EventLogger::setGlobalSimulationEpoch(
+	std::chrono::steady_clock::time_point simulationEpoch)
 {
 	simulationEpoch_ = simulationEpoch;
+	systemSimulationEpoch_ = getSystemEpoch(simulationEpoch);
 }
 
 void 
@@ -90,6 +102,9 @@ EventLogger::logEvent(Event * ev, ProcessingStage stage)
 {
 	assert(ev != NULL);
 
+	// Setting the attributes allocates memory -> Skip it if nobody listens
+	if (!eventFileSinkAdded_) return;
+
 	// As early as possible -> Does not need a locked object as long as no other
 	// thread modifies the epoch base
 	fmiTime recordTime = getRelativeRecodTimeNow();
@@ -97,6 +112,8 @@ EventLogger::logEvent(Event * ev, ProcessingStage stage)
 
 	eventTimeAttribute_.set(ev->getTime());
 	recordTimeAttribute_.set(recordTime);
+	recordTimeStampAttribute_.set(systemSimulationEpoch_ + 
+		boost::posix_time::microseconds((int64_t) floor(recordTime * 1e6)));
 
 	record rec = open_record(keywords::channel = stage);
 	if(rec)
@@ -108,16 +125,26 @@ EventLogger::logEvent(Event * ev, ProcessingStage stage)
 	}
 }
 
-boost::system_time
+std::chrono::steady_clock::time_point
 EventLogger::getAbsoluteRecordTimeNow()
 {
-	return boost::posix_time::microsec_clock::universal_time();
+	return std::chrono::steady_clock::now();
+}
+
+boost::posix_time::ptime
+EventLogger::getSystemEpoch(std::chrono::steady_clock::time_point simulationEpoch)
+{
+	const std::chrono::steady_clock::time_point now = getAbsoluteRecordTimeNow();
+	const boost::posix_time::ptime systemNow = 
+		boost::posix_time::microsec_clock::local_time();
+	std::chrono::microseconds sinceEpoch = 
+		std::chrono::duration_cast<std::chrono::microseconds>(now - simulationEpoch);
+	return systemNow - boost::posix_time::microseconds(sinceEpoch.count());
 }
 
 fmiTime
 EventLogger::getRelativeRecodTimeNow()
 {
-	const boost::system_time now = getAbsoluteRecordTimeNow();
-	boost::posix_time::time_duration recordTime = now - simulationEpoch_;
-	return ((fmiTime) recordTime.ticks()) / recordTime.ticks_per_second();
+	const std::chrono::steady_clock::time_point now = getAbsoluteRecordTimeNow();
+	return std::chrono::duration<fmiTime>(now - simulationEpoch_).count();
 }
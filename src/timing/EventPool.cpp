@@ -0,0 +1,56 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file EventPool.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "timing/EventPool.h"
+
+#include <assert.h>
+#include <new>
+
+using namespace FMITerminalBlock::Timing;
+
+EventPool::FreeList EventPool::freeList_[EventPool::SIZE_CLASS_COUNT];
+
+void *
+EventPool::allocate(std::size_t size)
+{
+	std::size_t sizeClass = getSizeClass(size);
+	if (sizeClass >= SIZE_CLASS_COUNT)
+	{
+		return ::operator new(size);
+	}
+
+	void * ptr = NULL;
+	if (!freeList_[sizeClass].pop(ptr))
+	{
+		// Allocate the whole block to be able to reuse it
+		ptr = ::operator new((sizeClass + 1) * BLOCK_SIZE);
+	}
+	assert(ptr != NULL);
+	return ptr;
+}
+
+void
+EventPool::release(void * ptr, std::size_t size)
+{
+	if (ptr == NULL) return;
+
+	std::size_t sizeClass = getSizeClass(size);
+	if (sizeClass >= SIZE_CLASS_COUNT || !freeList_[sizeClass].bounded_push(ptr))
+	{
+		::operator delete(ptr);
+	}
+}
+
+std::size_t
+EventPool::getSizeClass(std::size_t size)
+{
+	if (size == 0) return 0;
+	return (size - 1) / BLOCK_SIZE;
+}
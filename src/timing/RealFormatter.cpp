@@ -0,0 +1,512 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file RealFormatter.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ * @details The Grisu2 implementation, i.e. the cached powers of ten, the
+ * boundary computation, generateDigits() and roundWeed(), is adapted from the
+ * to_chars implementation of JSON for Modern C++
+ * (https://github.com/nlohmann/json) which itself is based on the reference
+ * implementation of Florian Loitsch
+ * (http://florian.loitsch.com/publications). Both are distributed under the
+ * following license:
+ *
+ * MIT License
+ *
+ * Copyright (c) 2013-2017 Niels Lohmann <http://nlohmann.me>
+ * Copyright (c) 2009 Florian Loitsch
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "timing/RealFormatter.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace FMITerminalBlock::Timing;
+
+/**
+ * @brief A floating point value of a 64 bit significand and a binary
+ * exponent
+ */
+struct DiyFp
+{
+	uint64_t f;
+	int e;
+};
+
+/** @brief A normalized power of ten and its decimal exponent */
+struct CachedPower
+{
+	uint64_t f;
+	int e;
+	int k;
+};
+
+/** @brief The range of the binary exponent of the scaled values */
+static const int ALPHA = -60;
+static const int GAMMA = -32;
+
+/** @brief The first decimal exponent and the step of the cached powers */
+static const int CACHED_POWERS_MIN_DEC_EXP = -300;
+static const int CACHED_POWERS_DEC_STEP = 8;
+
+/** @brief The normalized powers 10^k, k = -300, -292, ..., 340 */
+static const CachedPower CACHED_POWERS[] = {
+	{ 0xAB70FE17C79AC6CAULL, -1060, -300 },
+	{ 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+	{ 0xBE5691EF416BD60CULL, -1007, -284 },
+	{ 0x8DD01FAD907FFC3CULL, -980, -276 },
+	{ 0xD3515C2831559A83ULL, -954, -268 },
+	{ 0x9D71AC8FADA6C9B5ULL, -927, -260 },
+	{ 0xEA9C227723EE8BCBULL, -901, -252 },
+	{ 0xAECC49914078536DULL, -874, -244 },
+	{ 0x823C12795DB6CE57ULL, -847, -236 },
+	{ 0xC21094364DFB5637ULL, -821, -228 },
+	{ 0x9096EA6F3848984FULL, -794, -220 },
+	{ 0xD77485CB25823AC7ULL, -768, -212 },
+	{ 0xA086CFCD97BF97F4ULL, -741, -204 },
+	{ 0xEF340A98172AACE5ULL, -715, -196 },
+	{ 0xB23867FB2A35B28EULL, -688, -188 },
+	{ 0x84C8D4DFD2C63F3BULL, -661, -180 },
+	{ 0xC5DD44271AD3CDBAULL, -635, -172 },
+	{ 0x936B9FCEBB25C996ULL, -608, -164 },
+	{ 0xDBAC6C247D62A584ULL, -582, -156 },
+	{ 0xA3AB66580D5FDAF6ULL, -555, -148 },
+	{ 0xF3E2F893DEC3F126ULL, -529, -140 },
+	{ 0xB5B5ADA8AAFF80B8ULL, -502, -132 },
+	{ 0x87625F056C7C4A8BULL, -475, -124 },
+	{ 0xC9BCFF6034C13053ULL, -449, -116 },
+	{ 0x964E858C91BA2655ULL, -422, -108 },
+	{ 0xDFF9772470297EBDULL, -396, -100 },
+	{ 0xA6DFBD9FB8E5B88FULL, -369, -92 },
+	{ 0xF8A95FCF88747D94ULL, -343, -84 },
+	{ 0xB94470938FA89BCFULL, -316, -76 },
+	{ 0x8A08F0F8BF0F156BULL, -289, -68 },
+	{ 0xCDB02555653131B6ULL, -263, -60 },
+	{ 0x993FE2C6D07B7FACULL, -236, -52 },
+	{ 0xE45C10C42A2B3B06ULL, -210, -44 },
+	{ 0xAA242499697392D3ULL, -183, -36 },
+	{ 0xFD87B5F28300CA0EULL, -157, -28 },
+	{ 0xBCE5086492111AEBULL, -130, -20 },
+	{ 0x8CBCCC096F5088CCULL, -103, -12 },
+	{ 0xD1B71758E219652CULL, -77, -4 },
+	{ 0x9C40000000000000ULL, -50, 4 },
+	{ 0xE8D4A51000000000ULL, -24, 12 },
+	{ 0xAD78EBC5AC620000ULL, 3, 20 },
+	{ 0x813F3978F8940984ULL, 30, 28 },
+	{ 0xC097CE7BC90715B3ULL, 56, 36 },
+	{ 0x8F7E32CE7BEA5C70ULL, 83, 44 },
+	{ 0xD5D238A4ABE98068ULL, 109, 52 },
+	{ 0x9F4F2726179A2245ULL, 136, 60 },
+	{ 0xED63A231D4C4FB27ULL, 162, 68 },
+	{ 0xB0DE65388CC8ADA8ULL, 189, 76 },
+	{ 0x83C7088E1AAB65DBULL, 216, 84 },
+	{ 0xC45D1DF942711D9AULL, 242, 92 },
+	{ 0x924D692CA61BE758ULL, 269, 100 },
+	{ 0xDA01EE641A708DEAULL, 295, 108 },
+	{ 0xA26DA3999AEF774AULL, 322, 116 },
+	{ 0xF209787BB47D6B85ULL, 348, 124 },
+	{ 0xB454E4A179DD1877ULL, 375, 132 },
+	{ 0x865B86925B9BC5C2ULL, 402, 140 },
+	{ 0xC83553C5C8965D3DULL, 428, 148 },
+	{ 0x952AB45CFA97A0B3ULL, 455, 156 },
+	{ 0xDE469FBD99A05FE3ULL, 481, 164 },
+	{ 0xA59BC234DB398C25ULL, 508, 172 },
+	{ 0xF6C69A72A3989F5CULL, 534, 180 },
+	{ 0xB7DCBF5354E9BECEULL, 561, 188 },
+	{ 0x88FCF317F22241E2ULL, 588, 196 },
+	{ 0xCC20CE9BD35C78A5ULL, 614, 204 },
+	{ 0x98165AF37B2153DFULL, 641, 212 },
+	{ 0xE2A0B5DC971F303AULL, 667, 220 },
+	{ 0xA8D9D1535CE3B396ULL, 694, 228 },
+	{ 0xFB9B7CD9A4A7443CULL, 720, 236 },
+	{ 0xBB764C4CA7A44410ULL, 747, 244 },
+	{ 0x8BAB8EEFB6409C1AULL, 774, 252 },
+	{ 0xD01FEF10A657842CULL, 800, 260 },
+	{ 0x9B10A4E5E9913129ULL, 827, 268 },
+	{ 0xE7109BFBA19C0C9DULL, 853, 276 },
+	{ 0xAC2820D9623BF429ULL, 880, 284 },
+	{ 0x80444B5E7AA7CF85ULL, 907, 292 },
+	{ 0xBF21E44003ACDD2DULL, 933, 300 },
+	{ 0x8E679C2F5E44FF8FULL, 960, 308 },
+	{ 0xD433179D9C8CB841ULL, 986, 316 },
+	{ 0x9E19DB92B4E31BA9ULL, 1013, 324 },
+	{ 0xEB96BF6EBADF77D9ULL, 1039, 332 },
+	{ 0xAF87023B9BF0EE6BULL, 1066, 340 },
+};
+
+/** @brief Returns x - y of two values of the same exponent */
+static DiyFp subtract(const DiyFp &x, const DiyFp &y)
+{
+	assert(x.e == y.e);
+	assert(x.f >= y.f);
+	DiyFp ret = {x.f - y.f, x.e};
+	return ret;
+}
+
+/** @brief Returns the rounded, upper 64 bit of the product x * y */
+static DiyFp multiply(const DiyFp &x, const DiyFp &y)
+{
+	const uint64_t xLo = x.f & 0xFFFFFFFFu;
+	const uint64_t xHi = x.f >> 32;
+	const uint64_t yLo = y.f & 0xFFFFFFFFu;
+	const uint64_t yHi = y.f >> 32;
+
+	const uint64_t p0 = xLo * yLo;
+	const uint64_t p1 = xLo * yHi;
+	const uint64_t p2 = xHi * yLo;
+	const uint64_t p3 = xHi * yHi;
+
+	uint64_t q = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+	q += uint64_t(1) << 31; // Round
+
+	DiyFp ret = {p3 + (p1 >> 32) + (p2 >> 32) + (q >> 32), x.e + y.e + 64};
+	return ret;
+}
+
+/** @brief Shifts the significand until its most significant bit is set */
+static DiyFp normalize(DiyFp x)
+{
+	assert(x.f != 0);
+	while ((x.f >> 63) == 0)
+	{
+		x.f <<= 1;
+		x.e--;
+	}
+	return x;
+}
+
+/**
+ * @brief Calculates the normalized value and the normalized boundaries of
+ * the given finite, positive value
+ * @details All values which are strictly between the lower and the upper
+ * boundary read back to the given value.
+ */
+static void computeBoundaries(double value, DiyFp &lower, DiyFp &v,
+	DiyFp &upper)
+{
+	const uint64_t HIDDEN_BIT = uint64_t(1) << 52;
+	const int BIAS = 1075;
+
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	const uint64_t fraction = bits & (HIDDEN_BIT - 1);
+	const int biasedExponent = (int) (bits >> 52);
+
+	DiyFp raw;
+	if (biasedExponent == 0)
+	{
+		raw.f = fraction;
+		raw.e = 1 - BIAS;
+	} else {
+		raw.f = fraction + HIDDEN_BIT;
+		raw.e = biasedExponent - BIAS;
+	}
+
+	// The distance to the lower neighbour is halved at powers of two
+	DiyFp plus = {2 * raw.f + 1, raw.e - 1};
+	DiyFp minus;
+	if (fraction == 0 && biasedExponent > 1)
+	{
+		minus.f = 4 * raw.f - 1;
+		minus.e = raw.e - 2;
+	} else {
+		minus.f = 2 * raw.f - 1;
+		minus.e = raw.e - 1;
+	}
+
+	upper = normalize(plus);
+	lower.f = minus.f << (minus.e - upper.e);
+	lower.e = upper.e;
+	v = normalize(raw);
+	assert(v.e == upper.e);
+}
+
+/**
+ * @brief Returns a cached power c = 10^-k such that the binary exponent of
+ * c * 2^e is in [ALPHA, GAMMA]
+ */
+static const CachedPower &getCachedPower(int e)
+{
+	// k = ceil(log10(2^(ALPHA - e - 1)))
+	const int f = ALPHA - e - 1;
+	const int k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+	const int index = (-CACHED_POWERS_MIN_DEC_EXP + k +
+		(CACHED_POWERS_DEC_STEP - 1)) / CACHED_POWERS_DEC_STEP;
+	assert(index >= 0);
+	assert(index < (int) (sizeof(CACHED_POWERS) / sizeof(CACHED_POWERS[0])));
+
+	const CachedPower &cached = CACHED_POWERS[index];
+	assert(ALPHA <= cached.e + e + 64);
+	assert(cached.e + e + 64 <= GAMMA);
+	return cached;
+}
+
+/** @brief Returns the number of decimal digits and the largest power of ten
+ * which is not greater than n */
+static int findLargestPow10(uint32_t n, uint32_t &pow10)
+{
+	static const uint32_t POWERS[] = {
+		1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u,
+		100000000u, 1000000000u
+	};
+	int digits = 10;
+	while (digits > 1 && n < POWERS[digits - 1]) digits--;
+	pow10 = POWERS[digits - 1];
+	return digits;
+}
+
+/**
+ * @brief Moves the last generated digit towards the exact value as long as
+ * the result stays within the boundaries
+ */
+static void roundWeed(char *digits, int length, uint64_t dist, uint64_t delta,
+	uint64_t rest, uint64_t tenK)
+{
+	assert(length > 0);
+	while (rest < dist && delta - rest >= tenK &&
+		(rest + tenK < dist || dist - rest > rest + tenK - dist))
+	{
+		assert(digits[length - 1] != '0');
+		digits[length - 1]--;
+		rest += tenK;
+	}
+}
+
+/**
+ * @brief Generates the digits of w which are strictly within the scaled
+ * boundaries
+ * @details The exponent is adjusted by the number of generated digits.
+ */
+static int generateDigits(char *digits, int &exponent, const DiyFp &minus,
+	const DiyFp &w, const DiyFp &plus)
+{
+	assert(ALPHA <= plus.e && plus.e <= GAMMA);
+
+	uint64_t delta = subtract(plus, minus).f;
+	uint64_t dist = subtract(plus, w).f;
+
+	const int shift = -plus.e;
+	const uint64_t one = uint64_t(1) << shift;
+
+	uint32_t integral = (uint32_t) (plus.f >> shift);
+	uint64_t fractional = plus.f & (one - 1);
+	int length = 0;
+
+	uint32_t pow10;
+	int n = findLargestPow10(integral, pow10);
+	while (n > 0)
+	{
+		const uint32_t d = integral / pow10;
+		integral %= pow10;
+		digits[length++] = (char) ('0' + d);
+		n--;
+
+		const uint64_t rest = (((uint64_t) integral) << shift) + fractional;
+		if (rest <= delta)
+		{
+			exponent += n;
+			roundWeed(digits, length, dist, delta, rest,
+				((uint64_t) pow10) << shift);
+			return length;
+		}
+		pow10 /= 10;
+	}
+
+	int m = 0;
+	for (;;)
+	{
+		fractional *= 10;
+		digits[length++] = (char) ('0' + (fractional >> shift));
+		fractional &= one - 1;
+		m++;
+		delta *= 10;
+		dist *= 10;
+		if (fractional <= delta) break;
+	}
+	exponent -= m;
+	roundWeed(digits, length, dist, delta, fractional, one);
+	return length;
+}
+
+RealFormatter::RealFormatter(int precision): precision_(precision)
+{
+	assert(precision_ == SHORTEST ||
+		(precision_ > 0 && precision_ <= MAX_PRECISION));
+}
+
+int RealFormatter::getPrecision() const
+{
+	return precision_;
+}
+
+size_t RealFormatter::format(double value, char *buffer) const
+{
+	assert(buffer != NULL);
+
+	size_t pos = 0;
+	if (signbit(value))
+	{
+		buffer[pos++] = '-';
+		value = -value;
+	}
+
+	if (isnan(value))
+	{
+		memcpy(buffer + pos, "nan", 3);
+		return pos + 3;
+	}
+	if (isinf(value))
+	{
+		memcpy(buffer + pos, "inf", 3);
+		return pos + 3;
+	}
+	if (value == 0.0)
+	{
+		buffer[pos] = '0';
+		return pos + 1;
+	}
+
+	char digits[MAX_PRECISION + 1];
+	int exponent = 0;
+	int length;
+	int scientificExponent;
+	if (precision_ == SHORTEST)
+	{
+		length = generateShortest(value, digits, exponent);
+		scientificExponent = MAX_PRECISION;
+	} else {
+		length = generatePrecise(value, digits, exponent);
+		scientificExponent = precision_;
+	}
+
+	return pos + formatDigits(digits, length, exponent, scientificExponent,
+		buffer + pos);
+}
+
+int RealFormatter::generateShortest(double value, char *digits, 
+	int &exponent)
+{
+	DiyFp lower, v, upper;
+	computeBoundaries(value, lower, v, upper);
+
+	// Scale the value such that the significant digits are integral
+	const CachedPower &cached = getCachedPower(upper.e);
+	const DiyFp c = {cached.f, cached.e};
+	const DiyFp w = multiply(v, c);
+	DiyFp minus = multiply(lower, c);
+	DiyFp plus = multiply(upper, c);
+
+	// Exclude the boundaries to compensate the rounding of the multiplication
+	minus.f++;
+	plus.f--;
+
+	exponent = -cached.k;
+	int length = generateDigits(digits, exponent, minus, w, plus);
+	assert(length <= MAX_PRECISION);
+	return length;
+}
+
+int RealFormatter::generatePrecise(double value, char *digits, 
+	int &exponent) const
+{
+	// The format is [d][point][d...]e[sign][d...]. Any decimal point 
+	// character of the current locale is skipped.
+	char buffer[BUFFER_SIZE];
+	int ret = snprintf(buffer, sizeof(buffer), "%.*e", precision_ - 1, value);
+	assert(ret > 0 && ret < (int) sizeof(buffer));
+	(void) ret;
+
+	int length = 0;
+	digits[length++] = buffer[0];
+	const char *pos = buffer + 1;
+	if (precision_ > 1) pos++;
+	while (*pos != 'e')
+	{
+		digits[length++] = *pos;
+		pos++;
+	}
+	assert(length == precision_);
+
+	exponent = atoi(pos + 1) - (length - 1);
+	while (length > 1 && digits[length - 1] == '0')
+	{
+		length--;
+		exponent++;
+	}
+	return length;
+}
+
+size_t RealFormatter::formatDigits(const char *digits, int length,
+	int exponent, int scientificExponent, char *buffer)
+{
+	assert(length > 0);
+	
+	// The position of the decimal point relative to the first digit
+	const int point = length + exponent;
+	size_t pos = 0;
+
+	if (point - 1 < -4 || point - 1 >= scientificExponent)
+	{
+		buffer[pos++] = digits[0];
+		if (length > 1)
+		{
+			buffer[pos++] = '.';
+			memcpy(buffer + pos, digits + 1, length - 1);
+			pos += length - 1;
+		}
+		int scientific = point - 1;
+		buffer[pos++] = 'e';
+		buffer[pos++] = scientific < 0 ? '-' : '+';
+		if (scientific < 0) scientific = -scientific;
+		if (scientific >= 100) buffer[pos++] = (char) ('0' + scientific / 100);
+		buffer[pos++] = (char) ('0' + (scientific / 10) % 10);
+		buffer[pos++] = (char) ('0' + scientific % 10);
+	} else if (point >= length) {
+		memcpy(buffer, digits, length);
+		pos = length;
+		memset(buffer + pos, '0', point - length);
+		pos += point - length;
+	} else if (point > 0) {
+		memcpy(buffer, digits, point);
+		pos = point;
+		buffer[pos++] = '.';
+		memcpy(buffer + pos, digits + point, length - point);
+		pos += length - point;
+	} else {
+		buffer[pos++] = '0';
+		buffer[pos++] = '.';
+		memset(buffer + pos, '0', -point);
+		pos += -point;
+		memcpy(buffer + pos, digits, length);
+		pos += length;
+	}
+
+	assert(pos <= BUFFER_SIZE);
+	return pos;
+}
@@ -0,0 +1,221 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file RingDataLogger.cpp
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#include "timing/RingDataLogger.h"
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/log/trivial.hpp>
+
+#include "base/BaseExceptions.h"
+#include "timing/BinaryDataLogger.h"
+
+using namespace FMITerminalBlock::Timing;
+
+const std::string RingDataLogger::PROP_FILE_NAME = "app.dataFile";
+const std::string RingDataLogger::PROP_RING_SIZE = "ringSize";
+const std::string RingDataLogger::PROP_STRING_SIZE = "stringSize";
+const std::string RingDataLogger::PROP_DUMP_FILE = "dumpFile";
+
+std::atomic<bool> RingDataLogger::dumpRequested_(false);
+
+const char RingDataLogger::MAGIC[8] = {
+	'F', 'M', 'I', 'T', 'B', 'R', 'N', 'G'
+};
+
+RingDataLogger::RingDataLogger(Base::ApplicationContext &context):
+	region_(), layout_(), dumpFile_(), data_(NULL), count_(0), slotSize_(0),
+	capacity_(0), stringSize_(0)
+{
+	std::string filename = context.getProperty<std::string>(PROP_FILE_NAME, "");
+	if (filename.empty()) return;
+
+	const int ringSize = context.getRealPositiveIntegerProperty(
+		PROP_FILE_NAME + "." + PROP_RING_SIZE, DEFAULT_RING_SIZE);
+	stringSize_ = (uint32_t) context.getRealPositiveIntegerProperty(
+		PROP_FILE_NAME + "." + PROP_STRING_SIZE, DEFAULT_STRING_SIZE);
+	dumpFile_ = context.getProperty<std::string>(
+		PROP_FILE_NAME + "." + PROP_DUMP_FILE, "");
+
+	const Base::ChannelMapping *inChannelMapping =
+		context.getInputChannelMapping();
+	const Base::ChannelMapping *outChannelMapping =
+		context.getOutputChannelMapping();
+	layout_.init(inChannelMapping, outChannelMapping);
+	init(filename, (uint32_t) ringSize);
+}
+
+RingDataLogger::~RingDataLogger()
+{
+	if (data_ == NULL) return;
+
+	if (!region_.flush())
+	{
+		BOOST_LOG_TRIVIAL(warning) << "Unable to flush the data ring file";
+	}
+}
+
+void RingDataLogger::eventTriggered(Event * ev)
+{
+	assert(ev != NULL);
+
+	if (data_ == NULL) return;
+
+	char *slot = getSlot(count_);
+	layout_.encode(ev, slot);
+
+	// Copy the characters of each string to its fixed area behind the record
+	char *strings = slot + layout_.getSize();
+	const std::vector<int> &stringColumns = layout_.getStringColumns();
+	for (unsigned i = 0; i < stringColumns.size(); i++)
+	{
+		const Variable *var = layout_.getString(i);
+		if (var != NULL)
+		{
+			const std::string &value = var->getStringValue();
+			const uint32_t length = std::min((uint32_t) value.size(), stringSize_);
+			memcpy(strings + i * stringSize_, value.data(), length);
+			memcpy(slot + layout_.getOffset(stringColumns[i]), &length,
+				sizeof(length));
+		}
+	}
+
+	// Keep the record complete in case the program terminates abnormally
+	std::atomic_thread_fence(std::memory_order_release);
+	count_++;
+	memcpy((char *) region_.get_address() + BinaryRecord::HEADER_SIZE, &count_,
+		sizeof(count_));
+
+	// Avoid an atomic write per event as long as no dump is pending
+	if (dumpRequested_.load(std::memory_order_relaxed) &&
+		dumpRequested_.exchange(false))
+	{
+		dumpToFile();
+	}
+}
+
+void RingDataLogger::dump(std::ostream &destination) const
+{
+	const std::vector<char> header = layout_.makeHeader(BinaryDataLogger::MAGIC);
+	destination.write(header.data(), (std::streamsize) header.size());
+
+	if (data_ != NULL)
+	{
+		const std::vector<int> &stringColumns = layout_.getStringColumns();
+		const uint64_t first = count_ > capacity_ ? count_ - capacity_ : 0;
+		for (uint64_t number = first; number < count_; number++)
+		{
+			const char *slot = getSlot(number);
+			destination.write(slot, (std::streamsize) layout_.getSize());
+
+			// Append the characters of each present string in column order
+			const unsigned char *present = (const unsigned char *)
+				(slot + BinaryRecord::PRESENT_OFFSET);
+			for (unsigned i = 0; i < stringColumns.size(); i++)
+			{
+				const int col = stringColumns[i];
+				if ((present[col / 8] & (1u << (col % 8))) == 0) continue;
+
+				uint32_t length;
+				memcpy(&length, slot + layout_.getOffset(col), sizeof(length));
+				destination.write(slot + layout_.getSize() + i * stringSize_,
+					(std::streamsize) length);
+			}
+		}
+	}
+
+	destination.flush();
+	if (destination.fail())
+	{
+		throw std::runtime_error("Unable to write the recorded events");
+	}
+}
+
+void RingDataLogger::dumpToFile() const
+{
+	if (dumpFile_.empty()) return;
+
+	try
+	{
+		std::ofstream file(dumpFile_, std::ios_base::trunc | std::ios_base::out |
+			std::ios_base::binary);
+		dump(file);
+		BOOST_LOG_TRIVIAL(info) << "Dumped the recorded events to \""
+			<< dumpFile_ << "\"";
+	} catch (std::exception &ex) {
+		BOOST_LOG_TRIVIAL(error) << "Unable to dump the recorded events to \""
+			<< dumpFile_ << "\": " << ex.what();
+	}
+}
+
+void RingDataLogger::requestDump()
+{
+	dumpRequested_.store(true);
+}
+
+void RingDataLogger::init(const std::string &filename, uint32_t ringSize)
+{
+	assert(data_ == NULL);
+
+	std::vector<char> header = layout_.makeHeader(MAGIC, CONTROL_SIZE);
+	const size_t stringCount = layout_.getStringColumns().size();
+	slotSize_ = (uint32_t) ((layout_.getSize() + stringCount * stringSize_ + 7)
+		/ 8 * 8);
+	if (ringSize < header.size() + slotSize_)
+	{
+		throw Base::SystemConfigurationException("The data ring file is too "
+			"small to hold a single event", PROP_FILE_NAME + "." + PROP_RING_SIZE,
+			std::to_string(ringSize));
+	}
+	capacity_ = (uint32_t) ((ringSize - header.size()) / slotSize_);
+
+	// Fill the control block which follows the fixed header
+	char *control = &header[BinaryRecord::HEADER_SIZE];
+	memcpy(control, &count_, sizeof(count_));
+	memcpy(control + 8, &slotSize_, sizeof(slotSize_));
+	memcpy(control + 12, &capacity_, sizeof(capacity_));
+	memcpy(control + 16, &stringSize_, sizeof(stringSize_));
+
+	// Create the file in its final size. The slots are left zero.
+	const size_t fileSize = header.size() + (size_t) capacity_ * slotSize_;
+	std::ofstream file(filename, std::ios_base::trunc | std::ios_base::out |
+		std::ios_base::binary);
+	file.write(header.data(), (std::streamsize) header.size());
+	file.seekp((std::streamoff) fileSize - 1);
+	file.put('\0');
+	file.close();
+	if (file.fail())
+	{
+		throw Base::SystemConfigurationException(
+			"Couldn't create data file for writing.", PROP_FILE_NAME, filename);
+	}
+
+	try
+	{
+		boost::interprocess::file_mapping mapping(filename.c_str(),
+			boost::interprocess::read_write);
+		boost::interprocess::mapped_region region(mapping,
+			boost::interprocess::read_write, 0, fileSize);
+		region_.swap(region);
+	} catch (boost::interprocess::interprocess_exception &ex) {
+		throw Base::SystemConfigurationException(std::string("Couldn't map the "
+			"data file: ") + ex.what(), PROP_FILE_NAME, filename);
+	}
+
+	data_ = (char *) region_.get_address() + header.size();
+}
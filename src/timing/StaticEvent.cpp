@@ -15,15 +15,42 @@
 using namespace FMITerminalBlock::Timing;
 
 StaticEvent::StaticEvent(fmiTime time, const std::vector<Variable> &var): 
-	Event(time), var_(var)
+	Event(time), var_()
 {
 	assert(Event::isValid(var));
+	if (var.empty())
+	{
+		var_ = getEmptyVariables();
+	} else {
+		var_ = std::make_shared<const std::vector<Variable>>(var);
+	}
 }
 
-std::vector<Variable> 
+StaticEvent::StaticEvent(fmiTime time, std::vector<Variable> &&var): 
+	Event(time), var_()
+{
+	assert(Event::isValid(var));
+	if (var.empty())
+	{
+		var_ = getEmptyVariables();
+	} else {
+		var_ = std::make_shared<const std::vector<Variable>>(std::move(var));
+	}
+}
+
+const std::vector<Variable> & 
 StaticEvent::getVariables()
 {
-	return var_;
+	assert(var_);
+	return *var_;
+}
+
+const std::shared_ptr<const std::vector<Variable>> & 
+StaticEvent::getEmptyVariables()
+{
+	static const std::shared_ptr<const std::vector<Variable>> empty = 
+		std::make_shared<const std::vector<Variable>>();
+	return empty;
 }
 
 std::string 
@@ -31,6 +58,6 @@ StaticEvent::toString() const
 {
 	std::string ret = Event::toString();
 	ret += " ";
-	ret += Event::toString(var_);
+	ret += Event::toString(*var_);
 	return ret;
 }
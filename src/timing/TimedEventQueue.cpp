@@ -9,29 +9,53 @@
  */
 
 #include "timing/TimedEventQueue.h"
+#include "base/BaseExceptions.h"
 
 #include <boost/log/trivial.hpp>
 #include <boost/thread/lock_guard.hpp>
 #include <boost/thread/lock_types.hpp>
-#include <float.h>
+#include <boost/chrono/duration.hpp>
+#include <algorithm>
+#include <thread>
 #include <math.h>
+#include <errno.h>
+#include <time.h>
 
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+using namespace FMITerminalBlock;
 using namespace FMITerminalBlock::Timing;
 
+const std::string TimedEventQueue::PROP_WAIT_STRATEGY = "app.waitStrategy";
+const std::string TimedEventQueue::PROP_WAIT_SPIN_TIME = "app.waitSpinTime";
+
 TimedEventQueue::TimedEventQueue():
-	queue_(), queueMut_(), newEventCondition_(),
-	localEpoch_(boost::posix_time::microsec_clock::universal_time()), 
-	timeInitBarrier_()
+	prediction_(NULL), externalEvents_(), nextSequenceNr_(0), 
+	ingress_(INGRESS_INITIAL_CAPACITY), consumerWaiting_(false), queueMut_(), 
+	newEventCondition_(), timeInitBarrier_(),
+	localEpoch_(std::chrono::steady_clock::now()), waitStrategy_(condition),
+	spinTime_(std::chrono::steady_clock::duration::zero())
+{ 
+}
+
+TimedEventQueue::TimedEventQueue(const Base::ApplicationContext &context):
+	prediction_(NULL), externalEvents_(), nextSequenceNr_(0), 
+	ingress_(INGRESS_INITIAL_CAPACITY), consumerWaiting_(false), queueMut_(), 
+	newEventCondition_(), timeInitBarrier_(),
+	localEpoch_(std::chrono::steady_clock::now()), 
+	waitStrategy_(getWaitStrategy(context)), spinTime_(getSpinTime(context))
 { 
 }
 
 void 
 TimedEventQueue::initStartTimeNow(fmiTime start)
 {
-	assert(queue_.empty());
+	assert(prediction_ == NULL && externalEvents_.empty());
 
 	// Set preliminary local epoch
-	localEpoch_ = boost::posix_time::microsec_clock::universal_time();
+	localEpoch_ = std::chrono::steady_clock::now();
 	// Correct local epoch by starting time
 	localEpoch_ -= getRelativeTime(start);
 
@@ -49,6 +73,16 @@ TimedEventQueue::add(Event * ev, bool predicted)
 
 	boost::lock_guard<boost::mutex> guard(queueMut_);
 
+	drainIngress();
+	addLocked(ev, predicted);
+	newEventCondition_.notify_one();
+}
+
+void
+TimedEventQueue::addLocked(Event * ev, bool predicted)
+{
+	assert(ev != NULL);
+
 	BOOST_LOG_TRIVIAL(trace) << "TimedEventQueue: Add(" << ev->toString() 
 		<< ", " << predicted << "): Pre-State: " << toString();
 
@@ -65,7 +99,6 @@ TimedEventQueue::add(Event * ev, bool predicted)
 	}
 
 	push(ev, predicted);
-	newEventCondition_.notify_one();
 
 	BOOST_LOG_TRIVIAL(trace) << "TimedEventQueue: Add(...): Post-State: " 
 		<< toString();
@@ -80,23 +113,35 @@ TimedEventQueue::get(void)
 
 	while(ret == NULL)
 	{
-
-		if(queue_.empty())
+		// Producers have to notify the consumer from now on. The flag has to be 
+		// visible before the ingress queue is checked for the last time.
+		consumerWaiting_.store(true);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		drainIngress();
+
+		Event * next = front();
+		if(next == NULL)
 		{
 			BOOST_LOG_TRIVIAL(trace) << "Wait for a new event";
 			newEventCondition_.wait(lock);
-		}else if(isFutureEvent(queue_.front().first)){
+			continue;
+		}
+
+		std::chrono::steady_clock::time_point releaseTime = getReleaseTime(next);
+		if(releaseTime > std::chrono::steady_clock::now()){
 			// Wait until the time is reached
-			BOOST_LOG_TRIVIAL(trace) << "Wait until " << queue_.front().first->toString();
-			(void) newEventCondition_.timed_wait(lock, 
-				getSystemTime(queue_.front().first));
+			BOOST_LOG_TRIVIAL(trace) << "Wait until " << next->toString();
+			waitUntil(lock, releaseTime);
 		}else{
 			// Process event immediately
-			ret = queue_.front().first;
-			queue_.pop_front();
+			ret = next;
+			popFront();
 		}
 	}
+	consumerWaiting_.store(false);
+	lock.unlock();
 
+	eventLoggerInstance_.logEvent(ret, ProcessingStage::released);
 	return ret;
 }
 
@@ -105,14 +150,38 @@ TimedEventQueue::pushExternalEvent(Event *ev)
 {
 	timeInitBarrier_.waitIfUninitialized();
 	eventLoggerInstance_.logEvent(ev, ProcessingStage::realTimeGeneration);
-	add(ev, false);
+
+	if (!ingress_.push(ev))
+	{
+		// Unreachable unless the node allocation fails
+		BOOST_LOG_TRIVIAL(warning) << "Could not enqueue the external event "
+			<< ev->toString() << ". Retry.";
+
+		// Give other threads the chance to release memory
+		std::chrono::microseconds backoff(1);
+		while (!ingress_.push(ev))
+		{
+			std::this_thread::sleep_for(backoff);
+			backoff = std::min(backoff * 2, std::chrono::microseconds(1000));
+		}
+	}
+
+	// Order the push before the consumer's state is queried
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (consumerWaiting_.load(std::memory_order_relaxed))
+	{
+		// Acquiring the lock ensures that the consumer is already waiting or
+		// has not drained the ingress queue, yet.
+		boost::lock_guard<boost::mutex> guard(queueMut_);
+		newEventCondition_.notify_one();
+	}
 }
 
 fmiTime 
 TimedEventQueue::getTimeStampNow()
 {
-	boost::system_time currentTime;
-	currentTime = boost::posix_time::microsec_clock::universal_time();
+	std::chrono::steady_clock::time_point currentTime;
+	currentTime = std::chrono::steady_clock::now();
 	timeInitBarrier_.waitIfUninitialized();
 	return getSimulationTime(currentTime);
 }
@@ -126,48 +195,58 @@ void
 TimedEventQueue::InitializationBarrier::notifyInitialized()
 {
 	boost::lock_guard<boost::mutex> guard(accessMut_);
-	assert(!initialized_);
+	assert(!initialized_.load());
 
-	initialized_ = true;
+	initialized_.store(true, std::memory_order_release);
 	initializationCondition_.notify_all();
 }
 
 void
 TimedEventQueue::InitializationBarrier::waitIfUninitialized()
 {
+	// Fast path which avoids the lock after the initialization
+	if (initialized_.load(std::memory_order_acquire)) return;
+
 	boost::unique_lock<boost::mutex> lock(accessMut_);
 
-	while (!initialized_)
+	while (!initialized_.load(std::memory_order_acquire))
 	{
 		initializationCondition_.wait(lock);
 	}
 }
 
+void
+TimedEventQueue::drainIngress()
+{
+	Event * ev = NULL;
+	while (ingress_.pop(ev))
+	{
+		assert(ev != NULL);
+		addLocked(ev, false);
+	}
+}
+
 void 
 TimedEventQueue::removeFuturPredictions(fmiTime time)
 {
-	assert(isQueuePredictionConsistent());
-	if (!queue_.empty() && queue_.front().second &&
-		queue_.front().first->getTime() > time + eps_)
+	if (prediction_ != NULL && prediction_->getTime() > time + eps_)
 	{
 		BOOST_LOG_TRIVIAL(trace) << "De-queued future predicted "
-			<< queue_.front().first->toString();
-		deleteEvent(queue_.front().first);
-		queue_.erase(queue_.begin());
+			<< prediction_->toString();
+		deleteEvent(prediction_);
+		prediction_ = NULL;
 	}
 }
 
 void 
 TimedEventQueue::removeConcurrentPrediction(fmiTime time)
 {
-	assert(isQueuePredictionConsistent());
-	if (!queue_.empty() && queue_.front().second && 
-		fabs(queue_.front().first->getTime() - time) <= eps_)
+	if (prediction_ != NULL && fabs(prediction_->getTime() - time) <= eps_)
 	{
 		BOOST_LOG_TRIVIAL(trace) << "De-queued concurrent predicted " 
-			<< queue_.front().first->toString();
-		deleteEvent(queue_.front().first);
-		queue_.erase(queue_.begin());
+			<< prediction_->toString();
+		deleteEvent(prediction_);
+		prediction_ = NULL;
 	}
 }
 
@@ -175,83 +254,205 @@ void
 TimedEventQueue::push(Event * ev, bool predicted)
 {
 	assert(ev != NULL);
-	assert(queue_.empty() || !queue_.front().second || !predicted);
-	fmiTime invariantOldTime = -1*DBL_MAX; // DBL_MIN is still positive!
+	assert(prediction_ == NULL || !predicted);
 
-	auto evIt = queue_.begin();
-	while(evIt != queue_.end() && 
-		evIt->first->getTime() <= ev->getTime() + eps_ && !predicted )
+	if (predicted)
 	{
-		assert(invariantOldTime <= evIt->first->getTime() + eps_);
-		invariantOldTime = evIt->first->getTime();
+		prediction_ = ev;
+	}else{
+		QueueEntry entry;
+		entry.event = ev;
+		entry.timeSlot = getTimeSlot(ev->getTime());
+		entry.sequenceNr = nextSequenceNr_++;
+
+		externalEvents_.push_back(entry);
+		std::push_heap(externalEvents_.begin(), externalEvents_.end(), 
+			&TimedEventQueue::isIssuedAfter);
+	}
+}
 
-		++evIt;
+Event *
+TimedEventQueue::front() const
+{
+	if (prediction_ != NULL) return prediction_;
+	if (externalEvents_.empty()) return NULL;
+	return externalEvents_.front().event;
+}
+
+void
+TimedEventQueue::popFront()
+{
+	if (prediction_ != NULL)
+	{
+		prediction_ = NULL;
+	}else{
+		assert(!externalEvents_.empty());
+		std::pop_heap(externalEvents_.begin(), externalEvents_.end(), 
+			&TimedEventQueue::isIssuedAfter);
+		externalEvents_.pop_back();
 	}
-	queue_.insert(evIt, std::make_pair(ev, predicted));	
 }
 
-boost::system_time
-TimedEventQueue::getSystemTime(const Event* ev) const
+int64_t
+TimedEventQueue::getTimeSlot(fmiTime time) const
+{
+	return (int64_t) floor(time / eps_);
+}
+
+bool
+TimedEventQueue::isIssuedAfter(const QueueEntry &a, const QueueEntry &b)
+{
+	if (a.timeSlot != b.timeSlot) return a.timeSlot > b.timeSlot;
+	return a.sequenceNr > b.sequenceNr;
+}
+
+std::chrono::steady_clock::time_point
+TimedEventQueue::getReleaseTime(const Event* ev) const
 {
 	assert(ev != NULL);
-	fmiTime time = ev->getTime();
-	return localEpoch_ + getRelativeTime(time);
+	return localEpoch_ + getRelativeTime(ev->getTime());
 }
 
-boost::posix_time::time_duration 
-TimedEventQueue::getRelativeTime(fmiTime time)
+void
+TimedEventQueue::waitUntil(boost::unique_lock<boost::mutex> &lock, 
+	std::chrono::steady_clock::time_point releaseTime)
 {
-	return	boost::posix_time::seconds((long) floor(time)) + 
-		boost::posix_time::microseconds(
-			(int64_t) ((time - floor(time)) * 1000*1000));
+	if (waitStrategy_ == condition)
+	{
+		waitCondition(lock, releaseTime);
+		return;
+	}
+
+	// Coarse wait which may be interrupted by new events
+	std::chrono::steady_clock::time_point coarseTime = releaseTime - spinTime_;
+	if (coarseTime > std::chrono::steady_clock::now())
+	{
+		waitCondition(lock, coarseTime);
+		return;
+	}
+
+	// Fine wait which does not block the producers
+	lock.unlock();
+	if (waitStrategy_ == hybridSpin)
+	{
+		spinUntil(releaseTime);
+	} else {
+		sleepUntil(releaseTime);
+	}
+	lock.lock();
 }
 
-fmiTime
-TimedEventQueue::getSimulationTime(const boost::system_time &sysTime) const
+void
+TimedEventQueue::waitCondition(boost::unique_lock<boost::mutex> &lock, 
+	std::chrono::steady_clock::time_point time)
 {
-	boost::posix_time::time_duration evTime = sysTime - localEpoch_;
-	return ((fmiTime) evTime.ticks()) / evTime.ticks_per_second();
+	std::chrono::nanoseconds remaining = 
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			time - std::chrono::steady_clock::now());
+	if (remaining.count() > 0)
+	{
+		// Relative waits are based on a monotonic clock
+		(void) newEventCondition_.wait_for(lock, 
+			boost::chrono::nanoseconds(remaining.count()));
+	}
 }
 
-bool
-TimedEventQueue::isFutureEvent(const Event* ev) const
+void
+TimedEventQueue::spinUntil(std::chrono::steady_clock::time_point time)
 {
-	boost::system_time evTime = getSystemTime(ev);
-	return evTime > boost::posix_time::microsec_clock::universal_time();
+	while (std::chrono::steady_clock::now() < time)
+	{
+		// Busy wait
+	}
 }
 
-bool
-TimedEventQueue::hasPriorEvents(fmiTime maxTime) const
+void
+TimedEventQueue::sleepUntil(std::chrono::steady_clock::time_point time)
 {
-	return !queue_.empty() && queue_.front().first->getTime() < maxTime - eps_;
+#if defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0) && defined(CLOCK_MONOTONIC)
+	std::chrono::nanoseconds sinceEpoch = 
+		std::chrono::duration_cast<std::chrono::nanoseconds>(
+			time.time_since_epoch());
+	struct timespec ts;
+	ts.tv_sec = (time_t) (sinceEpoch.count() / 1000000000);
+	ts.tv_nsec = (long) (sinceEpoch.count() % 1000000000);
+
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+	{
+		// Continue sleeping after a signal
+	}
+#else
+	std::this_thread::sleep_until(time);
+#endif
 }
 
+TimedEventQueue::WaitStrategy
+TimedEventQueue::getWaitStrategy(const Base::ApplicationContext &context)
+{
+	std::string name = context.getProperty<std::string>(PROP_WAIT_STRATEGY, 
+		"condvar");
+
+	if (name == "condvar") return condition;
+	if (name == "hybrid-spin") return hybridSpin;
+	if (name == "clock_nanosleep") return clockNanosleep;
+
+	throw Base::SystemConfigurationException("Unknown wait strategy", 
+		PROP_WAIT_STRATEGY, name);
+}
 
-bool 
-TimedEventQueue::isQueuePredictionConsistent() const
+std::chrono::steady_clock::duration
+TimedEventQueue::getSpinTime(const Base::ApplicationContext &context)
 {
-	auto it = queue_.cbegin();
-	// Ignore the first position, it may be a prediction.
-	if (it != queue_.cend()) ++it;
-	while(it != queue_.cend())
+	fmiTime spinTime = context.getProperty<fmiTime>(PROP_WAIT_SPIN_TIME, 200e-6);
+	if (spinTime < 0.0)
 	{
-		if (it->second) return false;
-		++it;
+		throw Base::SystemConfigurationException("The wait spin time must not be "
+			"negative", PROP_WAIT_SPIN_TIME, 
+			context.getProperty<std::string>(PROP_WAIT_SPIN_TIME));
 	}
-	return true;
+	return getRelativeTime(spinTime);
+}
+
+std::chrono::steady_clock::duration
+TimedEventQueue::getRelativeTime(fmiTime time)
+{
+	return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<fmiTime>(time));
+}
+
+fmiTime
+TimedEventQueue::getSimulationTime(
+	const std::chrono::steady_clock::time_point &time) const
+{
+	return std::chrono::duration<fmiTime>(time - localEpoch_).count();
+}
+
+bool
+TimedEventQueue::hasPriorEvents(fmiTime maxTime) const
+{
+	Event * next = front();
+	return next != NULL && next->getTime() < maxTime - eps_;
 }
 
 std::string 
 TimedEventQueue::toString()
 {
 	std::string ret("TimedEventQueue: [");
-	auto it = queue_.begin();
-	while ( it != queue_.end() )
+	if (prediction_ != NULL)
+	{
+		ret += prediction_->toString();
+		ret += " (predicted)";
+		if (!externalEvents_.empty()) ret += ", ";
+	}
+
+	// The heap is not sorted. Print the entries in issuing order.
+	std::vector<QueueEntry> sorted(externalEvents_);
+	std::sort_heap(sorted.begin(), sorted.end(), &TimedEventQueue::isIssuedAfter);
+	for (auto it = sorted.rbegin(); it != sorted.rend(); ++it)
 	{
-		ret += it->first->toString();
-		ret += it->second ? " (predicted)" : " (external)";
-		++it;
-		if (it != queue_.end())	ret += ", ";
+		if (it != sorted.rbegin()) ret += ", ";
+		ret += it->event->toString();
+		ret += " (external)";
 	}
 	ret += "]";
 	return ret;
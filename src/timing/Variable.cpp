@@ -17,18 +17,45 @@
 using namespace FMITerminalBlock::Timing;
 using namespace FMITerminalBlock;
 
-Variable::Variable(): id_(fmiTypeUnknown, 0), data_()
+Variable::Variable(): id_(fmiTypeUnknown, 0), valueType_(fmiTypeUnknown), 
+	value_(), string_()
 {
 }
 
 Variable::Variable(const Base::PortID &id, const boost::any &data):
-	id_(id), data_(data)
+	id_(id), valueType_(fmiTypeUnknown), value_(), string_()
 {
+	setValue(data);
 }
 
 Variable::Variable(const std::pair <Base::PortID, boost::any> &pair) :
-	id_(pair.first), data_(pair.second)
+	id_(pair.first), valueType_(fmiTypeUnknown), value_(), string_()
 {
+	setValue(pair.second);
+}
+
+Variable::Variable(const Base::PortID &id, fmiReal value):
+	id_(id), valueType_(fmiTypeUnknown), value_(), string_()
+{
+	setValue(value);
+}
+
+Variable::Variable(const Base::PortID &id, fmiInteger value):
+	id_(id), valueType_(fmiTypeUnknown), value_(), string_()
+{
+	setValue(value);
+}
+
+Variable::Variable(const Base::PortID &id, fmiBoolean value):
+	id_(id), valueType_(fmiTypeUnknown), value_(), string_()
+{
+	setValue(value);
+}
+
+Variable::Variable(const Base::PortID &id, const std::string &value):
+	id_(id), valueType_(fmiTypeUnknown), value_(), string_()
+{
+	setValue(value);
 }
 
 Base::PortID Variable::getID() const
@@ -39,31 +66,62 @@ Base::PortID Variable::getID() const
 boost::any Variable::getValue() const
 {
 	assert(isValid());
-	return data_;
+	switch (valueType_)
+	{
+	case fmiTypeReal: return boost::any(value_.real_);
+	case fmiTypeInteger: return boost::any(value_.integer_);
+	case fmiTypeBoolean: return boost::any(value_.boolean_);
+	case fmiTypeString: return boost::any(*string_);
+	default: assert(false); return boost::any();
+	}
 }
 
 fmiReal Variable::getRealValue() const
 {
 	assert(id_.first == fmiTypeReal && isValid());
-	return boost::any_cast<fmiReal>(data_);
+	return value_.real_;
 }
 
 fmiInteger Variable::getIntegerValue() const
 {
 	assert(id_.first == fmiTypeInteger && isValid());
-	return boost::any_cast<fmiInteger>(data_);
+	return value_.integer_;
 }
 
 fmiBoolean Variable::getBooleanValue() const
 {
 	assert(id_.first == fmiTypeBoolean && isValid());
-	return boost::any_cast<fmiBoolean>(data_);
+	return value_.boolean_;
 }
 
-const std::string Variable::getStringValue() const
+const std::string & Variable::getStringValue() const
 {
 	assert(id_.first == fmiTypeString && isValid());
-	return boost::any_cast<std::string>(data_);
+	return *string_;
+}
+
+template<> 
+fmiReal Variable::getTypedValue<fmiReal>() const
+{
+	return getRealValue();
+}
+
+template<> 
+fmiInteger Variable::getTypedValue<fmiInteger>() const
+{
+	return getIntegerValue();
+}
+
+template<> 
+fmiBoolean Variable::getTypedValue<fmiBoolean>() const
+{
+	return getBooleanValue();
+}
+
+template<> 
+std::string Variable::getTypedValue<std::string>() const
+{
+	return getStringValue();
 }
 
 void Variable::setID(const Base::PortID &id)
@@ -73,35 +131,60 @@ void Variable::setID(const Base::PortID &id)
 
 void Variable::setValue(const boost::any &value)
 {
-	data_ = value;
+	if (value.type() == typeid(fmiReal))
+	{
+		setValue(boost::any_cast<fmiReal>(value));
+	}
+	else if (value.type() == typeid(fmiInteger))
+	{
+		setValue(boost::any_cast<fmiInteger>(value));
+	}
+	else if (value.type() == typeid(fmiBoolean))
+	{
+		setValue(boost::any_cast<fmiBoolean>(value));
+	}
+	else if (value.type() == typeid(std::string))
+	{
+		setValue(boost::any_cast<const std::string &>(value));
+	}
+	else
+	{
+		valueType_ = fmiTypeUnknown;
+		string_.reset();
+	}
 }
 
-bool Variable::isValid() const
+void Variable::setValue(fmiReal value)
 {
-	bool ok;
+	valueType_ = fmiTypeReal;
+	value_.real_ = value;
+	string_.reset();
+}
 
-	switch(id_.first)
-	{
-	case fmiTypeReal:
-		ok = data_.type() == typeid(fmiReal);
-		break;
-	case fmiTypeInteger:
-		ok = data_.type() == typeid(fmiInteger);
-		break;
-	case fmiTypeBoolean:
-		ok = data_.type() == typeid(fmiBoolean);
-		break;
-	case fmiTypeString:
-		ok = data_.type() == typeid(std::string);
-		break;
-	case fmiTypeUnknown:
-		ok = false;
-		break;
-	default:
-		assert(false);
-	}
+void Variable::setValue(fmiInteger value)
+{
+	valueType_ = fmiTypeInteger;
+	value_.integer_ = value;
+	string_.reset();
+}
+
+void Variable::setValue(fmiBoolean value)
+{
+	valueType_ = fmiTypeBoolean;
+	value_.boolean_ = value;
+	string_.reset();
+}
+
+void Variable::setValue(const std::string &value)
+{
+	valueType_ = fmiTypeString;
+	string_ = std::make_shared<const std::string>(value);
+}
 
-	return ok;
+bool Variable::isValid() const
+{
+	assert(((int) id_.first) >= 0 && ((int) id_.first) <= fmiTypeUnknown);
+	return id_.first != fmiTypeUnknown && id_.first == valueType_;
 }
 
 bool Variable::isTypeUnknown() const
@@ -33,9 +33,15 @@
 #include <float.h>
 #include <stdint.h>
 #include <stdexcept>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include "network/CompactASN1UDPPublisher.h"
 #include "network/CompactASN1TCPClientPublisher.h"
+#include "network/IOServicePool.h"
+#include "network/UDPTransmitter.h"
 #include "timing/StaticEvent.h"
 #include "base/BaseExceptions.h"
 
@@ -1111,3 +1117,589 @@ BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_UDP_multi_event_1, ASN1UDPFixture )
 
 	BOOST_CHECK_EQUAL(validMessages, 2);
 }
+
+/** @brief Tests a deadband which is configured at a non-real port */
+BOOST_FIXTURE_TEST_CASE( test_invalid_ASN1_UDP_deadband_0, ASN1UDPFixture )
+{
+	config.put("1.deadband.absolute", "1");
+	BOOST_CHECK_THROW(publisher.init(ports), Base::SystemConfigurationException);
+	BOOST_CHECK_EQUAL(validMessages, 0);
+}
+
+/** @brief Tests a negative deadband */
+BOOST_FIXTURE_TEST_CASE( test_invalid_ASN1_UDP_deadband_1, ASN1UDPFixture )
+{
+	config.put("0.deadband.relative", "-0.1");
+	BOOST_CHECK_THROW(publisher.init(ports), Base::SystemConfigurationException);
+	BOOST_CHECK_EQUAL(validMessages, 0);
+}
+
+/** @brief Tests suppressing insignificant changes of a real port */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_UDP_deadband, ASN1UDPFixture )
+{
+	config.put("0.deadband.absolute", "0.1");
+
+	// Set-up event values
+	std::vector<Timing::Variable> vars;
+	vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeReal, 666), 
+			(fmiReal) 0.3 ));
+
+	// Set-up reference
+	uint8_t ref[] = {0x4b, 0x3f,0xd3,0x33,0x33,0x33,0x33,0x33,0x33,
+									 0x44, 0x00,0x00,0x00,0x00,
+									 0x40, 
+									 0x50,0x00,0x00};
+	receiveReference.assign(ref, ref+sizeof(ref));
+	// Init publisher
+	publisher.init(ports);
+
+	// Trigger first event
+	Timing::Event * ev = new Timing::StaticEvent(0.0, vars);
+	publisher.eventTriggered(ev); 
+	delete ev;
+	ioService.run_one();
+	BOOST_CHECK_EQUAL(validMessages, 1);
+
+	// Stays within the deadband and must not be sent
+	vars[0].setValue((fmiReal) 0.35);
+	ev = new Timing::StaticEvent(1.0, vars);
+	publisher.eventTriggered(ev); 
+	delete ev;
+	ioService.poll();
+	BOOST_CHECK_EQUAL(validMessages, 1);
+
+	// Leaves the deadband of the last published value
+	vars[0].setValue((fmiReal) 0.5);
+	uint8_t ref2[] = {0x4b, 0x3f,0xe0,0x00,0x00,0x00,0x00,0x00,0x00, // changed
+									 0x44, 0x00,0x00,0x00,0x00,
+									 0x40, 
+									 0x50,0x00,0x00};
+	receiveReference.assign(ref2, ref2+sizeof(ref2));
+
+	ev = new Timing::StaticEvent(2.0, vars);
+	publisher.eventTriggered(ev); 
+	delete ev;
+	ioService.run_one();
+	BOOST_CHECK_EQUAL(validMessages, 2);
+}
+
+/** @brief Tests a first value which is within the deadband of zero */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_UDP_deadband_first, ASN1UDPFixture )
+{
+	config.put("0.deadband.absolute", "0.5");
+
+	// Set-up event values
+	std::vector<Timing::Variable> vars;
+	vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeReal, 666), 
+			(fmiReal) 0.3 ));
+
+	// Set-up reference
+	uint8_t ref[] = {0x4b, 0x3f,0xd3,0x33,0x33,0x33,0x33,0x33,0x33,
+									 0x44, 0x00,0x00,0x00,0x00,
+									 0x40, 
+									 0x50,0x00,0x00};
+	receiveReference.assign(ref, ref+sizeof(ref));
+	// Init publisher
+	publisher.init(ports);
+
+	// The initial placeholder was never sent. Hence, the value is published.
+	Timing::Event * ev = new Timing::StaticEvent(0.0, vars);
+	publisher.eventTriggered(ev); 
+	delete ev;
+	ioService.run_one();
+	BOOST_CHECK_EQUAL(validMessages, 1);
+
+	// Stays within the deadband of the published value
+	vars[0].setValue((fmiReal) 0.1);
+	ev = new Timing::StaticEvent(1.0, vars);
+	publisher.eventTriggered(ev); 
+	delete ev;
+	ioService.poll();
+	BOOST_CHECK_EQUAL(validMessages, 1);
+}
+
+/** @brief Tests patching the values of a channel without any string port */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_UDP_fixed_layout, ASN1UDPFixture )
+{
+	Base::TransmissionChannel fixedPorts(config);
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeReal, 666), config.get_child("0"));
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeInteger, 0), config.get_child("1"));
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeBoolean, 0), config.get_child("2"));
+	config.put("0.encoding", "REAL");
+
+	// Set-up event values
+	std::vector<Timing::Variable> vars;
+	vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeInteger, 0), 
+			(fmiInteger) INT_MIN ));
+
+	// Set-up reference
+	uint8_t ref[] = {0x4a, 0x00,0x00,0x00,0x00,
+									 0x44, 0x80,0x00,0x00,0x00,
+									 0x40};
+	receiveReference.assign(ref, ref+sizeof(ref));
+	publisher.init(fixedPorts);
+
+	Timing::Event * ev = new Timing::StaticEvent(0.0, vars);
+	publisher.eventTriggered(ev); 
+	delete ev;
+	ioService.run_one();
+
+	vars.clear();
+	vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeBoolean, 0), 
+			(fmiBoolean) fmiTrue));
+	vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeReal, 666), 
+			(fmiReal) -2.0));
+
+	uint8_t ref2[] = {0x4a, 0xc0,0x00,0x00,0x00, // changed
+									 0x44, 0x80,0x00,0x00,0x00,
+									 0x41}; // changed
+	receiveReference.assign(ref2, ref2+sizeof(ref2));
+
+	ev = new Timing::StaticEvent(1.0, vars);
+	publisher.eventTriggered(ev); 
+	delete ev;
+	ioService.run_one();
+
+	BOOST_CHECK_EQUAL(validMessages, 2);
+}
+
+// ============================================================================
+// Benchmark the Encoder
+// ============================================================================
+
+/** @brief Publisher which only counts the encoded frames */
+class FrameCountingPublisher: public CompactASN1Publisher
+{
+public:
+	/** @brief The number of frames sent */
+	size_t frames = 0;
+	/** @brief The total number of bytes sent */
+	size_t bytes = 0;
+
+protected:
+	/** @brief Counts the frame without sending it */
+	virtual void sendData(const std::vector<uint8_t> &buffer)
+	{
+		frames++;
+		bytes += buffer.size();
+	}
+};
+
+/**
+ * @brief Publishes the given number of alternating real values and returns 
+ * the achieved frame rate in frames per second
+ */
+double publishFrames(const Base::TransmissionChannel &channel, size_t count)
+{
+	FrameCountingPublisher publisher;
+	publisher.init(channel);
+
+	std::vector<Timing::Variable> vars;
+	vars.push_back(Timing::Variable(std::make_pair(fmiTypeReal, 666), 0.1));
+	Timing::StaticEvent ev0(0.0, vars);
+	vars[0].setValue((fmiReal) 0.2);
+	Timing::StaticEvent ev1(0.0, vars);
+
+	auto startTime = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < count; i++)
+	{
+		publisher.eventTriggered((i & 0x01) ? &ev1 : &ev0);
+	}
+	auto stopTime = std::chrono::steady_clock::now();
+
+	BOOST_CHECK_EQUAL(publisher.frames, count);
+	return count / std::chrono::duration<double>(stopTime - startTime).count();
+}
+
+/** 
+ * @brief Compares patching fixed layout frames with encoding every frame anew
+ * @details The channel which contains a string port has to be encoded 
+ * completely on every event.
+ */
+BOOST_FIXTURE_TEST_CASE( test_benchmark_ASN1_encoder, ASN1Fixture )
+{
+	const size_t frameCount = 1000000;
+
+	Base::TransmissionChannel fixedPorts(config);
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeReal, 666), config.get_child("0"));
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeInteger, 0), config.get_child("1"));
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeBoolean, 0), config.get_child("2"));
+
+	double fixedRate = publishFrames(fixedPorts, frameCount);
+	double variableRate = publishFrames(ports, frameCount);
+
+	BOOST_TEST_MESSAGE("Published " << frameCount << " frames at " 
+		<< (fixedRate / 1e6) << "M frames/s (patched) and " 
+		<< (variableRate / 1e6) << "M frames/s (encoded)");
+}
+
+/** @brief Tests sending the datagrams of several publishers at once */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_UDP_batched, ASN1UDPFixture )
+{
+	auto transmitter = std::make_shared<UDPTransmitter>();
+	CompactASN1UDPPublisher secondPublisher;
+	publisher.setTransmitter(transmitter);
+	secondPublisher.setTransmitter(transmitter);
+	publisher.init(ports);
+	secondPublisher.init(ports);
+
+	// Set-up event values
+	std::vector<Timing::Variable> vars;
+	vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeReal, 666), 
+			(fmiReal) 0.3 ));
+
+	// Set-up reference
+	uint8_t ref[] = {0x4b, 0x3f,0xd3,0x33,0x33,0x33,0x33,0x33,0x33,
+									 0x44, 0x00,0x00,0x00,0x00,
+									 0x40, 
+									 0x50,0x00,0x00};
+	receiveReference.assign(ref, ref+sizeof(ref));
+
+	Timing::Event * ev = new Timing::StaticEvent(0.0, vars);
+	publisher.eventTriggered(ev);
+	secondPublisher.eventTriggered(ev);
+
+	// Nothing is sent until the transmitter is flushed
+	ioService.poll();
+	BOOST_CHECK_EQUAL(validMessages, 0);
+
+	transmitter->eventTriggered(ev);
+	delete ev;
+	ioService.run_one();
+	ioService.run_one();
+	BOOST_CHECK_EQUAL(validMessages, 2);
+
+	// A flush without any queued datagram doesn't send anything
+	transmitter->flush();
+	ioService.poll();
+	BOOST_CHECK_EQUAL(validMessages, 2);
+}
+
+/** 
+ * @brief Tests that a failing datagram doesn't prevent sending the remaining
+ * ones but the error is still reported
+ */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_UDP_batched_error, ASN1UDPFixture )
+{
+	// Broadcasting isn't allowed on the transmitter's socket
+	auto transmitter = std::make_shared<UDPTransmitter>();
+	size_t broadcastSlot = transmitter->addDestination(
+		udp::endpoint(address_v4::broadcast(), 4242));
+	publisher.setTransmitter(transmitter);
+	publisher.init(ports);
+
+	std::vector<Timing::Variable> vars;
+	vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeReal, 666), 
+			(fmiReal) 0.3 ));
+	uint8_t ref[] = {0x4b, 0x3f,0xd3,0x33,0x33,0x33,0x33,0x33,0x33,
+									 0x44, 0x00,0x00,0x00,0x00,
+									 0x40, 
+									 0x50,0x00,0x00};
+	receiveReference.assign(ref, ref+sizeof(ref));
+
+	transmitter->enqueue(broadcastSlot, receiveReference);
+	Timing::StaticEvent ev(0.0, vars);
+	publisher.eventTriggered(&ev);
+
+	BOOST_CHECK_THROW(transmitter->flush(), boost::system::system_error);
+	ioService.run_one();
+	BOOST_CHECK_EQUAL(validMessages, 1);
+
+	// The failing datagram was dropped
+	transmitter->flush();
+}
+
+/** @brief Tests an invalid coalescing flag */
+BOOST_FIXTURE_TEST_CASE( test_invalid_ASN1_TCP_coalesce, ASN1TCPFixture )
+{
+	config.put<std::string>("coalesce", "sometimes");
+	BOOST_CHECK_THROW(publisher.init(ports), Base::SystemConfigurationException);
+}
+
+/** 
+ * @brief Tests that a lagging coalescing publisher only sends complete and 
+ * recent messages
+ * @details The events are triggered before the receiver reads anything. 
+ * Messages may be skipped but the last event must always be received.
+ */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_TCP_coalesce, ASN1Fixture )
+{
+	// The socket buffers must be exceeded in order to stall the publisher
+	const fmiInteger eventCount = 1000000;
+	const size_t messageSize = 15;
+
+	config.put<std::string>("coalesce", "true");
+	Base::TransmissionChannel fixedPorts(config);
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeReal, 666), config.get_child("0"));
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeInteger, 0), config.get_child("1"));
+	fixedPorts.pushBackPort(std::make_pair(fmiTypeBoolean, 0), config.get_child("2"));
+
+	tcp::acceptor acceptor(ioService);
+	acceptor.open(tcp::v4());
+	acceptor.set_option(tcp::acceptor::reuse_address(true));
+	acceptor.set_option(boost::asio::socket_base::receive_buffer_size(4096));
+	acceptor.bind(tcp::endpoint(tcp::v4(), 4242));
+	acceptor.listen();
+	tcp::socket socket(ioService);
+	CompactASN1TCPClientPublisher publisher;
+	publisher.init(fixedPorts);
+	acceptor.accept(socket);
+
+	// The reader is stalled until all events are queued. Without coalescing,
+	// the publisher blocks and the reader starts after a timeout.
+	std::mutex mutex;
+	std::condition_variable queuedCondition;
+	bool queued = false;
+	std::vector<fmiInteger> values;
+	boost::system::error_code err;
+	std::thread receiver([&]() {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			queuedCondition.wait_for(lock, std::chrono::seconds(5),
+				[&queued]() { return queued; });
+		}
+
+		std::vector<uint8_t> message(messageSize);
+		while (values.empty() || values.back() < eventCount - 1)
+		{
+			boost::asio::read(socket, boost::asio::buffer(message), err);
+			if (err || message[9] != 0x44) return;
+			values.push_back((fmiInteger) (((uint32_t) message[10] << 24) | 
+				((uint32_t) message[11] << 16) | ((uint32_t) message[12] << 8) | 
+				(uint32_t) message[13]));
+		}
+	});
+
+	for (fmiInteger i = 0; i < eventCount; i++)
+	{
+		std::vector<Timing::Variable> vars;
+		vars.push_back(Timing::Variable(std::make_pair(fmiTypeInteger, 0), i));
+		Timing::StaticEvent ev(0.0, vars);
+		publisher.eventTriggered(&ev);
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		queued = true;
+	}
+	queuedCondition.notify_all();
+	receiver.join();
+
+	BOOST_REQUIRE(!err);
+	BOOST_REQUIRE(!values.empty());
+	for (size_t i = 1; i < values.size(); i++)
+	{
+		BOOST_REQUIRE_GT(values[i], values[i - 1]);
+	}
+	BOOST_CHECK_EQUAL(values.back(), eventCount - 1);
+	BOOST_CHECK_LT(values.size(), (size_t) eventCount);
+	BOOST_TEST_MESSAGE("Received " << values.size() << " of " << eventCount 
+		<< " coalesced TCP messages");
+}
+
+/** @brief Tests an invalid write queue size */
+BOOST_FIXTURE_TEST_CASE( test_invalid_ASN1_TCP_write_queue_size, ASN1TCPFixture )
+{
+	config.put<std::string>("writeQueueSize", "0");
+	BOOST_CHECK_THROW(publisher.init(ports), Base::SystemConfigurationException);
+}
+
+/** @brief Tests a malformed write queue size */
+BOOST_FIXTURE_TEST_CASE( test_invalid_ASN1_TCP_write_queue_size_1, ASN1TCPFixture )
+{
+	config.put<std::string>("writeQueueSize", "many");
+	BOOST_CHECK_THROW(publisher.init(ports), Base::SystemConfigurationException);
+}
+
+/** @brief Tests an invalid overflow flag */
+BOOST_FIXTURE_TEST_CASE( test_invalid_ASN1_TCP_drop_oldest, ASN1TCPFixture )
+{
+	config.put<std::string>("dropOldest", "sometimes");
+	BOOST_CHECK_THROW(publisher.init(ports), Base::SystemConfigurationException);
+}
+
+/** @brief Tests an invalid TCP_NODELAY flag */
+BOOST_FIXTURE_TEST_CASE( test_invalid_ASN1_TCP_no_delay, ASN1TCPFixture )
+{
+	config.put<std::string>("noDelay", "quickly");
+	BOOST_CHECK_THROW(publisher.init(ports), Base::SystemConfigurationException);
+}
+
+/**
+ * @brief Provides a synchronous server which receives messages of a TCP
+ * publisher without any string port
+ */
+struct ASN1TCPReconnectFixture: ASN1Fixture
+{
+	/** @brief The size of each message */
+	static const size_t MESSAGE_SIZE = 15;
+
+	/** @brief The channel without any string port */
+	Base::TransmissionChannel fixedPorts;
+	/** @brief The listening socket */
+	tcp::acceptor acceptor;
+
+	ASN1TCPReconnectFixture(): fixedPorts(config),
+		acceptor(ioService, tcp::endpoint(tcp::v4(), 4242))
+	{
+		config.put<std::string>("reconnectionInterval", "10");
+		fixedPorts.pushBackPort(std::make_pair(fmiTypeReal, 666), config.get_child("0"));
+		fixedPorts.pushBackPort(std::make_pair(fmiTypeInteger, 0), config.get_child("1"));
+		fixedPorts.pushBackPort(std::make_pair(fmiTypeBoolean, 0), config.get_child("2"));
+	}
+
+	/** @brief Triggers an event which sets the integer port */
+	static void trigger(Publisher &publisher, fmiInteger value)
+	{
+		std::vector<Timing::Variable> vars;
+		vars.push_back(Timing::Variable(std::make_pair(fmiTypeInteger, 0), value));
+		Timing::StaticEvent ev(0.0, vars);
+		publisher.eventTriggered(&ev);
+	}
+
+	/** @brief Receives a single message and returns its integer value */
+	static fmiInteger receive(tcp::socket &socket)
+	{
+		std::vector<uint8_t> message(MESSAGE_SIZE);
+		boost::asio::read(socket, boost::asio::buffer(message));
+		return decode(message, 0);
+	}
+
+	/** @brief Returns the integer value of the message at the given offset */
+	static fmiInteger decode(const std::vector<uint8_t> &data, size_t pos)
+	{
+		BOOST_REQUIRE_LE(pos + MESSAGE_SIZE, data.size());
+		BOOST_REQUIRE_EQUAL(data[pos + 9], 0x44);
+		return (fmiInteger) (((uint32_t) data[pos + 10] << 24) | 
+			((uint32_t) data[pos + 11] << 16) | ((uint32_t) data[pos + 12] << 8) | 
+			(uint32_t) data[pos + 13]);
+	}
+};
+
+/** @brief Restarts the server and checks that the publisher reconnects */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_TCP_reconnect, ASN1TCPReconnectFixture )
+{
+	CompactASN1TCPClientPublisher publisher;
+	publisher.init(fixedPorts);
+
+	tcp::socket firstConnection(ioService);
+	acceptor.accept(firstConnection);
+	trigger(publisher, 1);
+	BOOST_CHECK_EQUAL(receive(firstConnection), 1);
+	firstConnection.close();
+
+	// Keep publishing until the publisher reconnected
+	tcp::socket secondConnection(ioService);
+	acceptor.non_blocking(true);
+	boost::system::error_code err = boost::asio::error::would_block;
+	fmiInteger value = 1;
+	for (int i = 0; i < 200 && err; i++)
+	{
+		trigger(publisher, ++value);
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		acceptor.accept(secondConnection, err);
+	}
+	BOOST_REQUIRE_MESSAGE(!err, err.message());
+	secondConnection.non_blocking(false);
+
+	// Messages are complete and the latest one is finally received
+	trigger(publisher, ++value);
+	fmiInteger received = 0;
+	while (received < value)
+	{
+		fmiInteger next = receive(secondConnection);
+		BOOST_REQUIRE_GE(next, received);
+		received = next;
+	}
+	BOOST_CHECK_EQUAL(received, value);
+}
+
+/** @brief Checks that a full write queue doesn't drop any message */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_TCP_full_queue, ASN1TCPReconnectFixture )
+{
+	const fmiInteger eventCount = 10000;
+
+	config.put<std::string>("writeQueueSize", "1");
+	CompactASN1TCPClientPublisher publisher;
+	publisher.init(fixedPorts);
+	tcp::socket connection(ioService);
+	acceptor.accept(connection);
+
+	// The receiving thread only collects the data. It is checked afterwards.
+	std::vector<uint8_t> data(eventCount * MESSAGE_SIZE);
+	boost::system::error_code err;
+	std::thread receiver([&connection, &data, &err]() {
+		boost::asio::read(connection, boost::asio::buffer(data), err);
+	});
+	for (fmiInteger i = 0; i < eventCount; i++)
+	{
+		trigger(publisher, i);
+	}
+	receiver.join();
+
+	BOOST_REQUIRE(!err);
+	for (fmiInteger i = 0; i < eventCount; i++)
+	{
+		BOOST_REQUIRE_EQUAL(decode(data, i * MESSAGE_SIZE), i);
+	}
+}
+
+/** @brief Checks that a failed reconnection is reported */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_TCP_reconnect_failure, ASN1TCPReconnectFixture )
+{
+	config.put<std::string>("reconnectionRetryCount", "2");
+	CompactASN1TCPClientPublisher publisher;
+	publisher.init(fixedPorts);
+
+	tcp::socket connection(ioService);
+	acceptor.accept(connection);
+	connection.close();
+	acceptor.close();
+
+	bool thrown = false;
+	for (fmiInteger i = 0; i < 200 && !thrown; i++)
+	{
+		try
+		{
+			trigger(publisher, i);
+		} catch (std::runtime_error &) {
+			thrown = true;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	BOOST_CHECK(thrown);
+}
+
+/** @brief Runs the publisher by a shared thread pool */
+BOOST_FIXTURE_TEST_CASE( test_publish_ASN1_TCP_shared_pool, ASN1TCPReconnectFixture )
+{
+	auto pool = std::make_shared<IOServicePool>(1, [](std::exception_ptr) {
+		BOOST_CHECK(false);
+	});
+	CompactASN1TCPClientPublisher publisher;
+	publisher.setIOServicePool(pool);
+	publisher.init(fixedPorts);
+
+	tcp::socket firstConnection(ioService);
+	acceptor.accept(firstConnection);
+	trigger(publisher, 1);
+	BOOST_CHECK_EQUAL(receive(firstConnection), 1);
+	trigger(publisher, 2);
+	BOOST_CHECK_EQUAL(receive(firstConnection), 2);
+
+	// The publisher is deleted while it tries to reconnect
+	firstConnection.close();
+	acceptor.close();
+	for (fmiInteger i = 3; i < 10; i++)
+	{
+		trigger(publisher, i);
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	BOOST_CHECK_EQUAL(pool->getNumberOfThreads(), 1);
+}
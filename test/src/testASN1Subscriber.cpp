@@ -22,10 +22,18 @@
 #include "PrintableFactory.h"
 #include "timing/EventSink.h"
 #include "network/Subscriber.h"
+#include "network/CompactASN1Subscriber.h"
 #include "network/CompactASN1TCPClientSubscriber.h"
+#include "network/CompactASN1UDPSubscriber.h"
+#include "network/CompactASN1TCPServerSubscriber.h"
+#include "network/IOServicePool.h"
 #include "base/BaseExceptions.h"
 
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/ip/udp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/test/data/test_case.hpp>
 #include <boost/log/trivial.hpp>
@@ -198,6 +206,21 @@ public:
 		config_.add("packetTimeout", timeout);
 	}
 
+	void setReceiveBatch(int frames)
+	{
+		config_.add("receiveBatch", frames);
+	}
+
+	void setMaxDatagramSize(int size)
+	{
+		config_.add("maxDatagramSize", size);
+	}
+
+	void setMaxConnections(int connections)
+	{
+		config_.add("maxConnections", connections);
+	}
+
 private:
 	/** @brief Transmission channel reference which is constructed on demand */
 	std::shared_ptr<Base::TransmissionChannel> channel_;
@@ -772,3 +795,538 @@ BOOST_DATA_TEST_CASE_F(ASN1SubscriberFixture, testInvalidTypeCode,
 }
 
 /** TODO: Test type conversion system extensively */
+
+/**
+ * @brief Subscriber without network connection which exposes the size of the
+ * requested receive buffers
+ */
+class ReceiveSizeProbe: public CompactASN1Subscriber
+{
+public:
+	/** @brief Initializes the subscriber without starting it */
+	void initProbe(const Base::TransmissionChannel &channel,
+		std::shared_ptr<Timing::EventSink> eventSink)
+	{
+		init(channel, eventSink);
+	}
+
+	/** @brief Returns the size of the next receive buffer */
+	size_t getReceiveSize()
+	{
+		size_t size = boost::asio::buffer_size(prepareData());
+		commitData(0);
+		return size;
+	}
+
+	/** @brief Passes the given bytes as a single chunk */
+	void receive(const std::vector<uint8_t> &data)
+	{
+		auto buffer = prepareData();
+		BOOST_REQUIRE_GE(boost::asio::buffer_size(buffer), data.size());
+		boost::asio::buffer_copy(buffer, boost::asio::buffer(data));
+		commitData(data.size());
+	}
+
+protected:
+	virtual void initNetwork() {}
+	virtual void terminateNetworkConnection() {}
+};
+
+/** @brief Checks that receive buffers are sized by the port template */
+BOOST_FIXTURE_TEST_CASE(testReceiveSize, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeBoolean);
+	addPortConfig(fmiTypeString);
+	addPortConfig(fmiTypeReal);
+	addPortConfig(fmiTypeInteger);
+	setValidAddressConfig();
+
+	ReceiveSizeProbe probe;
+	probe.initProbe(*getTransmissionChannel(), eventSink_);
+
+	// BOOL, empty STRING, LREAL, DINT
+	BOOST_CHECK_EQUAL(probe.getReceiveSize(), 1 + 3 + 9 + 5);
+
+	probe.receive({0x41});
+	BOOST_CHECK_EQUAL(probe.getReceiveSize(), 3 + 9 + 5);
+
+	// The string header announces three characters
+	probe.receive({0x50, 0x00, 0x03});
+	BOOST_CHECK_EQUAL(probe.getReceiveSize(), 3 + 9 + 5);
+
+	probe.receive({0x48, 0x69, 0x21, 0x4b});
+	BOOST_CHECK_EQUAL(probe.getReceiveSize(), 8 + 5);
+
+	probe.receive({0x40, 0x09, 0x21, 0xfb, 0x54, 0x44, 0x2d, 0x18, 
+		0x44, 0x7F, 0xFF, 0xFF, 0xFF});
+	Timing::Event *ev = eventSink_->fetchNextEvent();
+	BOOST_REQUIRE(ev != NULL);
+	BOOST_CHECK_EQUAL(ev->getVariables().size(), 4);
+	delete ev;
+
+	BOOST_CHECK_EQUAL(probe.getReceiveSize(), 1 + 3 + 9 + 5);
+}
+
+/** @brief Checks the size of batched receive buffers */
+BOOST_FIXTURE_TEST_CASE(testReceiveBatchSize, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	addPortConfig(fmiTypeInteger);
+	setValidAddressConfig();
+	setReceiveBatch(4);
+
+	ReceiveSizeProbe probe;
+	probe.initProbe(*getTransmissionChannel(), eventSink_);
+	BOOST_CHECK_EQUAL(probe.getReceiveSize(), 4 * (9 + 5));
+
+	probe.receive({0x4b, 0x40, 0x09});
+	BOOST_CHECK_EQUAL(probe.getReceiveSize(), 6 + 5 + 3 * (9 + 5));
+}
+
+/** @brief Applies an invalid receive batch size */
+BOOST_FIXTURE_TEST_CASE(testInvalidReceiveBatch, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	setValidAddressConfig();
+	setReceiveBatch(0);
+
+	ReceiveSizeProbe probe;
+	BOOST_CHECK_THROW(probe.initProbe(*getTransmissionChannel(), eventSink_),
+		Base::SystemConfigurationException);
+}
+
+/** 
+ * @brief Receives fixed-layout frames, frames which need to be converted, and
+ * split frames
+ */
+BOOST_FIXTURE_TEST_CASE(testFixedLayoutFrames, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	addPortConfig(fmiTypeInteger);
+	addPortConfig(fmiTypeBoolean);
+	setValidAddressConfig();
+
+	ReceiveSizeProbe probe;
+	probe.initProbe(*getTransmissionChannel(), eventSink_);
+
+	const std::vector<std::vector<uint8_t>> chunks = {
+		// LREAL, DINT, BOOL (fixed layout)
+		{0x4b, 0x40, 0x09, 0x21, 0xfb, 0x54, 0x44, 0x2d, 0x18, 
+		 0x44, 0xFF, 0xFF, 0xFF, 0xFE, 0x41},
+		// REAL, DINT, BOOL (converted)
+		{0x4a, 0x3f, 0xc0, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x2A, 0x40},
+		// LREAL, DINT, BOOL (split)
+		{0x4b, 0xc0, 0x00, 0x00, 0x00},
+		{0x00, 0x00, 0x00, 0x00, 0x44, 0x00, 0x00, 0x00, 0x07, 0x40}
+	};
+	const fmiReal reals[] = {3.14159265359, 1.5, -2.0};
+	const fmiInteger ints[] = {-2, 42, 7};
+	const fmiBoolean bools[] = {fmiTrue, fmiFalse, fmiFalse};
+
+	for (int i = 0; i < 3; i++)
+	{
+		probe.receive(chunks[i]);
+		if (i == 2) probe.receive(chunks[3]);
+
+		Timing::Event *ev = eventSink_->fetchNextEvent();
+		BOOST_REQUIRE(ev != NULL);
+		const std::vector<Timing::Variable> &vars = ev->getVariables();
+		BOOST_REQUIRE_EQUAL(vars.size(), 3);
+		BOOST_CHECK_CLOSE(vars[0].getRealValue(), reals[i], 1e-9);
+		BOOST_CHECK_EQUAL(vars[1].getIntegerValue(), ints[i]);
+		BOOST_CHECK_EQUAL(vars[2].getBooleanValue(), bools[i]);
+		BOOST_CHECK(vars[2].getID() == Base::PortID(fmiTypeBoolean, 2));
+		delete ev;
+	}
+	BOOST_CHECK_EQUAL(probe.getReceiveSize(), 9 + 5 + 1);
+}
+
+/** @brief Sends each datagram to the UDP subscriber on the local host */
+class UDPTestSender
+{
+public:
+	UDPTestSender(): service_(), socket_(service_), 
+		destination_(boost::asio::ip::address_v4::loopback(), 4242)
+	{
+		socket_.open(boost::asio::ip::udp::v4());
+	}
+
+	/** @brief Sends the given data as single datagram */
+	void send(const std::vector<uint8_t> &data)
+	{
+		socket_.send_to(boost::asio::buffer(data), destination_);
+	}
+
+private:
+	boost::asio::io_service service_;
+	boost::asio::ip::udp::socket socket_;
+	boost::asio::ip::udp::endpoint destination_;
+};
+
+/** @brief Receives complete and incomplete datagrams */
+BOOST_FIXTURE_TEST_CASE(testUDPDatagrams, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	addPortConfig(fmiTypeInteger);
+	setAddress("127.0.0.1:4242");
+
+	CompactASN1UDPSubscriber subscriber;
+	subscriber.initAndStart(*getTransmissionChannel(), eventSink_, 
+		getErrorCallback());
+	UDPTestSender sender;
+
+	// LREAL, DINT
+	sender.send({0x4b, 0x40, 0x09, 0x21, 0xfb, 0x54, 0x44, 0x2d, 0x18, 
+		0x44, 0x00, 0x00, 0x00, 0x2A});
+	Timing::Event *ev = eventSink_->fetchNextEvent();
+	BOOST_REQUIRE(ev != NULL);
+	BOOST_REQUIRE_EQUAL(ev->getVariables().size(), 2);
+	BOOST_CHECK_CLOSE(ev->getVariables()[0].getRealValue(), 3.14159265359, 
+		1e-9);
+	BOOST_CHECK_EQUAL(ev->getVariables()[1].getIntegerValue(), 42);
+	// The event is dated back by the (small) age of the datagram
+	BOOST_CHECK_LE(ev->getTime(), 0.0);
+	BOOST_CHECK_GT(ev->getTime(), -1.0);
+	delete ev;
+
+	// A datagram always ends the frame
+	sender.send({0x4a, 0x3f, 0xc0, 0x00, 0x00});
+	ev = eventSink_->fetchNextEvent();
+	BOOST_REQUIRE(ev != NULL);
+	BOOST_REQUIRE_EQUAL(ev->getVariables().size(), 1);
+	BOOST_CHECK_EQUAL(ev->getVariables()[0].getRealValue(), 1.5);
+	delete ev;
+
+	sender.send({0x4b, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+		0x44, 0x00, 0x00, 0x00, 0x07});
+	ev = eventSink_->fetchNextEvent();
+	BOOST_REQUIRE(ev != NULL);
+	BOOST_REQUIRE_EQUAL(ev->getVariables().size(), 2);
+	BOOST_CHECK_EQUAL(ev->getVariables()[0].getRealValue(), -2.0);
+	BOOST_CHECK_EQUAL(ev->getVariables()[1].getIntegerValue(), 7);
+	delete ev;
+
+	subscriber.terminate();
+	BOOST_CHECK_NO_THROW(throwLastException());
+}
+
+/** 
+ * @brief Checks that the default datagram size accommodates moderately long 
+ * strings
+ */
+BOOST_FIXTURE_TEST_CASE(testUDPDefaultDatagramSize, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeString);
+	setAddress("127.0.0.1:4242");
+
+	CompactASN1UDPSubscriber subscriber;
+	subscriber.initAndStart(*getTransmissionChannel(), eventSink_, 
+		getErrorCallback());
+	UDPTestSender sender;
+
+	// A datagram which exceeds the default size is dropped
+	std::vector<uint8_t> data = {0x50, 0x10, 0x00};
+	data.resize(3 + 0x1000, 'x');
+	sender.send(data);
+
+	const std::string value(1000, 'a');
+	data = {0x50, 0x03, 0xe8};
+	data.insert(data.end(), value.begin(), value.end());
+	sender.send(data);
+
+	Timing::Event *ev = eventSink_->fetchNextEvent();
+	BOOST_REQUIRE(ev != NULL);
+	BOOST_REQUIRE_EQUAL(ev->getVariables().size(), 1);
+	BOOST_CHECK_EQUAL(ev->getVariables()[0].getStringValue(), value);
+	delete ev;
+
+	subscriber.terminate();
+	BOOST_CHECK_NO_THROW(throwLastException());
+}
+
+/** @brief Applies invalid configurations of the UDP subscriber */
+BOOST_FIXTURE_TEST_CASE(testUDPInvalidConfiguration, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	{
+		CompactASN1UDPSubscriber subscriber;
+		BOOST_CHECK_THROW(subscriber.initAndStart(*getTransmissionChannel(), 
+			eventSink_, getErrorCallback()), Base::SystemConfigurationException);
+	}
+
+	setAddress("127.0.0.1:");
+	{
+		CompactASN1UDPSubscriber subscriber;
+		BOOST_CHECK_THROW(subscriber.initAndStart(*getTransmissionChannel(), 
+			eventSink_, getErrorCallback()), Base::SystemConfigurationException);
+	}
+}
+
+/** @brief Applies an invalid maximum datagram size */
+BOOST_FIXTURE_TEST_CASE(testUDPInvalidDatagramSize, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	setAddress("127.0.0.1:4242");
+	setMaxDatagramSize(0);
+
+	CompactASN1UDPSubscriber subscriber;
+	BOOST_CHECK_THROW(subscriber.initAndStart(*getTransmissionChannel(), 
+		eventSink_, getErrorCallback()), Base::SystemConfigurationException);
+	BOOST_CHECK_NO_THROW(throwLastException());
+}
+
+/** @brief Client which connects to the TCP server subscriber */
+class TCPTestClient
+{
+public:
+	TCPTestClient(boost::asio::io_service &service): socket_(service)
+	{
+		socket_.connect(boost::asio::ip::tcp::endpoint(
+			boost::asio::ip::address_v4::loopback(), 4243));
+	}
+
+	/** @brief Sends the given data */
+	void send(const std::vector<uint8_t> &data)
+	{
+		boost::asio::write(socket_, boost::asio::buffer(data));
+	}
+
+	/** @brief Waits until the server closes the connection */
+	void waitForClosedConnection()
+	{
+		uint8_t buffer;
+		boost::system::error_code err;
+		boost::asio::read(socket_, boost::asio::buffer(&buffer, 1), err);
+		BOOST_CHECK(err == boost::asio::error::eof || 
+			err == boost::asio::error::connection_reset);
+	}
+
+	/** @brief Closes the connection */
+	void close()
+	{
+		socket_.close();
+	}
+
+private:
+	boost::asio::ip::tcp::socket socket_;
+};
+
+/** @brief Checks the real value of the next event and deletes the event */
+static void checkNextRealEvent(ConcurrentEventSink &sink, 
+	std::vector<fmiReal> expected)
+{
+	Timing::Event *ev = sink.fetchNextEvent();
+	BOOST_REQUIRE(ev != NULL);
+	const std::vector<Timing::Variable> &vars = ev->getVariables();
+	BOOST_REQUIRE_EQUAL(vars.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		BOOST_CHECK_EQUAL(vars[i].getRealValue(), expected[i]);
+	}
+	delete ev;
+}
+
+/** @brief Receives interleaved frames of several peers */
+BOOST_FIXTURE_TEST_CASE(testTCPServerInterleavedPeers, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	addPortConfig(fmiTypeReal);
+	setAddress("127.0.0.1:4243");
+
+	CompactASN1TCPServerSubscriber subscriber;
+	subscriber.initAndStart(*getTransmissionChannel(), eventSink_, 
+		getErrorCallback());
+
+	boost::asio::io_service service;
+	TCPTestClient first(service), second(service);
+
+	// LREAL 1.5, first half of LREAL 2.0
+	first.send({0x4b, 0x3f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+		0x4b, 0x40, 0x00, 0x00});
+	// LREAL -1.0, LREAL -2.0
+	second.send({0x4b, 0xbf, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+		0x4b, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {-1.0, -2.0});
+
+	first.send({0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {1.5, 2.0});
+
+	// A partial frame is registered as soon as the peer disconnects
+	second.send({0x4b, 0x40, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+		0x4b, 0x40});
+	second.close();
+	checkNextRealEvent(*eventSink_, {3.0});
+
+	// The remaining connection is still served
+	first.send({0x4b, 0x40, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+		0x4b, 0x40, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {4.0, 5.0});
+
+	subscriber.terminate();
+	BOOST_CHECK_NO_THROW(throwLastException());
+}
+
+/** @brief Rejects connections which exceed the maximum number */
+BOOST_FIXTURE_TEST_CASE(testTCPServerConnectionLimit, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	setAddress("127.0.0.1:4243");
+	setMaxConnections(1);
+
+	CompactASN1TCPServerSubscriber subscriber;
+	subscriber.initAndStart(*getTransmissionChannel(), eventSink_, 
+		getErrorCallback());
+
+	boost::asio::io_service service;
+	TCPTestClient first(service);
+	first.send({0x4b, 0x3f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {1.5});
+
+	TCPTestClient second(service);
+	second.waitForClosedConnection();
+
+	first.send({0x4b, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {2.0});
+
+	subscriber.terminate();
+	BOOST_CHECK_NO_THROW(throwLastException());
+}
+
+/** @brief Applies invalid configurations of the TCP server subscriber */
+BOOST_FIXTURE_TEST_CASE(testTCPServerInvalidConfiguration, 
+	ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	{
+		CompactASN1TCPServerSubscriber subscriber;
+		BOOST_CHECK_THROW(subscriber.initAndStart(*getTransmissionChannel(), 
+			eventSink_, getErrorCallback()), Base::SystemConfigurationException);
+	}
+
+	setAddress("127.0.0.1:4243");
+	setMaxConnections(0);
+	{
+		CompactASN1TCPServerSubscriber subscriber;
+		BOOST_CHECK_THROW(subscriber.initAndStart(*getTransmissionChannel(), 
+			eventSink_, getErrorCallback()), Base::SystemConfigurationException);
+	}
+}
+
+/** @brief Serves several subscribers by a single shared thread pool */
+BOOST_FIXTURE_TEST_CASE(testSharedIOServicePool, ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	setAddress("127.0.0.1:4242");
+
+	boost::property_tree::ptree serverConfig;
+	serverConfig.add("addr", "127.0.0.1:4243");
+	serverConfig.add("packetTimeout", 100);
+	serverConfig.add("0", "x0");
+	serverConfig.add("0.type", (int) fmiTypeReal);
+	serverConfig.add("1", "x1");
+	serverConfig.add("1.type", (int) fmiTypeReal);
+	Base::TransmissionChannel serverChannel(serverConfig);
+	serverChannel.pushBackPort(Base::PortID(fmiTypeReal, 0), 
+		serverConfig.get_child("0"));
+	serverChannel.pushBackPort(Base::PortID(fmiTypeReal, 1), 
+		serverConfig.get_child("1"));
+
+	auto pool = std::make_shared<IOServicePool>(2, getErrorCallback());
+	CompactASN1UDPSubscriber udpSubscriber;
+	CompactASN1TCPServerSubscriber tcpSubscriber;
+	udpSubscriber.setIOServicePool(pool);
+	tcpSubscriber.setIOServicePool(pool);
+	udpSubscriber.initAndStart(*getTransmissionChannel(), eventSink_, 
+		getErrorCallback());
+	tcpSubscriber.initAndStart(serverChannel, eventSink_, getErrorCallback());
+
+	UDPTestSender sender;
+	sender.send({0x4b, 0x3f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {1.5});
+
+	boost::asio::io_service service;
+	TCPTestClient client(service);
+	client.send({0x4b, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x4b, 0x40, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {2.0, 3.0});
+
+	// The packet timer is served by the pool, too
+	client.send({0x4b, 0x40, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {4.0});
+
+	sender.send({0x4b, 0x40, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {5.0});
+
+	// Pending handlers are completed while the pool keeps running
+	udpSubscriber.terminate();
+	tcpSubscriber.terminate();
+	BOOST_CHECK_EQUAL(pool->getNumberOfThreads(), 2);
+	BOOST_CHECK_NO_THROW(throwLastException());
+}
+
+/** 
+ * @brief Checks that a reconnecting TCP client doesn't block the single 
+ * thread of a shared pool
+ */
+BOOST_FIXTURE_TEST_CASE(testSharedIOServicePoolReconnection, 
+	ASN1SubscriberFixture)
+{
+	addPortConfig(fmiTypeReal);
+	setAddress("127.0.0.1:4242");
+
+	boost::property_tree::ptree clientConfig;
+	clientConfig.add("addr", "127.0.0.1:4243");
+	clientConfig.add("reconnectionInterval", 2000);
+	clientConfig.add("0", "x0");
+	clientConfig.add("0.type", (int) fmiTypeReal);
+	Base::TransmissionChannel clientChannel(clientConfig);
+	clientChannel.pushBackPort(Base::PortID(fmiTypeReal, 0), 
+		clientConfig.get_child("0"));
+
+	boost::asio::io_service service;
+	std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor(
+		new boost::asio::ip::tcp::acceptor(service, boost::asio::ip::tcp::endpoint(
+			boost::asio::ip::address_v4::loopback(), 4243)));
+
+	auto pool = std::make_shared<IOServicePool>(1, getErrorCallback());
+	CompactASN1UDPSubscriber udpSubscriber;
+	CompactASN1TCPClientSubscriber tcpSubscriber;
+	udpSubscriber.setIOServicePool(pool);
+	tcpSubscriber.setIOServicePool(pool);
+	udpSubscriber.initAndStart(*getTransmissionChannel(), eventSink_, 
+		getErrorCallback());
+	tcpSubscriber.initAndStart(clientChannel, eventSink_, getErrorCallback());
+
+	// Refuse the reconnection attempts
+	boost::asio::ip::tcp::socket connection(service);
+	acceptor->accept(connection);
+	connection.close();
+	acceptor.reset();
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	// The pool still serves other channels while the client waits
+	auto start = std::chrono::steady_clock::now();
+	UDPTestSender sender;
+	sender.send({0x4b, 0x3f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+	checkNextRealEvent(*eventSink_, {1.5});
+	BOOST_CHECK_LT(std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count(), 1.0);
+
+	// The client finally reconnects
+	acceptor.reset(new boost::asio::ip::tcp::acceptor(service, 
+		boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 
+			4243)));
+	acceptor->accept(connection);
+	boost::asio::write(connection, boost::asio::buffer(std::vector<uint8_t>(
+		{0x4b, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00})));
+	checkNextRealEvent(*eventSink_, {2.0});
+
+	// The subscriber is terminated while it waits for the server
+	connection.close();
+	acceptor.reset();
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	udpSubscriber.terminate();
+	tcpSubscriber.terminate();
+	BOOST_CHECK_EQUAL(pool->getNumberOfThreads(), 1);
+	BOOST_CHECK_NO_THROW(throwLastException());
+}
@@ -279,6 +279,26 @@ BOOST_AUTO_TEST_CASE( test_get_real_positive_double_property )
 	BOOST_CHECK_EQUAL(context.getRealPositiveDoubleProperty("nope", 0.1), 0.1);
 }
 
+/** @brief Tests the getRealPositiveIntegerProperty function */
+BOOST_AUTO_TEST_CASE( test_get_real_positive_integer_property )
+{
+	const char * argv[] = {"testApplicationContext", "0.zero.0=0", 
+		"1.one.1=1", "2.two.2=two", "3.three.3=-3", "4.four.4=4.5", NULL};
+	ApplicationContext context;
+	context.addCommandlineProperties(6,argv);
+
+	BOOST_CHECK_THROW(context.getRealPositiveIntegerProperty("0.zero.0", 1),
+		std::invalid_argument);
+	BOOST_CHECK_THROW(context.getRealPositiveIntegerProperty("2.two.2", 1), 
+		std::invalid_argument);
+	BOOST_CHECK_THROW(context.getRealPositiveIntegerProperty("3.three.3", 1), 
+		std::invalid_argument);
+	BOOST_CHECK_THROW(context.getRealPositiveIntegerProperty("4.four.4", 1), 
+		std::invalid_argument);
+	BOOST_CHECK_EQUAL(context.getRealPositiveIntegerProperty("1.one.1", 2), 1);
+	BOOST_CHECK_EQUAL(context.getRealPositiveIntegerProperty("nope", 2), 2);
+}
+
 /** @brief Tests the getPropertyTree function */
 BOOST_AUTO_TEST_CASE( test_get_property_tree )
 {
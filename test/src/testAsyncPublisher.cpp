@@ -0,0 +1,289 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file testAsyncPublisher.cpp
+ * @brief Contains the test-cases examining the AsyncPublisher
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#define BOOST_TEST_MODULE testAsyncPublisher
+#include <boost/test/unit_test.hpp>
+
+#include "base/BaseExceptions.h"
+#include "base/TransmissionChannel.h"
+#include "network/AsyncPublisher.h"
+#include "timing/StaticEvent.h"
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+using namespace FMITerminalBlock;
+using namespace FMITerminalBlock::Network;
+
+/**
+ * @brief Records the real values of each published event
+ * @details The publisher blocks each event until the gate is opened. An
+ * exception is thrown on every event at which the value of x is negative.
+ */
+class GatedRecordingPublisher: public Publisher
+{
+public:
+	GatedRecordingPublisher(): open_(true), started_(0) {}
+
+	virtual void init(const Base::TransmissionChannel &) {}
+
+	virtual void eventTriggered(Timing::Event * ev)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		started_++;
+		changed_.notify_all();
+		changed_.wait(lock, [this]() { return open_; });
+
+		std::vector<fmiReal> values;
+		const std::vector<Timing::Variable> &vars = ev->getVariables();
+		for (auto it = vars.begin(); it != vars.end(); ++it)
+		{
+			values.push_back(it->getRealValue());
+		}
+		if (!values.empty() && values[0] < 0.0)
+		{
+			throw std::runtime_error("Negative value");
+		}
+		published_.push_back(values);
+		changed_.notify_all();
+	}
+
+	/** @brief Opens or closes the gate */
+	void setOpen(bool open)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		open_ = open;
+		changed_.notify_all();
+	}
+
+	/** @brief Waits until the given number of events entered the publisher */
+	void waitForStarted(unsigned count)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		BOOST_REQUIRE(changed_.wait_for(lock, std::chrono::seconds(5),
+			[this, count]() { return started_ >= count; }));
+	}
+
+	/** @brief Waits until the given number of events were recorded */
+	void waitForPublished(size_t count)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		BOOST_REQUIRE(changed_.wait_for(lock, std::chrono::seconds(5),
+			[this, count]() { return published_.size() >= count; }));
+	}
+
+	/** @brief Returns a copy of the recorded values */
+	std::vector<std::vector<fmiReal>> getPublished()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return published_;
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable changed_;
+	bool open_;
+	unsigned started_;
+	std::vector<std::vector<fmiReal>> published_;
+};
+
+/** @brief Provides a channel of two real-valued ports x and y */
+class AsyncPublisherFixture
+{
+public:
+	boost::property_tree::ptree config_;
+	std::shared_ptr<Base::TransmissionChannel> channel_;
+	std::shared_ptr<GatedRecordingPublisher> recorder_;
+	std::exception_ptr error_;
+
+	AsyncPublisherFixture(): config_(), channel_(),
+		recorder_(std::make_shared<GatedRecordingPublisher>()), error_()
+	{
+		config_.put("0", "x");
+		config_.put("1", "y");
+	}
+
+	/** @brief Returns an initialized publisher which wraps the recorder */
+	std::shared_ptr<AsyncPublisher> createPublisher()
+	{
+		channel_ = std::make_shared<Base::TransmissionChannel>(config_);
+		channel_->pushBackPort(std::make_pair(fmiTypeReal, 0),
+			config_.get_child("0"));
+		channel_->pushBackPort(std::make_pair(fmiTypeReal, 1),
+			config_.get_child("1"));
+
+		auto pub = std::make_shared<AsyncPublisher>(recorder_,
+			[this](std::exception_ptr err) { error_ = err; });
+		pub->init(*channel_);
+		return pub;
+	}
+
+	/** @brief Triggers an event which contains all values except NaN ones */
+	static void trigger(AsyncPublisher * pub, fmiReal x, fmiReal y)
+	{
+		std::vector<Timing::Variable> vars;
+		if (!std::isnan(x)) vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeReal, 0), x));
+		if (!std::isnan(y)) vars.push_back(Timing::Variable(
+			std::make_pair(fmiTypeReal, 1), y));
+		Timing::StaticEvent ev(0.0, vars);
+		pub->eventTriggered(&ev);
+	}
+};
+
+/** @brief Publishes some events without any overflow */
+BOOST_FIXTURE_TEST_CASE(test_publish_in_order, AsyncPublisherFixture)
+{
+	auto pub = createPublisher();
+	for (int i = 0; i < 5; i++)
+	{
+		trigger(pub.get(), (fmiReal) i, 10.0 + i);
+	}
+	recorder_->waitForPublished(5);
+
+	auto published = recorder_->getPublished();
+	BOOST_REQUIRE_EQUAL(published.size(), 5);
+	for (int i = 0; i < 5; i++)
+	{
+		BOOST_REQUIRE_EQUAL(published[i].size(), 2);
+		BOOST_CHECK_EQUAL(published[i][0], (fmiReal) i);
+		BOOST_CHECK_EQUAL(published[i][1], 10.0 + i);
+	}
+	BOOST_CHECK(!error_);
+}
+
+/** @brief Drops the oldest events of a blocked publisher */
+BOOST_FIXTURE_TEST_CASE(test_overflow_drop_oldest, AsyncPublisherFixture)
+{
+	config_.put(AsyncPublisher::PROP_QUEUE_SIZE, "2");
+	config_.put(AsyncPublisher::PROP_OVERFLOW, "drop-oldest");
+	auto pub = createPublisher();
+
+	recorder_->setOpen(false);
+	trigger(pub.get(), 0.0, 0.0);
+	recorder_->waitForStarted(1);
+	for (int i = 1; i < 5; i++)
+	{
+		trigger(pub.get(), (fmiReal) i, (fmiReal) i);
+	}
+	recorder_->setOpen(true);
+	recorder_->waitForPublished(3);
+
+	auto published = recorder_->getPublished();
+	BOOST_REQUIRE_EQUAL(published.size(), 3);
+	BOOST_CHECK_EQUAL(published[0][0], 0.0);
+	BOOST_CHECK_EQUAL(published[1][0], 3.0);
+	BOOST_CHECK_EQUAL(published[2][0], 4.0);
+}
+
+/** @brief Merges the events of a blocked publisher */
+BOOST_FIXTURE_TEST_CASE(test_overflow_coalesce_latest, AsyncPublisherFixture)
+{
+	config_.put(AsyncPublisher::PROP_QUEUE_SIZE, "1");
+	config_.put(AsyncPublisher::PROP_OVERFLOW, "coalesce-latest");
+	auto pub = createPublisher();
+
+	recorder_->setOpen(false);
+	trigger(pub.get(), 0.0, 0.0);
+	recorder_->waitForStarted(1);
+	trigger(pub.get(), 1.0, 1.0);
+	trigger(pub.get(), NAN, 2.0);
+	trigger(pub.get(), 3.0, NAN);
+	recorder_->setOpen(true);
+	recorder_->waitForPublished(2);
+
+	auto published = recorder_->getPublished();
+	BOOST_REQUIRE_EQUAL(published.size(), 2);
+	BOOST_REQUIRE_EQUAL(published[1].size(), 2);
+	BOOST_CHECK_EQUAL(published[1][0], 3.0);
+	BOOST_CHECK_EQUAL(published[1][1], 2.0);
+}
+
+/** @brief Blocks the dispatcher until the queue has some free space */
+BOOST_FIXTURE_TEST_CASE(test_overflow_block, AsyncPublisherFixture)
+{
+	config_.put(AsyncPublisher::PROP_QUEUE_SIZE, "1");
+	auto pub = createPublisher();
+
+	recorder_->setOpen(false);
+	trigger(pub.get(), 0.0, 0.0);
+	recorder_->waitForStarted(1);
+	trigger(pub.get(), 1.0, 1.0);
+
+	std::thread opener([this]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		recorder_->setOpen(true);
+	});
+	trigger(pub.get(), 2.0, 2.0);
+	opener.join();
+	recorder_->waitForPublished(3);
+
+	auto published = recorder_->getPublished();
+	BOOST_REQUIRE_EQUAL(published.size(), 3);
+	for (int i = 0; i < 3; i++)
+	{
+		BOOST_CHECK_EQUAL(published[i][0], (fmiReal) i);
+	}
+}
+
+/** @brief Passes an exception of the wrapped publisher to the callback */
+BOOST_FIXTURE_TEST_CASE(test_publisher_exception, AsyncPublisherFixture)
+{
+	auto pub = createPublisher();
+	trigger(pub.get(), -1.0, 0.0);
+	trigger(pub.get(), 1.0, 0.0);
+	recorder_->waitForPublished(1);
+	pub.reset();
+
+	BOOST_REQUIRE(error_);
+	BOOST_CHECK_THROW(std::rethrow_exception(error_), std::runtime_error);
+}
+
+/** @brief Checks the detection of the asynchronous mode */
+BOOST_FIXTURE_TEST_CASE(test_is_enabled, AsyncPublisherFixture)
+{
+	Base::TransmissionChannel channel(config_);
+	BOOST_CHECK(!AsyncPublisher::isEnabled(channel));
+	config_.put(AsyncPublisher::PROP_ASYNC, "true");
+	BOOST_CHECK(AsyncPublisher::isEnabled(channel));
+	config_.put(AsyncPublisher::PROP_ASYNC, "maybe");
+	BOOST_CHECK_THROW(AsyncPublisher::isEnabled(channel),
+		Base::SystemConfigurationException);
+}
+
+/** @brief Applies an invalid queue size */
+BOOST_FIXTURE_TEST_CASE(test_invalid_queue_size, AsyncPublisherFixture)
+{
+	config_.put(AsyncPublisher::PROP_QUEUE_SIZE, "0");
+	BOOST_CHECK_THROW(createPublisher(), Base::SystemConfigurationException);
+}
+
+/** @brief Applies a malformed queue size */
+BOOST_FIXTURE_TEST_CASE(test_malformed_queue_size, AsyncPublisherFixture)
+{
+	config_.put(AsyncPublisher::PROP_QUEUE_SIZE, "many");
+	BOOST_CHECK_THROW(createPublisher(), Base::SystemConfigurationException);
+}
+
+/** @brief Applies an invalid overflow policy */
+BOOST_FIXTURE_TEST_CASE(test_invalid_overflow_policy, AsyncPublisherFixture)
+{
+	config_.put(AsyncPublisher::PROP_OVERFLOW, "ignore");
+	BOOST_CHECK_THROW(createPublisher(), Base::SystemConfigurationException);
+}
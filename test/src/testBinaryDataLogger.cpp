@@ -0,0 +1,315 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file testBinaryDataLogger.cpp
+ * @brief Tests the binary data logging facility
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#define BOOST_TEST_MODULE testBinaryDataLogger
+#include <boost/test/unit_test.hpp>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+
+#include "timing/BinaryDataLogger.h"
+#include "timing/CSVDataLogger.h"
+#include "timing/DataLoggerFactory.h"
+#include "timing/StaticEvent.h"
+#include "base/BaseExceptions.h"
+#include "base/ApplicationContext.h"
+
+using namespace FMITerminalBlock::Base;
+using namespace FMITerminalBlock::Timing;
+
+namespace data = boost::unit_test::data;
+
+/** @brief Reads the values of a binary data file */
+class BinaryFile
+{
+public:
+	/** @brief A single column of the schema header */
+	struct Column
+	{
+		uint32_t type;
+		uint32_t id;
+		uint32_t offset;
+		std::string name;
+	};
+
+	/** @brief Parses the header and checks the basic structure */
+	BinaryFile(const std::string &content): content_(content), columns_()
+	{
+		BOOST_REQUIRE_GE(content_.size(), 32);
+		BOOST_REQUIRE_EQUAL(content_.substr(0, 8), "FMITBDAT");
+		BOOST_REQUIRE_EQUAL(get<uint32_t>(8), 
+			(uint32_t) BinaryDataLogger::BYTE_ORDER_MARK);
+		BOOST_REQUIRE_EQUAL(get<uint32_t>(12), 
+			(uint32_t) BinaryDataLogger::FORMAT_VERSION);
+		BOOST_REQUIRE_EQUAL(get<uint32_t>(28), 0);
+
+		size_t pos = 32;
+		for (uint32_t i = 0; i < get<uint32_t>(16); i++)
+		{
+			Column col;
+			col.type = get<uint32_t>(pos);
+			col.id = get<uint32_t>(pos + 4);
+			col.offset = get<uint32_t>(pos + 8);
+			uint32_t length = get<uint32_t>(pos + 12);
+			col.name = content_.substr(pos + 16, length);
+			pos += 16 + length;
+			columns_.push_back(col);
+		}
+		BOOST_REQUIRE_LE(pos, getDataOffset());
+		BOOST_CHECK_EQUAL(getDataOffset() % 8, 0);
+		BOOST_CHECK_EQUAL(getRecordSize() % 8, 0);
+	}
+
+	/** @brief Returns the native value at the given position */
+	template<typename Type>
+	Type get(size_t pos) const
+	{
+		BOOST_REQUIRE_LE(pos + sizeof(Type), content_.size());
+		Type ret;
+		memcpy(&ret, content_.data() + pos, sizeof(ret));
+		return ret;
+	}
+
+	uint32_t getRecordSize() const { return get<uint32_t>(20); }
+	uint32_t getDataOffset() const { return get<uint32_t>(24); }
+	const std::vector<Column> &getColumns() const { return columns_; }
+	size_t getSize() const { return content_.size(); }
+
+	/** @brief Returns whether the column of the record at pos is present */
+	bool isPresent(size_t pos, unsigned column) const
+	{
+		return (get<uint8_t>(pos + 8 + column / 8) & (1u << (column % 8))) != 0;
+	}
+
+	/** @brief Returns the string at the given position */
+	std::string getString(size_t pos, size_t length) const
+	{
+		return content_.substr(pos, length);
+	}
+
+private:
+	std::string content_;
+	std::vector<Column> columns_;
+};
+
+/** @brief Returns a configuration which covers all in- and output types */
+std::shared_ptr<ApplicationContext> makeCompleteAppContext()
+{
+	std::shared_ptr<ApplicationContext> appContext;
+	appContext = std::make_shared<ApplicationContext>();
+	const char *args[] = {
+		"testBinaryLogger", 
+		"in.0.0=ia", "in.0.0.type=0", 
+		"in.0.1=ib", "in.0.1.type=1", 
+		"in.0.2=ic", "in.0.2.type=2",
+		"in.0.3=id", "in.0.3.type=3",
+
+		"out.0.0=oa", "out.0.0.type=0", 
+		"out.0.1=ob", "out.0.1.type=1", 
+		"out.0.2=oc", "out.0.2.type=2",
+		"out.0.3=od", "out.0.3.type=3"
+	};
+	appContext->addCommandlineProperties(sizeof(args) / sizeof(args[0]), args);
+	return appContext;
+}
+
+/** @brief Instantiates a logger with an empty configuration */
+BOOST_AUTO_TEST_CASE(testEmptyConfig)
+{
+	ApplicationContext appContext;
+	BinaryDataLogger logger(appContext);
+
+	StaticEvent ev(0.1, {});
+	logger.eventTriggered(&ev);
+}
+
+/** @brief Test the schema header of the complete configuration */
+BOOST_AUTO_TEST_CASE(testHeader)
+{
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	std::ostringstream stream;
+	{
+		BinaryDataLogger logger(stream, appContext);
+	}
+
+	BinaryFile file(stream.str());
+	BOOST_CHECK_EQUAL(file.getSize(), file.getDataOffset());
+
+	const char *names[] = {"ia", "ib", "ic", "id", "oa", "ob", "oc", "od"};
+	const uint32_t types[] = {0, 1, 2, 3, 0, 1, 2, 3};
+	// time, present bits, ia, ib, ic, id (aligned), oa (aligned), ...
+	const uint32_t offsets[] = {16, 24, 28, 32, 40, 48, 52, 56};
+	BOOST_REQUIRE_EQUAL(file.getColumns().size(), 8);
+	for (unsigned i = 0; i < 8; i++)
+	{
+		BOOST_CHECK_EQUAL(file.getColumns()[i].name, names[i]);
+		BOOST_CHECK_EQUAL(file.getColumns()[i].type, types[i]);
+		BOOST_CHECK_EQUAL(file.getColumns()[i].offset, offsets[i]);
+	}
+	BOOST_CHECK_EQUAL(file.getRecordSize(), 64);
+}
+
+/** @brief Test the encoding of every data type */
+BOOST_AUTO_TEST_CASE(testAllTypes)
+{
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	std::ostringstream stream;
+	{
+		BinaryDataLogger logger(stream, appContext);
+
+		std::vector<Variable> vars;
+		vars.push_back(Variable(PortID(fmiTypeReal, 1), (fmiReal) 0.1));
+		vars.push_back(Variable(PortID(fmiTypeInteger, 0), (fmiInteger) -42));
+		vars.push_back(Variable(PortID(fmiTypeBoolean, 1), (fmiBoolean) fmiTrue));
+		vars.push_back(Variable(PortID(fmiTypeString, 0), std::string("a;\"b")));
+		vars.push_back(Variable(PortID(fmiTypeString, 1), std::string("cd")));
+		StaticEvent ev1(0.5, vars);
+		logger.eventTriggered(&ev1);
+
+		StaticEvent ev2(1.0 / 3.0, {});
+		logger.eventTriggered(&ev2);
+	}
+
+	BinaryFile file(stream.str());
+	const auto &cols = file.getColumns();
+	size_t pos = file.getDataOffset();
+
+	BOOST_CHECK_EQUAL(file.get<double>(pos), 0.5);
+	const bool present[] = {false, true, false, true, true, false, true, true};
+	for (unsigned i = 0; i < 8; i++)
+	{
+		BOOST_CHECK_EQUAL(file.isPresent(pos, i), present[i]);
+	}
+	BOOST_CHECK_EQUAL(file.get<double>(pos + cols[4].offset), 0.1);
+	BOOST_CHECK_EQUAL(file.get<int32_t>(pos + cols[1].offset), -42);
+	BOOST_CHECK_EQUAL(file.get<uint8_t>(pos + cols[6].offset), 1);
+	BOOST_CHECK_EQUAL(file.get<uint32_t>(pos + cols[3].offset), 4);
+	BOOST_CHECK_EQUAL(file.get<uint32_t>(pos + cols[7].offset), 2);
+	// Absent values are set to zero
+	BOOST_CHECK_EQUAL(file.get<double>(pos + cols[0].offset), 0.0);
+
+	// The strings follow in the order of their columns
+	pos += file.getRecordSize();
+	BOOST_CHECK_EQUAL(file.getString(pos, 6), "a;\"bcd");
+	pos += 6;
+
+	BOOST_CHECK_EQUAL(file.get<double>(pos), 1.0 / 3.0);
+	for (unsigned i = 0; i < 8; i++)
+	{
+		BOOST_CHECK(!file.isPresent(pos, i));
+	}
+	BOOST_CHECK_EQUAL(pos + file.getRecordSize(), file.getSize());
+}
+
+/** @brief Test that the first occurrence of a variable wins */
+BOOST_AUTO_TEST_CASE(testDuplicateVariable)
+{
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	std::ostringstream stream;
+	{
+		BinaryDataLogger logger(stream, appContext);
+
+		std::vector<Variable> vars;
+		vars.push_back(Variable(PortID(fmiTypeInteger, 0), (fmiInteger) 1));
+		vars.push_back(Variable(PortID(fmiTypeReal, 1), (fmiReal) 0.5));
+		vars.push_back(Variable(PortID(fmiTypeInteger, 0), (fmiInteger) 2));
+		StaticEvent ev(0.1, vars);
+		logger.eventTriggered(&ev);
+	}
+
+	BinaryFile file(stream.str());
+	const auto &cols = file.getColumns();
+	size_t pos = file.getDataOffset();
+	BOOST_CHECK(file.isPresent(pos, 4));
+	BOOST_CHECK(file.isPresent(pos, 1));
+	BOOST_CHECK_EQUAL(file.get<double>(pos + cols[4].offset), 0.5);
+	BOOST_CHECK_EQUAL(file.get<int32_t>(pos + cols[1].offset), 1);
+	BOOST_CHECK_EQUAL(pos + file.getRecordSize(), file.getSize());
+}
+
+/** @brief Test stream error handling while writing the header */
+BOOST_AUTO_TEST_CASE(testInvalidStream)
+{
+	ApplicationContext appContext;
+	std::ofstream stream("not-all-paths-lead-to-rome/rome.bin",
+		std::ios_base::trunc | std::ios_base::out);
+	BOOST_CHECK(stream.fail());
+	BOOST_CHECK_THROW(BinaryDataLogger logger(stream, appContext), 
+		Base::SystemConfigurationException);
+}
+
+/** @brief Test that the factory writes the configured file format */
+BOOST_AUTO_TEST_CASE(testFactoryBinaryFile)
+{
+	const std::string fileName = "testBinaryDataLogger.bin";
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	appContext.addCommandlineProperties(std::vector<std::string>({
+		"app.dataFile=" + fileName, "app.dataFile.format=binary"}));
+	{
+		std::shared_ptr<EventListener> logger;
+		logger = DataLoggerFactory::makeDataLogger(appContext);
+		BOOST_CHECK(std::dynamic_pointer_cast<BinaryDataLogger>(logger));
+
+		StaticEvent ev(0.25, {Variable(PortID(fmiTypeInteger, 1), 
+			(fmiInteger) 7)});
+		logger->eventTriggered(&ev);
+	}
+
+	std::ifstream in(fileName, std::ios_base::in | std::ios_base::binary);
+	std::string content((std::istreambuf_iterator<char>(in)), 
+		std::istreambuf_iterator<char>());
+	in.close();
+	std::remove(fileName.c_str());
+
+	BinaryFile file(content);
+	size_t pos = file.getDataOffset();
+	BOOST_CHECK_EQUAL(file.get<double>(pos), 0.25);
+	BOOST_CHECK_EQUAL(file.get<int32_t>(pos + file.getColumns()[5].offset), 7);
+	BOOST_CHECK_EQUAL(pos + file.getRecordSize(), file.getSize());
+}
+
+/** @brief Test the default and invalid data file formats */
+BOOST_DATA_TEST_CASE(testFactoryFormats, 
+	data::make(std::vector<std::string>({"", "csv", "binary", "xml"})), format)
+{
+	ApplicationContext appContext;
+	if (!format.empty())
+	{
+		appContext.addCommandlineProperties(std::vector<std::string>({
+			"app.dataFile.format=" + format}));
+	}
+
+	if (format == "xml")
+	{
+		BOOST_CHECK_THROW(DataLoggerFactory::makeDataLogger(appContext), 
+			Base::SystemConfigurationException);
+	} else {
+		std::shared_ptr<EventListener> logger;
+		logger = DataLoggerFactory::makeDataLogger(appContext);
+		BOOST_CHECK_EQUAL(
+			(bool) std::dynamic_pointer_cast<BinaryDataLogger>(logger), 
+			format == "binary");
+		BOOST_CHECK_EQUAL(
+			(bool) std::dynamic_pointer_cast<CSVDataLogger>(logger), 
+			format != "binary");
+	}
+}
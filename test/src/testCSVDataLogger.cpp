@@ -12,14 +12,26 @@
 #define BOOST_TEST_MODULE testCSVDataLogger
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <mutex>
+#include <random>
 #include <sstream>
 #include <vector>
 
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/data/monomorphic.hpp>
 
+#include "timing/AsyncStreamWriter.h"
 #include "timing/CSVDataLogger.h"
+#include "timing/RealFormatter.h"
 #include "timing/StaticEvent.h"
 #include "base/BaseExceptions.h"
 #include "base/ApplicationContext.h"
@@ -201,3 +213,296 @@ BOOST_AUTO_TEST_CASE(testMultipleEvents)
 	BOOST_CHECK_EQUAL(stream.str(), 
 		makeCompleteCSVHeader() + "0;0.1;;;;;;;\n" + "0.1;;;;;0.25;;;\n");
 }
+
+/** @brief Returns the complete configuration with the given flush policy */
+std::shared_ptr<ApplicationContext> makeFlushAppContext(
+	const std::string &policy)
+{
+	std::shared_ptr<ApplicationContext> appContext = makeCompleteAppContext();
+	std::vector<std::string> args = {"app.dataFile.flush=" + policy,
+		"app.dataFile.bufferSize=16"};
+	appContext->addCommandlineProperties(args);
+	return appContext;
+}
+
+/** @brief Test that every flush policy finally writes all rows */
+BOOST_DATA_TEST_CASE(testFlushPolicies, 
+	data::make(std::vector<std::string>({"row", "interval", "size"})), policy)
+{
+	ApplicationContext appContext = *(makeFlushAppContext(policy));
+	std::ostringstream stream;
+	std::string reference = makeCompleteCSVHeader();
+
+	{
+		CSVDataLogger logger(stream, appContext);
+		for (int i = 0; i < 100; i++)
+		{
+			StaticEvent ev = makeEventVarOnly(0, fmiTypeInteger, (fmiInteger) i, 
+				0.5 * i);
+			logger.eventTriggered(&ev);
+
+			std::ostringstream row;
+			row << (0.5 * i) << ";;;;;;" << i << ";;\n";
+			reference += row.str();
+		}
+	}
+
+	BOOST_CHECK_EQUAL(stream.str(), reference);
+}
+
+/** @brief Test invalid flush and backlog configurations */
+BOOST_DATA_TEST_CASE(testInvalidFlushConfig, 
+	data::make(std::vector<std::string>({"app.dataFile.flush=never", 
+		"app.dataFile.flushInterval=0", "app.dataFile.bufferSize=-1", 
+		"app.dataFile.backlog=many", "app.dataFile.overflow=drop-oldest"})), 
+	property)
+{
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	appContext.addCommandlineProperties(std::vector<std::string>({property}));
+	std::ostringstream stream;
+
+	BOOST_CHECK_THROW(CSVDataLogger logger(stream, appContext), 
+		Base::SystemConfigurationException);
+}
+
+/** @brief Stream buffer which blocks the first write until it is released */
+class GateBuffer: public std::stringbuf
+{
+public:
+	/** @brief Waits until a write operation is blocked */
+	void waitUntilEntered()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		changed_.wait(lock, [this]() { return entered_; });
+	}
+
+	/** @brief Lets every write operation pass */
+	void release()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		released_ = true;
+		changed_.notify_all();
+	}
+
+protected:
+	virtual std::streamsize xsputn(const char *s, std::streamsize n)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			entered_ = true;
+			changed_.notify_all();
+			changed_.wait(lock, [this]() { return released_; });
+		}
+		return std::stringbuf::xsputn(s, n);
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable changed_;
+	bool entered_ = false;
+	bool released_ = false;
+};
+
+/** @brief Test that a full backlog drops the handed over rows */
+BOOST_AUTO_TEST_CASE(testDropOverflow)
+{
+	ApplicationContext appContext;
+	appContext.addCommandlineProperties(std::vector<std::string>({
+		"app.dataFile.backlog=1", "app.dataFile.overflow=drop"}));
+	GateBuffer gate;
+	std::ostream destination(&gate);
+
+	{
+		AsyncStreamWriter writer(destination, appContext, "app.dataFile");
+		std::ostream out(&writer);
+
+		out << "a\n";
+		writer.endRecord();
+		gate.waitUntilEntered();
+
+		// The first row is being written and the second one waits
+		out << "b\n";
+		writer.endRecord();
+		out << "c\n";
+		writer.endRecord();
+		BOOST_CHECK_EQUAL(writer.getDroppedRecords(), 1);
+
+		gate.release();
+		writer.flush();
+		out << "d\n";
+		writer.endRecord();
+	}
+
+	BOOST_CHECK_EQUAL(gate.str(), "a\nb\nd\n");
+}
+
+/** @brief Test that a variable which is listed twice populates its column */
+BOOST_AUTO_TEST_CASE(testDuplicateVariable)
+{
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	std::ostringstream stream;
+
+	{
+		CSVDataLogger logger(stream, appContext);
+		std::vector<Variable> vars;
+		vars.push_back(Variable(PortID(fmiTypeInteger, 0), (fmiInteger) 1));
+		vars.push_back(Variable(PortID(fmiTypeReal, 1), (fmiReal) 0.5));
+		vars.push_back(Variable(PortID(fmiTypeInteger, 0), (fmiInteger) 2));
+		StaticEvent ev(0.1, vars);
+		logger.eventTriggered(&ev);
+		logger.eventTriggered(&ev);
+	}
+
+	BOOST_CHECK_EQUAL(stream.str(), makeCompleteCSVHeader() + 
+		"0.1;0.5;;;;;1;;\n" + "0.1;0.5;;;;;1;;\n");
+}
+
+/** @brief Measures the logging rate of a wide model */
+BOOST_AUTO_TEST_CASE(testBenchmarkWideRows)
+{
+	const int columns = 1000;
+	const int rows = 2000;
+
+	std::vector<std::string> args;
+	std::vector<Variable> vars;
+	for (int i = 0; i < columns; i++)
+	{
+		args.push_back("out.0." + std::to_string(i) + "=v" + std::to_string(i));
+		args.push_back("out.0." + std::to_string(i) + ".type=0");
+		vars.push_back(Variable(PortID(fmiTypeReal, i), (fmiReal) i));
+	}
+	ApplicationContext appContext;
+	appContext.addCommandlineProperties(args);
+
+	std::ostringstream stream;
+	std::chrono::steady_clock::duration elapsed;
+	{
+		CSVDataLogger logger(stream, appContext);
+		StaticEvent ev(0.0, vars);
+
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < rows; i++)
+		{
+			logger.eventTriggered(&ev);
+		}
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	const std::string content = stream.str();
+	BOOST_CHECK_EQUAL(std::count(content.begin(), content.end(), '\n'), 
+		rows + 2);
+	BOOST_TEST_MESSAGE("Logged " << rows << " rows of " << columns 
+		<< " columns in " << std::chrono::duration_cast<
+			std::chrono::microseconds>(elapsed).count() << "us");
+}
+
+/** @brief Formats the value by the given formatter */
+std::string formatReal(const RealFormatter &formatter, double value)
+{
+	char buffer[RealFormatter::BUFFER_SIZE];
+	size_t length = formatter.format(value, buffer);
+	return std::string(buffer, length);
+}
+
+/** @brief Test the round-trip exact representation of selected values */
+BOOST_DATA_TEST_CASE(testShortestReal, 
+	data::make(std::vector<double>({0.0, -0.0, 1.0, -2.5, 0.1, 0.1 + 0.2, 
+		100.0, 1e16, 1e17, 123456789012345678.0, 1e-4, 1e-5, 0.00012345, 
+		5e-324, 1.7976931348623157e308, 1.0 / 3.0, 
+		std::numeric_limits<double>::infinity()})) ^
+	data::make(std::vector<std::string>({"0", "-0", "1", "-2.5", "0.1", 
+		"0.30000000000000004", "100", "10000000000000000", "1e+17", 
+		"1.2345678901234568e+17", "0.0001", "1e-05", "0.00012345", "5e-324", 
+		"1.7976931348623157e+308", "0.3333333333333333", "inf"})),
+	value, reference)
+{
+	BOOST_CHECK_EQUAL(formatReal(RealFormatter(), value), reference);
+}
+
+/** @brief Test that the default representation reads back exactly */
+BOOST_AUTO_TEST_CASE(testShortestRealRoundTrip)
+{
+	RealFormatter formatter;
+	std::mt19937_64 generator(42);
+	std::uniform_real_distribution<double> small(-1000.0, 1000.0);
+
+	for (int i = 0; i < 100000; i++)
+	{
+		double value;
+		if (i % 2 == 0)
+		{
+			value = small(generator);
+		} else {
+			// Cover the whole range including subnormal values
+			uint64_t bits = generator();
+			memcpy(&value, &bits, sizeof(value));
+			if (std::isnan(value) || std::isinf(value)) continue;
+		}
+
+		std::string formatted = formatReal(formatter, value);
+		BOOST_REQUIRE_MESSAGE(strtod(formatted.c_str(), NULL) == value, 
+			"Formatted value " << formatted << " does not read back");
+	}
+}
+
+/** @brief Test a fixed number of significant digits */
+BOOST_DATA_TEST_CASE(testPreciseReal, 
+	data::make(std::vector<int>({1, 3, 3, 3, 6, 17})) ^
+	data::make(std::vector<double>({0.25, 1.0 / 3.0, 12345.0, -0.000123456,
+		100.0, 0.1})) ^
+	data::make(std::vector<std::string>({"0.2", "0.333", "1.23e+04", 
+		"-0.000123", "100", "0.10000000000000001"})),
+	precision, value, reference)
+{
+	BOOST_CHECK_EQUAL(formatReal(RealFormatter(precision), value), reference);
+}
+
+/** @brief Test that the time and real values are written exactly */
+BOOST_AUTO_TEST_CASE(testExactRealValues)
+{
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	std::ostringstream stream;
+
+	{
+		CSVDataLogger logger(stream, appContext);
+		StaticEvent ev = makeEventVarOnly(1, fmiTypeReal, (fmiReal) (0.1 + 0.2),
+			1.0 / 3.0);
+		logger.eventTriggered(&ev);
+	}
+
+	BOOST_CHECK_EQUAL(stream.str(), makeCompleteCSVHeader() + 
+		"0.3333333333333333;0.30000000000000004;;;;;;;\n");
+}
+
+/** @brief Test the configured precision of the time and real values */
+BOOST_AUTO_TEST_CASE(testConfiguredPrecision)
+{
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	appContext.addCommandlineProperties(std::vector<std::string>({
+		"app.dataFile.precision=4"}));
+	std::ostringstream stream;
+
+	{
+		CSVDataLogger logger(stream, appContext);
+		StaticEvent ev = makeEventVarOnly(0, fmiTypeReal, (fmiReal) (2.0 / 3.0),
+			1.0 / 3.0);
+		logger.eventTriggered(&ev);
+	}
+
+	BOOST_CHECK_EQUAL(stream.str(), makeCompleteCSVHeader() + 
+		"0.3333;;;;;0.6667;;;\n");
+}
+
+/** @brief Test invalid precision configurations */
+BOOST_DATA_TEST_CASE(testInvalidPrecision, 
+	data::make(std::vector<std::string>({"app.dataFile.precision=18", 
+		"app.dataFile.precision=-1", "app.dataFile.precision=exact"})), 
+	property)
+{
+	ApplicationContext appContext = *(makeCompleteAppContext());
+	appContext.addCommandlineProperties(std::vector<std::string>({property}));
+	std::ostringstream stream;
+
+	BOOST_CHECK_THROW(CSVDataLogger logger(stream, appContext), 
+		Base::SystemConfigurationException);
+}
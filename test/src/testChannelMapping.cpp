@@ -345,3 +345,37 @@ BOOST_FIXTURE_TEST_CASE(testTransmissionChannel, InitializedChannelMappingFixtur
 	BOOST_CHECK_EQUAL(channel1.getChannelConfig().get<std::string>("lunch"), "At Noon");
 }
 
+
+/** @brief Tests the constant time port index lookup of a channel */
+BOOST_FIXTURE_TEST_CASE(testTransmissionChannelPortIndex, 
+	BasicChannelMappingFixture)
+{
+	configRoot_.put("0", "");
+	TransmissionChannel channel(configRoot_);
+
+	channel.pushBackPort(PortID(fmiTypeReal, 3), configRoot_.get_child("0"));
+	channel.pushBackPort(PortID(fmiTypeInteger, 0), configRoot_.get_child("0"));
+	channel.pushBackPort(PortID(fmiTypeReal, 3), configRoot_.get_child("0"));
+	channel.pushBackPort(PortID(fmiTypeString, 1), configRoot_.get_child("0"));
+
+	BOOST_CHECK_EQUAL(channel.getPortIndex(PortID(fmiTypeInteger, 0)), 1);
+	BOOST_CHECK_EQUAL(channel.getNextPortIndex(1), -1);
+	BOOST_CHECK_EQUAL(channel.getPortIndex(PortID(fmiTypeString, 1)), 3);
+
+	// A variable which is assigned to several ports
+	BOOST_CHECK_EQUAL(channel.getPortIndex(PortID(fmiTypeReal, 3)), 0);
+	BOOST_CHECK_EQUAL(channel.getNextPortIndex(0), 2);
+	BOOST_CHECK_EQUAL(channel.getNextPortIndex(2), -1);
+
+	// Unknown PortIDs
+	BOOST_CHECK_EQUAL(channel.getPortIndex(PortID(fmiTypeReal, 0)), -1);
+	BOOST_CHECK_EQUAL(channel.getPortIndex(PortID(fmiTypeReal, 4)), -1);
+	BOOST_CHECK_EQUAL(channel.getPortIndex(PortID(fmiTypeInteger, 1000)), -1);
+	BOOST_CHECK_EQUAL(channel.getPortIndex(PortID(fmiTypeBoolean, 0)), -1);
+	BOOST_CHECK_EQUAL(channel.getPortIndex(PortID(fmiTypeUnknown, 0)), -1);
+
+	// The lookup table remains valid in copies
+	TransmissionChannel copy(channel);
+	BOOST_CHECK_EQUAL(copy.getPortIndex(PortID(fmiTypeReal, 3)), 0);
+	BOOST_CHECK_EQUAL(copy.getNextPortIndex(0), 2);
+}
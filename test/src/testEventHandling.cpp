@@ -16,12 +16,16 @@
 #include <boost/test/unit_test.hpp>
 
 #include "base/ApplicationContext.h"
+#include "base/BaseExceptions.h"
 #include "model/AbstractEventPredictor.h"
 #include "timing/EventDispatcher.h"
+#include "timing/TimedEventQueue.h"
 #include "timing/StaticEvent.h"
 #include "timing/EventListener.h"
 
 #include <boost/log/trivial.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
 
 #include <stack>
 #include <memory>
@@ -29,10 +33,35 @@
 #include <mutex>
 #include <list>
 #include <thread>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <math.h>
+#include <stdlib.h>
 
 using namespace FMITerminalBlock;
 using namespace FMITerminalBlock::Timing;
 
+/** @brief Enables counting heap allocations of the current thread */
+static thread_local bool countAllocations = false;
+/** @brief The number of heap allocations while counting was enabled */
+static std::atomic<size_t> allocationCount(0);
+
+/** @brief Global allocation function which counts the allocations */
+void * operator new(std::size_t size)
+{
+	if (countAllocations) allocationCount++;
+	void * ptr = malloc(size == 0 ? 1 : size);
+	if (ptr == NULL) throw std::bad_alloc();
+	return ptr;
+}
+
+/** @brief Global deallocation function which matches the allocation one */
+void operator delete(void * ptr) noexcept
+{
+	free(ptr);
+}
+
 /**
  * @brief Dummy event predictor issuing events in fixed intervals
  */
@@ -770,3 +799,438 @@ BOOST_FIXTURE_TEST_CASE(test_early_time_query_2, EventDispatcherFixture)
 	BOOST_CHECK(expectedTime.empty());
 	extThread.join();
 }
+
+/**
+ * @brief Inserts a large number of outdated external events and checks the
+ * order in which they are returned.
+ * @details The test case also serves as a simple micro-benchmark of the
+ * queue's bulk insertion. Since all events are outdated, get() never blocks.
+ * The measured durations are reported as test messages.
+ */
+BOOST_AUTO_TEST_CASE(test_queue_bulk_insertion)
+{
+	const int eventCount = 10000;
+	const int blockSize = 100;
+
+	// Trace messages would dominate the measured time
+	boost::log::core::get()->set_filter(
+		boost::log::trivial::severity >= boost::log::trivial::info);
+
+	TimedEventQueue queue;
+	queue.initStartTimeNow(2.0 * eventCount);
+
+	// Insert blocks of events in reverse order
+	auto startTime = std::chrono::steady_clock::now();
+	for (int block = eventCount / blockSize - 1; block >= 0; block--)
+	{
+		for (int i = 0; i < blockSize; i++)
+		{
+			fmiTime time = (fmiTime) (block * blockSize + i);
+			queue.pushExternalEvent(new StaticEvent(time, std::vector<Variable>()));
+		}
+	}
+	auto insertedTime = std::chrono::steady_clock::now();
+
+	for (int i = 0; i < eventCount; i++)
+	{
+		Event * ev = queue.get();
+		BOOST_REQUIRE(ev != NULL);
+		BOOST_CHECK_CLOSE(ev->getTime(), (fmiTime) i, 1e-9);
+		delete ev;
+	}
+	auto finishedTime = std::chrono::steady_clock::now();
+
+	BOOST_TEST_MESSAGE("Inserted " << eventCount << " events in "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(
+			insertedTime - startTime).count() << "us, fetched them in "
+		<< std::chrono::duration_cast<std::chrono::microseconds>(
+			finishedTime - insertedTime).count() << "us");
+
+	boost::log::core::get()->reset_filter();
+}
+
+/**
+ * @brief Checks that simultaneous external events are issued in the order of
+ * their registration.
+ */
+BOOST_AUTO_TEST_CASE(test_queue_simultaneous_order)
+{
+	TimedEventQueue queue;
+	queue.initStartTimeNow(10.0);
+
+	std::vector<Event*> events;
+	events.push_back(new StaticEvent(2.0, std::vector<Variable>()));
+	events.push_back(new StaticEvent(1.0, std::vector<Variable>()));
+	events.push_back(new StaticEvent(2.0, std::vector<Variable>()));
+	events.push_back(new StaticEvent(1.0, std::vector<Variable>()));
+	events.push_back(new StaticEvent(2.0, std::vector<Variable>()));
+
+	for (auto it = events.begin(); it != events.end(); ++it)
+	{
+		queue.pushExternalEvent(*it);
+	}
+
+	BOOST_CHECK_EQUAL(queue.get(), events[1]);
+	BOOST_CHECK_EQUAL(queue.get(), events[3]);
+	BOOST_CHECK_EQUAL(queue.get(), events[0]);
+	BOOST_CHECK_EQUAL(queue.get(), events[2]);
+	BOOST_CHECK_EQUAL(queue.get(), events[4]);
+
+	for (auto it = events.begin(); it != events.end(); ++it)
+	{
+		delete *it;
+	}
+}
+
+/**
+ * @brief Pushes external events from several threads concurrently and checks
+ * that each event is returned exactly once and in order.
+ */
+BOOST_AUTO_TEST_CASE(test_queue_concurrent_producers)
+{
+	const int producerCount = 4;
+	const int eventCount = 1000;
+
+	boost::log::core::get()->set_filter(
+		boost::log::trivial::severity >= boost::log::trivial::info);
+
+	TimedEventQueue queue;
+	queue.initStartTimeNow(2.0 * eventCount);
+
+	std::vector<std::thread> producers;
+	for (int p = 0; p < producerCount; p++)
+	{
+		producers.push_back(std::thread([&queue, p, eventCount]() {
+			for (int i = 0; i < eventCount; i++)
+			{
+				queue.pushExternalEvent(new StaticEvent((fmiTime) i + 0.1 * p, 
+					std::vector<Variable>()));
+			}
+		}));
+	}
+
+	// Events may still arrive concurrently, the order is checked per producer
+	std::vector<fmiTime> lastTime(producerCount, -1.0);
+	for (int i = 0; i < producerCount * eventCount; i++)
+	{
+		Event * ev = queue.get();
+		BOOST_REQUIRE(ev != NULL);
+		int p = (int) floor((ev->getTime() - floor(ev->getTime())) * 10.0 + 0.5);
+		BOOST_REQUIRE(p >= 0 && p < producerCount);
+		BOOST_CHECK_LT(lastTime[p], ev->getTime());
+		lastTime[p] = ev->getTime();
+		delete ev;
+	}
+
+	for (auto it = producers.begin(); it != producers.end(); ++it)
+	{
+		it->join();
+	}
+
+	boost::log::core::get()->reset_filter();
+}
+
+/**
+ * @brief Releases some predicted events using each wait strategy and checks
+ * the release time
+ */
+BOOST_AUTO_TEST_CASE(test_queue_wait_strategies)
+{
+	const char * strategies[] = { "condvar", "hybrid-spin", "clock_nanosleep" };
+
+	for (int i = 0; i < 3; i++)
+	{
+		BOOST_TEST_CHECKPOINT("Test wait strategy " << strategies[i]);
+		std::string strategyProp = std::string("app.waitStrategy=") + 
+			strategies[i];
+		const char * argv[] = { "testEventHandling", strategyProp.c_str(),
+			"app.waitSpinTime=0.001", NULL };
+		Base::ApplicationContext context;
+		context.addCommandlineProperties(3, argv);
+
+		TimedEventQueue queue(context);
+		queue.initStartTimeNow(0.0);
+
+		for (int j = 1; j <= 3; j++)
+		{
+			fmiTime time = 0.05 * j;
+			queue.add(new StaticEvent(time, std::vector<Variable>()), true);
+			Event * ev = queue.get();
+			fmiTime now = queue.getTimeStampNow();
+
+			BOOST_REQUIRE(ev != NULL);
+			BOOST_CHECK_CLOSE(ev->getTime(), time, 1e-9);
+			BOOST_CHECK_GE(now, time);
+			// Only catch gross oversleeping. Loaded hosts may delay the release.
+			BOOST_CHECK_LE(now, time + 1.0);
+			delete ev;
+		}
+	}
+}
+
+/** @brief Checks that an invalid wait strategy is rejected */
+BOOST_AUTO_TEST_CASE(test_queue_invalid_wait_strategy)
+{
+	const char * argv[] = { "testEventHandling", "app.waitStrategy=yield", 
+		NULL };
+	Base::ApplicationContext context;
+	context.addCommandlineProperties(2, argv);
+
+	BOOST_CHECK_THROW(TimedEventQueue queue(context), 
+		Base::SystemConfigurationException);
+}
+
+/** @brief Checks the typed storage of variables */
+BOOST_AUTO_TEST_CASE(test_variable_typed_values)
+{
+	Variable real(Base::PortID(fmiTypeReal, 1), (fmiReal) 1.5);
+	Variable integer(Base::PortID(fmiTypeInteger, 2), (fmiInteger) -3);
+	Variable boolean(Base::PortID(fmiTypeBoolean, 3), (fmiBoolean) fmiTrue);
+	Variable string(Base::PortID(fmiTypeString, 4), std::string("val"));
+
+	BOOST_REQUIRE(real.isValid());
+	BOOST_REQUIRE(integer.isValid());
+	BOOST_REQUIRE(boolean.isValid());
+	BOOST_REQUIRE(string.isValid());
+	BOOST_CHECK_EQUAL(real.getRealValue(), 1.5);
+	BOOST_CHECK_EQUAL(integer.getIntegerValue(), -3);
+	BOOST_CHECK_EQUAL(boolean.getBooleanValue(), fmiTrue);
+	BOOST_CHECK_EQUAL(string.getStringValue(), "val");
+	BOOST_CHECK_EQUAL(real.getTypedValue<fmiReal>(), 1.5);
+	BOOST_CHECK_EQUAL(string.getTypedValue<std::string>(), "val");
+
+	// Legacy interface
+	BOOST_CHECK_EQUAL(boost::any_cast<fmiInteger>(integer.getValue()), -3);
+	Variable anyReal(Base::PortID(fmiTypeReal, 1), boost::any((fmiReal) 1.5));
+	BOOST_CHECK_EQUAL(anyReal, real);
+	BOOST_CHECK(anyReal.equalValue(real));
+
+	// Mismatching types
+	Variable mismatch(Base::PortID(fmiTypeReal, 1), (fmiInteger) 1);
+	BOOST_CHECK(!mismatch.isValid());
+	mismatch.setValue(boost::any(1.0f));
+	BOOST_CHECK(!mismatch.isValid());
+	mismatch.setValue((fmiReal) 2.0);
+	BOOST_CHECK(mismatch.isValid());
+	BOOST_CHECK(!Variable(Base::PortID(fmiTypeString, 4)).isValid());
+
+	// Copies share the string but not the variable
+	Variable stringCopy(string);
+	stringCopy.setValue(std::string("other"));
+	BOOST_CHECK_EQUAL(string.getStringValue(), "val");
+	BOOST_CHECK_EQUAL(stringCopy.getStringValue(), "other");
+}
+
+/** @brief Predicts events which carry real, integer and boolean variables */
+class TypedTestEventPredictor: public SimpleTestEventPredictor
+{
+public:
+
+	/** @brief C'tor initializing the object */
+	TypedTestEventPredictor(fmiTime eventDistance):
+		SimpleTestEventPredictor(eventDistance), 
+		eventDistance_(eventDistance), currentTime_(0.0), vars_()
+	{
+		for (int i = 0; i < 32; i++)
+		{
+			vars_.push_back(Variable(Base::PortID(fmiTypeReal, i), (fmiReal) i));
+			vars_.push_back(Variable(Base::PortID(fmiTypeInteger, i), i));
+			vars_.push_back(Variable(Base::PortID(fmiTypeBoolean, i), 
+				(fmiBoolean) (i % 2)));
+		}
+	}
+
+	/** @brief Returns the next event */
+	virtual Timing::Event * predictNext(void)
+	{
+		return new Timing::StaticEvent(currentTime_ + eventDistance_, vars_);
+	}
+
+	/** @brief Increases the object's time */
+	virtual void eventTriggered(Event * ev)
+	{
+		BOOST_REQUIRE(ev != NULL);
+		currentTime_ = ev->getTime();
+	}
+
+private:
+	/** @brief The distance between two consecutive events */
+	fmiTime eventDistance_;
+	/** @brief The current time instant */
+	fmiTime currentTime_;
+	/** @brief The variables of each predicted event */
+	std::vector<Variable> vars_;
+};
+
+/**
+ * @brief Enables or disables counting allocations during event distribution
+ * @details The first probe enables counting and the last one disables it. The
+ * number of allocations of each event is recorded.
+ */
+class AllocationProbe: public EventListener
+{
+public:
+	/** @brief The number of allocations of each distributed event */
+	std::vector<size_t> allocations;
+
+	/** @brief Creates a starting or a terminating probe */
+	AllocationProbe(bool start): start_(start), allocations() 
+	{
+		allocations.reserve(1000);
+	}
+
+	/** @brief Starts or stops counting */
+	virtual void eventTriggered(Event * ev)
+	{
+		if (start_)
+		{
+			allocationCount = 0;
+			countAllocations = true;
+		} else {
+			countAllocations = false;
+			allocations.push_back(allocationCount);
+		}
+	}
+
+private:
+	/** @brief Flag indicating whether the probe starts counting */
+	bool start_;
+};
+
+/** @brief Reads each variable and updates an output image */
+class VariableReadingListener: public EventListener
+{
+public:
+	/** @brief The sum of all real values */
+	fmiReal sum = 0.0;
+
+	/** @brief Initializes an empty image */
+	VariableReadingListener(): image_(96) {}
+
+	/** @brief Reads and copies the variables of the event */
+	virtual void eventTriggered(Event * ev)
+	{
+		const std::vector<Variable> &vars = ev->getVariables();
+		for (unsigned i = 0; i < vars.size() && i < image_.size(); i++)
+		{
+			image_[i] = vars[i];
+			switch (vars[i].getID().first)
+			{
+			case fmiTypeReal: sum += vars[i].getRealValue(); break;
+			case fmiTypeInteger: sum += vars[i].getIntegerValue(); break;
+			case fmiTypeBoolean: sum += vars[i].getBooleanValue(); break;
+			default: BOOST_CHECK(false);
+			}
+		}
+	}
+
+private:
+	/** @brief The image of all received variables */
+	std::vector<Variable> image_;
+};
+
+/**
+ * @brief Counts the heap allocations while distributing events which only 
+ * carry real, integer and boolean variables
+ * @details After the first event, no listener should need to allocate any 
+ * memory in order to access the variables.
+ */
+BOOST_AUTO_TEST_CASE(test_distribution_allocations)
+{
+	const char * argv[] = {"testEventHandling", "app.startTime=0", 
+		"app.stopTime=0.05", NULL};
+	Base::ApplicationContext context;
+	context.addCommandlineProperties(3, argv);
+
+	TypedTestEventPredictor pred(0.001);
+	AllocationProbe start(true), stop(false);
+	std::vector<VariableReadingListener> readers(4);
+
+	EventDispatcher dispatcher(context, pred);
+	dispatcher.addEventListener(start);
+	for (auto it = readers.begin(); it != readers.end(); ++it)
+	{
+		dispatcher.addEventListener(*it);
+	}
+	dispatcher.addEventListener(stop);
+	dispatcher.run();
+
+	BOOST_REQUIRE_GT(stop.allocations.size(), 10);
+	size_t steadyStateAllocations = 0;
+	for (unsigned i = 1; i < stop.allocations.size(); i++)
+	{
+		steadyStateAllocations += stop.allocations[i];
+	}
+	BOOST_TEST_MESSAGE("Distributed " << stop.allocations.size() << 
+		" events, " << stop.allocations[0] << " allocations on the first event, "
+		<< steadyStateAllocations << " allocations afterwards");
+	BOOST_CHECK_EQUAL(steadyStateAllocations, 0);
+	BOOST_CHECK_GT(readers[0].sum, 0.0);
+}
+
+/**
+ * @brief Checks that the memory of deleted events is reused, even if the 
+ * events are created and deleted by different threads.
+ */
+BOOST_AUTO_TEST_CASE(test_event_pool_recycling)
+{
+	// Warm up the pool
+	Event * ev = new StaticEvent(0.0, std::vector<Variable>());
+	delete ev;
+
+	countAllocations = true;
+	allocationCount = 0;
+	for (int i = 0; i < 1000; i++)
+	{
+		ev = new StaticEvent((fmiTime) i, std::vector<Variable>());
+		delete ev;
+	}
+	countAllocations = false;
+	BOOST_CHECK_EQUAL(allocationCount, 0);
+
+	// Create the event in a different thread and release it in this one
+	Event * remoteEvent = NULL;
+	std::thread producer([&remoteEvent]() {
+		remoteEvent = new StaticEvent(1.0, std::vector<Variable>());
+	});
+	producer.join();
+	BOOST_REQUIRE(remoteEvent != NULL);
+	void * remoteMemory = remoteEvent;
+	delete remoteEvent;
+
+	ev = new StaticEvent(2.0, std::vector<Variable>());
+	BOOST_CHECK_EQUAL((void *) ev, remoteMemory);
+	BOOST_CHECK_CLOSE(ev->getTime(), 2.0, 1e-9);
+	delete ev;
+}
+
+/** @brief Checks that copies of a static event share their variables */
+BOOST_AUTO_TEST_CASE(test_static_event_shared_variables)
+{
+	std::vector<Variable> vars;
+	for (int i = 0; i < 100; i++)
+	{
+		vars.push_back(Variable(Base::PortID(fmiTypeReal, i), (fmiReal) i));
+	}
+	StaticEvent prediction(1.0, std::move(vars));
+	BOOST_REQUIRE_EQUAL(prediction.getVariables().size(), 100);
+	delete new StaticEvent(prediction); // Warm up the event pool
+
+	countAllocations = true;
+	allocationCount = 0;
+	Event * copy = new StaticEvent(prediction);
+	countAllocations = false;
+
+	BOOST_CHECK_EQUAL(&copy->getVariables(), &prediction.getVariables());
+	BOOST_CHECK_CLOSE(copy->getTime(), 1.0, 1e-9);
+	BOOST_CHECK_EQUAL(copy->getVariables()[42].getRealValue(), 42.0);
+	delete copy;
+
+	// The shared variables must outlive the original event
+	StaticEvent * original = new StaticEvent(prediction);
+	StaticEvent survivor(*original);
+	delete original;
+	BOOST_CHECK_EQUAL(survivor.getVariables()[99].getRealValue(), 99.0);
+
+	BOOST_CHECK_EQUAL(allocationCount, 0);
+}
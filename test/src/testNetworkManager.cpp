@@ -336,4 +336,85 @@ BOOST_FIXTURE_TEST_CASE(testSubscriberRunException, BasicNetworkManagerFixture)
 
 	BOOST_CHECK_EQUAL(MockupPublisher::getInitSequenceID(), 0);
 	BOOST_CHECK_EQUAL(MockupPublisher::getEventTriggeredSequenceID(), -1);
-}
\ No newline at end of file
+}
+/** @brief Wraps the publisher of an asynchronous channel */
+BOOST_FIXTURE_TEST_CASE(testAsyncPublisher, BasicNetworkManagerFixture)
+{
+  // Set parameters
+  const char * argv[] = {"testNetworkManager", 
+		"out.0.protocol=MockupPublisher", "out.0.async=true",
+		"in.0.protocol=ConcurrentMockupSubscriber", NULL};
+  appContext_.addCommandlineProperties((sizeof(argv)/sizeof(argv[0]))-1, argv);
+
+	ConcurrentMockupSubscriber::resetCounter();
+	MockupPublisher::resetCounter();
+
+	{
+		NetworkManager nwManager(appContext_, *(dispatcher_.get()));
+		BOOST_CHECK(!nwManager.hasPendingException());
+	}
+
+	BOOST_CHECK_EQUAL(MockupPublisher::getInitSequenceID(), 0);
+	BOOST_CHECK_EQUAL(MockupPublisher::getEventTriggeredSequenceID(), -1);
+}
+
+/** @brief Applies an invalid asynchronous mode flag */
+BOOST_FIXTURE_TEST_CASE(testInvalidAsyncFlag, BasicNetworkManagerFixture)
+{
+  // Set parameters
+  const char * argv[] = {"testNetworkManager", 
+		"out.0.protocol=MockupPublisher", "out.0.async=maybe",
+		"in.0.protocol=ConcurrentMockupSubscriber", NULL};
+  appContext_.addCommandlineProperties((sizeof(argv)/sizeof(argv[0]))-1, argv);
+
+	BOOST_CHECK_THROW(NetworkManager(appContext_, *(dispatcher_.get())), 
+		SystemConfigurationException);
+}
+
+/** @brief Runs the network channels with a shared thread pool */
+BOOST_FIXTURE_TEST_CASE(testSharedNetworkThreads, BasicNetworkManagerFixture)
+{
+  // Set parameters
+  const char * argv[] = {"testNetworkManager", 
+		"out.0.protocol=MockupPublisher", "app.network.threads=auto",
+		"in.0.protocol=ConcurrentMockupSubscriber", NULL};
+  appContext_.addCommandlineProperties((sizeof(argv)/sizeof(argv[0]))-1, argv);
+
+	ConcurrentMockupSubscriber::resetCounter();
+	MockupPublisher::resetCounter();
+
+	{
+		// Channels which don't support the pool keep their own threads
+		NetworkManager nwManager(appContext_, *(dispatcher_.get()));
+		BOOST_CHECK(!nwManager.hasPendingException());
+		nwManager.terminateSubscribers();
+	}
+
+	BOOST_CHECK_EQUAL(MockupPublisher::getInitSequenceID(), 0);
+}
+
+/** @brief Applies an invalid number of shared network threads */
+BOOST_FIXTURE_TEST_CASE(testInvalidNetworkThreads, BasicNetworkManagerFixture)
+{
+  // Set parameters
+  const char * argv[] = {"testNetworkManager", 
+		"out.0.protocol=MockupPublisher", "app.network.threads=many",
+		"in.0.protocol=ConcurrentMockupSubscriber", NULL};
+  appContext_.addCommandlineProperties((sizeof(argv)/sizeof(argv[0]))-1, argv);
+
+	BOOST_CHECK_THROW(NetworkManager(appContext_, *(dispatcher_.get())), 
+		SystemConfigurationException);
+}
+
+/** @brief Applies a negative number of shared network threads */
+BOOST_FIXTURE_TEST_CASE(testNegativeNetworkThreads, BasicNetworkManagerFixture)
+{
+  // Set parameters
+  const char * argv[] = {"testNetworkManager", 
+		"out.0.protocol=MockupPublisher", "app.network.threads=-1",
+		"in.0.protocol=ConcurrentMockupSubscriber", NULL};
+  appContext_.addCommandlineProperties((sizeof(argv)/sizeof(argv[0]))-1, argv);
+
+	BOOST_CHECK_THROW(NetworkManager(appContext_, *(dispatcher_.get())), 
+		SystemConfigurationException);
+}
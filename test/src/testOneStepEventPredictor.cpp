@@ -235,6 +235,105 @@ BOOST_DATA_TEST_CASE(testEventDetection,
 	delete ev;
 }
 
+/** 
+ * @brief Test that only changed outputs are emitted if the corresponding flag
+ * is set
+ * @details The derivative of the zigzag model only changes on model events.
+ */
+BOOST_DATA_TEST_CASE(testEmitChangedOnly, 
+	data::make(ZIGZAG_FMU_NAMES)*data::make(createValidSolverParameterSet()), 
+	name, solverParams)
+{
+	Base::ApplicationContext appContext;
+	addModelBaseProperties(&appContext, name);
+
+	const char * argv[] = {"testOneStepEventPredictor", 
+		"app.startTime=0.0", "app.lookAheadTime=1.5", "app.variableStepSize=true",
+		"app.emitChangedOnly=true",
+		"out.0.0=x", "out.0.0.type=0", "out.0.1=der(x)", "out.0.1.type=0"};
+	appContext.addCommandlineProperties(sizeof(argv)/sizeof(argv[0]), argv);
+	appContext.addCommandlineProperties(solverParams);
+
+	OneStepEventPredictor pred(appContext);
+	pred.init();
+
+	// The first event contains all outputs
+	Timing::Event *ev = pred.predictNext();
+	BOOST_REQUIRE(ev);
+	BOOST_CHECK_SMALL(ev->getTime() - 1.0, 1e-3);
+	BOOST_REQUIRE_EQUAL(ev->getVariables().size(), 2);
+	pred.eventTriggered(ev);
+	delete ev;
+
+	// Only x changes
+	ev = pred.predictNext();
+	BOOST_REQUIRE(ev);
+	BOOST_CHECK_SMALL(ev->getTime() - 2.5, 1e-3);
+	auto vars = ev->getVariables();
+	BOOST_REQUIRE_EQUAL(vars.size(), 1);
+	BOOST_CHECK(vars[0].getID() == appContext.getOutputChannelMapping()
+		->getVariableIDs(fmiTypeReal)[0]);
+	BOOST_CHECK_CLOSE(vars[0].getRealValue(), -0.5, 1.0);
+	pred.eventTriggered(ev);
+	delete ev;
+
+	// Event triggered, both outputs change
+	ev = pred.predictNext();
+	BOOST_REQUIRE(ev);
+	BOOST_CHECK_SMALL(ev->getTime() - 3.0, 1e-3);
+	vars = ev->getVariables();
+	BOOST_REQUIRE_EQUAL(vars.size(), 2);
+	BOOST_CHECK_CLOSE(vars[0].getRealValue(), -1.0, 1.0);
+	BOOST_CHECK_CLOSE(vars[1].getRealValue(), 1.0, 1.0);
+	pred.eventTriggered(ev);
+	delete ev;
+}
+
+/** @brief Test suppressing output changes which stay within the deadband */
+BOOST_DATA_TEST_CASE(testOutputDeadband, 
+	data::make(ZIGZAG_FMU_NAMES)*data::make(createValidSolverParameterSet()), 
+	name, solverParams)
+{
+	Base::ApplicationContext appContext;
+	addModelBaseProperties(&appContext, name);
+
+	const char * argv[] = {"testOneStepEventPredictor", 
+		"app.startTime=0.0", "app.lookAheadTime=1.5", "app.variableStepSize=true",
+		"out.0.0=x", "out.0.0.type=0", "out.0.0.deadband.absolute=1.6",
+		"out.0.1=der(x)", "out.0.1.type=0"};
+	appContext.addCommandlineProperties(sizeof(argv)/sizeof(argv[0]), argv);
+	appContext.addCommandlineProperties(solverParams);
+
+	OneStepEventPredictor pred(appContext);
+	pred.init();
+
+	Timing::Event *ev = pred.predictNext();
+	BOOST_REQUIRE(ev);
+	BOOST_CHECK_SMALL(ev->getTime() - 1.0, 1e-3);
+	BOOST_REQUIRE_EQUAL(ev->getVariables().size(), 2);
+	pred.eventTriggered(ev);
+	delete ev;
+
+	// x only changes by 1.5 which is considered to be insignificant
+	ev = pred.predictNext();
+	BOOST_REQUIRE(ev);
+	BOOST_CHECK_SMALL(ev->getTime() - 2.5, 1e-3);
+	BOOST_CHECK_EQUAL(ev->getVariables().size(), 0);
+	pred.eventTriggered(ev);
+	delete ev;
+
+	// x leaves the deadband of the last significant value
+	ev = pred.predictNext();
+	BOOST_REQUIRE(ev);
+	BOOST_CHECK_SMALL(ev->getTime() - 3.0, 1e-3);
+	auto vars = ev->getVariables();
+	BOOST_REQUIRE_EQUAL(vars.size(), 2);
+	BOOST_CHECK_CLOSE(vars[0].getRealValue(), -1.0, 1.0);
+	BOOST_CHECK_CLOSE(vars[1].getRealValue(), 1.0, 1.0);
+	pred.eventTriggered(ev);
+	delete ev;
+}
+
 /** @brief Test setting external default values for inputs and parameters */
 BOOST_DATA_TEST_CASE(testDefaultInitialization, 
 	data::make(ZIGZAG_FMU_NAMES), name)
@@ -0,0 +1,266 @@
+/* ------------------------------------------------------------------- *
+ * Copyright (c) 2017, AIT Austrian Institute of Technology GmbH.      *
+ * All rights reserved. See file FMITerminalBlock_LICENSE for details. *
+ * ------------------------------------------------------------------- */
+
+/**
+ * @file testRingDataLogger.cpp
+ * @brief Tests the memory-mapped ring buffer data recorder
+ * @author Michael Spiegel, michael.spiegel@ait.ac.at
+ */
+
+#define BOOST_TEST_MODULE testRingDataLogger
+#include <boost/test/unit_test.hpp>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "timing/BinaryDataLogger.h"
+#include "timing/DataLoggerFactory.h"
+#include "timing/RingDataLogger.h"
+#include "timing/StaticEvent.h"
+#include "base/BaseExceptions.h"
+#include "base/ApplicationContext.h"
+
+using namespace FMITerminalBlock::Base;
+using namespace FMITerminalBlock::Timing;
+
+/** @brief The name of the ring file which is used by all tests */
+const std::string RING_FILE_NAME = "testRingDataLogger.ring";
+
+/** @brief Returns the native value at the given position */
+template<typename Type>
+Type get(const std::string &content, size_t pos)
+{
+	BOOST_REQUIRE_LE(pos + sizeof(Type), content.size());
+	Type ret;
+	memcpy(&ret, content.data() + pos, sizeof(ret));
+	return ret;
+}
+
+/** @brief Returns the whole content of the given file */
+std::string readFile(const std::string &fileName)
+{
+	std::ifstream in(fileName, std::ios_base::in | std::ios_base::binary);
+	return std::string((std::istreambuf_iterator<char>(in)),
+		std::istreambuf_iterator<char>());
+}
+
+/** @brief Returns a configuration of an integer and a string output */
+std::shared_ptr<ApplicationContext> makeAppContext(
+	const std::vector<std::string> &extra)
+{
+	std::shared_ptr<ApplicationContext> appContext;
+	appContext = std::make_shared<ApplicationContext>();
+	std::vector<std::string> args = {
+		"app.dataFile=" + RING_FILE_NAME,
+		"out.0.0=x", "out.0.0.type=1",
+		"out.0.1=s", "out.0.1.type=3"
+	};
+	args.insert(args.end(), extra.begin(), extra.end());
+	appContext->addCommandlineProperties(args);
+	return appContext;
+}
+
+/** @brief Logs the given number of events with ascending integer values */
+void logEvents(RingDataLogger &logger, int first, int count)
+{
+	for (int i = first; i < first + count; i++)
+	{
+		StaticEvent ev((fmiTime) i, {Variable(PortID(fmiTypeInteger, 0),
+			(fmiInteger) i)});
+		logger.eventTriggered(&ev);
+	}
+}
+
+/** @brief Returns the integer values of the dumped records */
+std::vector<int32_t> getDumpedValues(const RingDataLogger &logger)
+{
+	std::ostringstream stream;
+	logger.dump(stream);
+	const std::string content = stream.str();
+
+	BOOST_REQUIRE_EQUAL(content.substr(0, 8), "FMITBDAT");
+	const uint32_t recordSize = get<uint32_t>(content, 20);
+	const uint32_t dataOffset = get<uint32_t>(content, 24);
+	const uint32_t offset = get<uint32_t>(content, 32 + 8);
+	BOOST_REQUIRE_EQUAL((content.size() - dataOffset) % recordSize, 0);
+
+	std::vector<int32_t> ret;
+	for (size_t pos = dataOffset; pos < content.size(); pos += recordSize)
+	{
+		BOOST_CHECK_EQUAL(get<double>(content, pos),
+			(double) get<int32_t>(content, pos + offset));
+		ret.push_back(get<int32_t>(content, pos + offset));
+	}
+	return ret;
+}
+
+/** @brief Instantiates a logger with an empty configuration */
+BOOST_AUTO_TEST_CASE(testEmptyConfig)
+{
+	ApplicationContext appContext;
+	RingDataLogger logger(appContext);
+
+	StaticEvent ev(0.1, {});
+	logger.eventTriggered(&ev);
+	logger.dumpToFile();
+}
+
+/** @brief Test that the ring keeps the most recent events only */
+BOOST_AUTO_TEST_CASE(testWrapAround)
+{
+	// 96 bytes header, 32 bytes per slot (24 bytes record, 8 bytes string)
+	std::shared_ptr<ApplicationContext> appContext = makeAppContext({
+		"app.dataFile.ringSize=200", "app.dataFile.stringSize=8"});
+	{
+		RingDataLogger logger(*appContext);
+		std::vector<int32_t> ref;
+		BOOST_CHECK(getDumpedValues(logger) == ref);
+
+		logEvents(logger, 0, 2);
+		ref = {0, 1};
+		BOOST_CHECK(getDumpedValues(logger) == ref);
+
+		logEvents(logger, 2, 5);
+		ref = {4, 5, 6};
+		BOOST_CHECK(getDumpedValues(logger) == ref);
+	}
+
+	// The mapped file reflects the state of the ring
+	const std::string content = readFile(RING_FILE_NAME);
+	std::remove(RING_FILE_NAME.c_str());
+	BOOST_CHECK_EQUAL(content.substr(0, 8), "FMITBRNG");
+	BOOST_CHECK_EQUAL(get<uint32_t>(content, 24), 96);
+	BOOST_CHECK_EQUAL(get<uint64_t>(content, 32), 7);
+	BOOST_CHECK_EQUAL(get<uint32_t>(content, 40), 32);
+	BOOST_CHECK_EQUAL(get<uint32_t>(content, 44), 3);
+	BOOST_CHECK_EQUAL(get<uint32_t>(content, 48), 8);
+	BOOST_CHECK_EQUAL(content.size(), 96 + 3 * 32);
+}
+
+/** @brief Test that strings are truncated and appended to the dump */
+BOOST_AUTO_TEST_CASE(testStrings)
+{
+	std::shared_ptr<ApplicationContext> appContext = makeAppContext({
+		"app.dataFile.stringSize=4"});
+	std::ostringstream stream;
+	{
+		RingDataLogger logger(*appContext);
+		StaticEvent ev1(0.5, {Variable(PortID(fmiTypeString, 0),
+			std::string("abcdef"))});
+		logger.eventTriggered(&ev1);
+		StaticEvent ev2(1.0, {Variable(PortID(fmiTypeString, 0),
+			std::string("gh"))});
+		logger.eventTriggered(&ev2);
+		StaticEvent ev3(1.5, {});
+		logger.eventTriggered(&ev3);
+		logger.dump(stream);
+	}
+	std::remove(RING_FILE_NAME.c_str());
+
+	const std::string content = stream.str();
+	const uint32_t recordSize = get<uint32_t>(content, 20);
+	const uint32_t offset = get<uint32_t>(content, 32 + 16 + 1 + 8);
+	size_t pos = get<uint32_t>(content, 24);
+
+	BOOST_CHECK_EQUAL(get<uint32_t>(content, pos + offset), 4);
+	pos += recordSize;
+	BOOST_CHECK_EQUAL(content.substr(pos, 4), "abcd");
+	pos += 4;
+	BOOST_CHECK_EQUAL(get<uint32_t>(content, pos + offset), 2);
+	pos += recordSize;
+	BOOST_CHECK_EQUAL(content.substr(pos, 2), "gh");
+	pos += 2;
+	BOOST_CHECK_EQUAL(get<double>(content, pos), 1.5);
+	BOOST_CHECK_EQUAL(pos + recordSize, content.size());
+}
+
+/** @brief Test that the dump file is written on demand */
+BOOST_AUTO_TEST_CASE(testDumpFile)
+{
+	const std::string dumpFileName = "testRingDataLogger.bin";
+	std::shared_ptr<ApplicationContext> appContext = makeAppContext({
+		"app.dataFile.dumpFile=" + dumpFileName});
+	std::string ref;
+	{
+		RingDataLogger logger(*appContext);
+		logEvents(logger, 0, 10);
+		logger.dumpToFile();
+
+		std::ostringstream stream;
+		logger.dump(stream);
+		ref = stream.str();
+	}
+	std::remove(RING_FILE_NAME.c_str());
+
+	BOOST_CHECK_EQUAL(readFile(dumpFileName), ref);
+	std::remove(dumpFileName.c_str());
+}
+
+/** @brief Test that a requested dump is written by the next event */
+BOOST_AUTO_TEST_CASE(testRequestDump)
+{
+	const std::string dumpFileName = "testRingDataLogger.bin";
+	std::shared_ptr<ApplicationContext> appContext = makeAppContext({
+		"app.dataFile.dumpFile=" + dumpFileName});
+	std::remove(dumpFileName.c_str());
+	{
+		RingDataLogger logger(*appContext);
+		logEvents(logger, 0, 5);
+		BOOST_CHECK(readFile(dumpFileName).empty());
+
+		RingDataLogger::requestDump();
+		logEvents(logger, 5, 1);
+		BOOST_CHECK_EQUAL(readFile(dumpFileName).substr(0, 8), "FMITBDAT");
+
+		// The request is only served once
+		std::remove(dumpFileName.c_str());
+		logEvents(logger, 6, 1);
+		BOOST_CHECK(readFile(dumpFileName).empty());
+	}
+	std::remove(RING_FILE_NAME.c_str());
+	std::remove(dumpFileName.c_str());
+}
+
+/** @brief Test invalid ring configurations */
+BOOST_AUTO_TEST_CASE(testInvalidConfig)
+{
+	std::shared_ptr<ApplicationContext> appContext;
+	appContext = makeAppContext({"app.dataFile.ringSize=100"});
+	BOOST_CHECK_THROW(RingDataLogger logger(*appContext),
+		SystemConfigurationException);
+
+	appContext = makeAppContext({"app.dataFile.stringSize=0"});
+	BOOST_CHECK_THROW(RingDataLogger logger(*appContext),
+		SystemConfigurationException);
+
+	appContext = std::make_shared<ApplicationContext>();
+	appContext->addCommandlineProperties(std::vector<std::string>({
+		"app.dataFile=not-all-paths-lead-to-rome/rome.ring"}));
+	BOOST_CHECK_THROW(RingDataLogger logger(*appContext),
+		SystemConfigurationException);
+
+	std::remove(RING_FILE_NAME.c_str());
+}
+
+/** @brief Test that the factory creates the ring recorder */
+BOOST_AUTO_TEST_CASE(testFactory)
+{
+	std::shared_ptr<ApplicationContext> appContext = makeAppContext({
+		"app.dataFile.format=ring"});
+	{
+		std::shared_ptr<EventListener> logger;
+		logger = DataLoggerFactory::makeDataLogger(*appContext);
+		BOOST_CHECK(std::dynamic_pointer_cast<RingDataLogger>(logger));
+	}
+	std::remove(RING_FILE_NAME.c_str());
+}